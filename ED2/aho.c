@@ -0,0 +1,342 @@
+/**
+ * @file aho.c
+ * @brief Construção do autômato de Aho-Corasick e varredura do texto em uma passada
+ *
+ * Construção (aho_create):
+ * - Cada palavra-chave distinta (pela chave da Trie) é inserida como "#chave#" na
+ *   árvore de prefixos; o estado final guarda o identificador da palavra
+ * - Uma busca em largura calcula as ligações de falha e completa a função de
+ *   transição (go), de modo que a varredura faz uma leitura de vetor por símbolo
+ *
+ * Como todo padrão começa e termina com a fronteira e não a contém no meio, no fim
+ * de cada token no máximo um padrão termina (o do próprio token): não há saídas a
+ * propagar pelas ligações de falha.
+ *
+ * Varredura (aho_feed):
+ * - Delimitadores (tabela_delimitadores) fecham o token corrente com o símbolo 0
+ * - Os caracteres do token são normalizados (normalize_utf8_char); os que não são
+ *   letra nem hífen são ignorados, como na chave da Trie
+ */
+
+#include "aho.h"
+#include "trie.h"
+#include "hash.h"
+#include "normalize.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+
+//Código de um símbolo normalizado (1-27), ou -1 se o caractere é ignorado
+static int aho_symbol(char c) {
+    if (c == '-') return 27;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 1;
+    return -1;
+}
+
+//Transição a partir de um estado
+static int32_t* aho_go(const AhoAutomaton* ac, int32_t state, int symbol) {
+    return &ac->go[(size_t)state * AHO_NUM_SYMBOLS + symbol];
+}
+
+AhoAutomaton* aho_create(char keywords[][MAX_WORD_SIZE], int num_keywords) {
+    AhoAutomaton* ac = calloc(1, sizeof(AhoAutomaton));
+    HashTable* vistas = hash_create(num_keywords * 2);
+    char (*keys)[MAX_WORD_SIZE] = malloc((num_keywords > 0 ? num_keywords : 1) * MAX_WORD_SIZE);
+    if (ac) ac->keywords = malloc((num_keywords > 0 ? num_keywords : 1) * MAX_WORD_SIZE);
+    if (!ac || !keys || !ac->keywords) {
+        fprintf(stderr, "Erro de alocação de memória para autômato\n");
+        exit(EXIT_FAILURE);
+    }
+
+    //Palavras-chave distintas pela chave da Trie; conta os estados necessários
+    size_t max_states = 1;
+    for (int k = 0; k < num_keywords; k++) {
+        int n;
+        int len = trie_normalize_word(keywords[k], keys[ac->num_keywords], MAX_WORD_SIZE);
+        if (len == 0 || hash_search(vistas, keys[ac->num_keywords], &n)) continue;
+
+        hash_insert(vistas, keys[ac->num_keywords], ac->num_keywords);
+        memcpy(ac->keywords[ac->num_keywords], keywords[k], MAX_WORD_SIZE);
+        ac->num_keywords++;
+        max_states += (size_t)len + 2;
+    }
+    hash_destroy(vistas);
+
+    ac->go = malloc(max_states * AHO_NUM_SYMBOLS * sizeof(int32_t));
+    ac->fail = calloc(max_states, sizeof(int32_t));
+    ac->depth = calloc(max_states, sizeof(int32_t));
+    ac->output = malloc(max_states * sizeof(int32_t));
+    int32_t* queue = malloc(max_states * sizeof(int32_t));
+    int slots = ac->num_keywords > 0 ? ac->num_keywords : 1;
+    ac->occurrences = calloc(slots, sizeof(int*));
+    ac->num_occurrences = calloc(slots, sizeof(int));
+    ac->max_occurrences = calloc(slots, sizeof(int));
+    if (!ac->go || !ac->fail || !ac->depth || !ac->output || !queue ||
+        !ac->occurrences || !ac->num_occurrences || !ac->max_occurrences) {
+        fprintf(stderr, "Erro de alocação de memória para autômato\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(ac->go, 0xFF, max_states * AHO_NUM_SYMBOLS * sizeof(int32_t));  //-1 = sem transição
+    memset(ac->output, 0xFF, max_states * sizeof(int32_t));
+
+    //Árvore de prefixos com os padrões "#chave#"
+    ac->num_states = 1;
+    for (int id = 0; id < ac->num_keywords; id++) {
+        int32_t s = 0;
+        int len = (int)strlen(keys[id]);
+        for (int i = -1; i <= len; i++) {
+            int symbol = (i < 0 || i == len) ? 0 : aho_symbol(keys[id][i]);
+            int32_t* t = aho_go(ac, s, symbol);
+            if (*t < 0) {
+                *t = ac->num_states++;
+                ac->depth[*t] = ac->depth[s] + 1;
+            }
+            s = *t;
+        }
+        ac->output[s] = id;
+    }
+    free(keys);
+
+    //Busca em largura: ligações de falha e transições que faltam
+    int head = 0, tail = 0;
+    for (int c = 0; c < AHO_NUM_SYMBOLS; c++) {
+        int32_t* t = aho_go(ac, 0, c);
+        if (*t < 0) {
+            *t = 0;
+        } else {
+            ac->fail[*t] = 0;
+            queue[tail++] = *t;
+        }
+    }
+    while (head < tail) {
+        int32_t s = queue[head++];
+        for (int c = 0; c < AHO_NUM_SYMBOLS; c++) {
+            int32_t* t = aho_go(ac, s, c);
+            int32_t via_fail = *aho_go(ac, ac->fail[s], c);
+            if (*t < 0) {
+                *t = via_fail;
+            } else {
+                ac->fail[*t] = via_fail;
+                queue[tail++] = *t;
+            }
+        }
+    }
+    free(queue);
+
+    aho_reset(ac);
+    return ac;
+}
+
+void aho_reset(AhoAutomaton* ac) {
+    if (!ac) return;
+    for (int id = 0; id < ac->num_keywords; id++) ac->num_occurrences[id] = 0;
+    ac->state = *aho_go(ac, 0, 0);  //O texto começa em uma fronteira
+    ac->num_tokens = 0;
+    ac->in_word = 0;
+    ac->pending_len = 0;
+    ac->pending_need = 0;
+    ac->failed = 0;
+}
+
+//Registra uma ocorrência da palavra-chave id
+static void aho_add_occurrence(AhoAutomaton* ac, int id, int position) {
+    if (ac->num_occurrences[id] >= ac->max_occurrences[id]) {
+        int new_max = ac->max_occurrences[id] ? ac->max_occurrences[id] * 2 : 10;
+        int* novo = realloc(ac->occurrences[id], new_max * sizeof(int));
+        if (!novo) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            ac->failed = 1;
+            return;
+        }
+        ac->occurrences[id] = novo;
+        ac->max_occurrences[id] = new_max;
+    }
+    ac->occurrences[id][ac->num_occurrences[id]++] = position;
+}
+
+//Consome o caractere UTF-8 guardado em pending (completo ou truncado)
+static void aho_flush_pending(AhoAutomaton* ac) {
+    ac->pending[ac->pending_len] = '\0';
+    int symbol = aho_symbol(normalize_utf8_char(ac->pending));
+    if (symbol > 0) ac->state = *aho_go(ac, ac->state, symbol);
+    ac->pending_len = 0;
+}
+
+//Fecha o token corrente: símbolo de fronteira e verificação de saída
+static void aho_end_token(AhoAutomaton* ac) {
+    if (ac->pending_len) aho_flush_pending(ac);
+    ac->state = *aho_go(ac, ac->state, 0);
+    int id = ac->output[ac->state];
+    if (id >= 0) aho_add_occurrence(ac, id, ac->num_tokens);
+    ac->num_tokens++;
+    ac->in_word = 0;
+}
+
+//Tamanho de um caractere UTF-8 pelo primeiro byte (mesma regra de get_next_utf8_char)
+static int aho_utf8_length(unsigned char b) {
+    if ((b & 0xE0) == 0xC0) return 2;
+    if ((b & 0xF0) == 0xE0) return 3;
+    if ((b & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+void aho_feed(AhoAutomaton* ac, const char* data, size_t len) {
+    if (!ac || !data) return;
+    const unsigned char* delimitador = tabela_delimitadores();
+
+    for (size_t i = 0; i < len && !ac->failed; i++) {
+        unsigned char b = (unsigned char)data[i];
+        if (delimitador[b]) {
+            if (ac->in_word) aho_end_token(ac);
+            continue;
+        }
+        ac->in_word = 1;
+
+        //Continuação de um caractere multibyte (pode ter começado no bloco anterior)
+        if (ac->pending_len) {
+            ac->pending[ac->pending_len++] = (char)b;
+            if (ac->pending_len == ac->pending_need) aho_flush_pending(ac);
+            continue;
+        }
+
+        if (b < 0x80) {
+            int symbol = aho_symbol((char)tolower(b));
+            if (symbol > 0) ac->state = *aho_go(ac, ac->state, symbol);
+            continue;
+        }
+
+        int need = aho_utf8_length(b);
+        if (need == 1) continue;  //Byte isolado fora do alfabeto
+        ac->pending[0] = (char)b;
+        ac->pending_len = 1;
+        ac->pending_need = need;
+    }
+}
+
+void aho_finish(AhoAutomaton* ac) {
+    if (ac && ac->in_word && !ac->failed) aho_end_token(ac);
+}
+
+//Entrega um bloco do arquivo ao autômato (adaptador para percorrer_arquivo)
+static int aho_consumir(void* ctx, const char* dados, size_t tamanho) {
+    AhoAutomaton* ac = (AhoAutomaton*)ctx;
+    aho_feed(ac, dados, tamanho);
+    return !ac->failed;
+}
+
+int aho_scan_file(AhoAutomaton* ac, const char* filename) {
+    if (!ac || !filename) return 0;
+
+    aho_reset(ac);
+    int lido = percorrer_arquivo(filename, aho_consumir, ac);
+    if (lido < 0) return -1;
+    if (lido) aho_finish(ac);
+    return lido && !ac->failed;
+}
+
+const int* aho_search(const AhoAutomaton* ac, const char* word, int* num_occurrences) {
+    if (num_occurrences) *num_occurrences = 0;
+    if (!ac || !word || !num_occurrences) return NULL;
+
+    char key[MAX_WORD_SIZE];
+    int len = trie_normalize_word(word, key, MAX_WORD_SIZE);
+    if (len == 0) return NULL;
+
+    //Percorre "#chave#" a partir da raiz; só o padrão da própria chave termina ali
+    int32_t s = *aho_go(ac, 0, 0);
+    for (int i = 0; i < len; i++) s = *aho_go(ac, s, aho_symbol(key[i]));
+    s = *aho_go(ac, s, 0);
+
+    int id = ac->output[s];
+    if (id < 0 || ac->num_occurrences[id] == 0) return NULL;
+    *num_occurrences = ac->num_occurrences[id];
+    return ac->occurrences[id];
+}
+
+void aho_destroy(AhoAutomaton* ac) {
+    if (!ac) return;
+    for (int id = 0; id < ac->num_keywords; id++) free(ac->occurrences[id]);
+    free(ac->occurrences);
+    free(ac->num_occurrences);
+    free(ac->max_occurrences);
+    free(ac->keywords);
+    free(ac->go);
+    free(ac->fail);
+    free(ac->depth);
+    free(ac->output);
+    free(ac);
+}
+
+//Contexto da ordenação das palavras-chave para impressão
+static const AhoAutomaton* aho_sort_ctx;
+
+static int aho_compare_ids(const void* a, const void* b) {
+    return trie_compare_words(aho_sort_ctx->keywords[*(const int*)a],
+                              aho_sort_ctx->keywords[*(const int*)b]);
+}
+
+void imprimir_indice_aho(const AhoAutomaton* ac) {
+    if (ac == NULL) {
+        printf("Índice Aho-Corasick não foi criado.\n");
+        return;
+    }
+
+    printf("\n=== Índice Aho-Corasick ===\n");
+
+    int* ids = malloc((ac->num_keywords > 0 ? ac->num_keywords : 1) * sizeof(int));
+    if (!ids) {
+        printf("Erro ao alocar memória para ordenação.\n");
+        return;
+    }
+    int num_found = 0;
+    for (int id = 0; id < ac->num_keywords; id++) {
+        if (ac->num_occurrences[id] > 0) ids[num_found++] = id;
+    }
+
+    aho_sort_ctx = ac;
+    qsort(ids, num_found, sizeof(int), aho_compare_ids);
+
+    for (int i = 0; i < num_found; i++) {
+        int id = ids[i];
+        printf("%s: ", ac->keywords[id]);
+        for (int j = 0; j < ac->num_occurrences[id]; j++) {
+            printf("%d", ac->occurrences[id][j]);
+            if (j < ac->num_occurrences[id] - 1) printf(", ");
+        }
+        printf("\n");
+    }
+
+    for (int id = 0; id < ac->num_keywords; id++) {
+        if (ac->num_occurrences[id] == 0) {
+            printf("%s: Não foi encontrada no texto.\n", ac->keywords[id]);
+        }
+    }
+    free(ids);
+}
+
+//Imprime a subárvore de prefixos a partir de um estado
+static void aho_print_state(const AhoAutomaton* ac, int32_t s) {
+    for (int c = 0; c < AHO_NUM_SYMBOLS; c++) {
+        int32_t t = *aho_go(ac, s, c);
+        if (t == 0 || ac->depth[t] != ac->depth[s] + 1) continue;  //Só arestas da árvore
+
+        char symbol = c == 0 ? '#' : (c == 27 ? '-' : (char)('a' + c - 1));
+        printf("%*s%c [estado %d, falha %d]", 2 * ac->depth[s], "", symbol, t, ac->fail[t]);
+        if (ac->output[t] >= 0) printf(" -> %s", ac->keywords[ac->output[t]]);
+        printf("\n");
+        aho_print_state(ac, t);
+    }
+}
+
+void imprimir_aho_arvore(const AhoAutomaton* ac) {
+    if (ac == NULL) {
+        printf("Autômato Aho-Corasick não foi criado.\n");
+        return;
+    }
+
+    printf("\n=== Autômato Aho-Corasick (%d estados, %d palavras-chave) ===\n",
+           ac->num_states, ac->num_keywords);
+    printf("raiz [estado 0]\n");
+    aho_print_state(ac, 0);
+}
@@ -0,0 +1,126 @@
+/**
+* @file aho.h
+* @brief Autômato de Aho-Corasick para buscar todas as palavras-chave em uma passada
+*
+* As palavras-chave são compiladas em um autômato sobre o alfabeto normalizado da
+* Trie (26 letras + hífen, códigos 1 a 27) acrescido de um símbolo de fronteira de
+* palavra (código 0, escrito '#'). Cada palavra-chave vira o padrão "#chave#", e o
+* texto é lido como "#token#token#...#": um padrão só casa com um token inteiro.
+*
+* O texto é percorrido uma única vez, em blocos (aho_feed), sem montar arrays de
+* tokens: a cada fronteira o autômato conta o token e, se chegou ao fim de um padrão,
+* registra a posição na lista da palavra-chave. A memória depende apenas do
+* conjunto de palavras-chave e das ocorrências encontradas, não do tamanho do texto.
+*
+* As posições são os mesmos índices de token dos demais índices (mesmos
+* delimitadores de processar_texto), e as palavras são comparadas pela chave da
+* Trie, de modo que o resultado coincide com o do índice Trie.
+*
+* @struct AhoAutomaton
+* @brief Autômato compilado e estado da varredura
+* @var AhoAutomaton::go
+*    Função de transição completa: go[estado * AHO_NUM_SYMBOLS + símbolo]
+* @var AhoAutomaton::fail
+*    Ligação de falha de cada estado (maior sufixo próprio que também é prefixo)
+* @var AhoAutomaton::depth
+*    Comprimento do prefixo representado por cada estado
+* @var AhoAutomaton::output
+*    Palavra-chave que termina no estado, ou -1
+* @var AhoAutomaton::num_states
+*    Número de estados
+* @var AhoAutomaton::keywords
+*    Palavras-chave distintas pela chave da Trie (a primeira de cada chave)
+* @var AhoAutomaton::occurrences
+*    Posições encontradas de cada palavra-chave, em ordem crescente
+* @var AhoAutomaton::num_occurrences
+*    Número de posições de cada palavra-chave
+* @var AhoAutomaton::max_occurrences
+*    Capacidade da lista de cada palavra-chave
+* @var AhoAutomaton::num_keywords
+*    Número de palavras-chave compiladas
+* @var AhoAutomaton::state
+*    Estado corrente da varredura
+* @var AhoAutomaton::num_tokens
+*    Tokens já concluídos (posição do próximo token)
+* @var AhoAutomaton::in_word
+*    Indica se a varredura está dentro de um token
+* @var AhoAutomaton::pending
+*    Bytes de um caractere UTF-8 ainda incompleto (pode atravessar blocos)
+* @var AhoAutomaton::pending_len
+*    Bytes guardados em pending
+* @var AhoAutomaton::pending_need
+*    Tamanho total do caractere em pending
+* @var AhoAutomaton::failed
+*    Falha de alocação durante a varredura
+*
+* @fn AhoAutomaton* aho_create(char keywords[][MAX_WORD_SIZE], int num_keywords)
+* @brief Compila as palavras-chave em um autômato pronto para varrer um texto
+*
+* @fn void aho_reset(AhoAutomaton* ac)
+* @brief Descarta as ocorrências e prepara uma nova varredura
+*
+* @fn void aho_feed(AhoAutomaton* ac, const char* data, size_t len)
+* @brief Consome um bloco do texto (tokens e caracteres podem atravessar blocos)
+*
+* @fn void aho_finish(AhoAutomaton* ac)
+* @brief Conclui a varredura (fecha o último token)
+*
+* @fn int aho_scan_file(AhoAutomaton* ac, const char* filename)
+* @brief Varre um arquivo de qualquer tamanho (mmap ou leitura em blocos)
+* @return -1 se o arquivo não pôde ser aberto, 0 em falha e 1 se sucesso
+*
+* @fn const int* aho_search(const AhoAutomaton* ac, const char* word, int* num_occurrences)
+* @brief Busca uma palavra-chave e retorna suas posições (mesmo contrato de trie_search)
+*
+* @fn void aho_destroy(AhoAutomaton* ac)
+* @brief Libera o autômato e as ocorrências
+*
+* @fn void imprimir_indice_aho(const AhoAutomaton* ac)
+* @brief Imprime o índice remissivo em ordem alfabética
+*
+* @fn void imprimir_aho_arvore(const AhoAutomaton* ac)
+* @brief Imprime a árvore de prefixos do autômato com as ligações de falha
+*/
+
+#ifndef AHO_H
+#define AHO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "indice_remissivo.h"
+
+#define AHO_NUM_SYMBOLS 28  // 0 = fronteira, 1-26 = a-z, 27 = hífen
+
+//Autômato compilado e estado da varredura
+typedef struct {
+    int32_t* go;
+    int32_t* fail;
+    int32_t* depth;
+    int32_t* output;
+    int num_states;
+    char (*keywords)[MAX_WORD_SIZE];
+    int** occurrences;
+    int* num_occurrences;
+    int* max_occurrences;
+    int num_keywords;
+    int32_t state;
+    int num_tokens;
+    int in_word;
+    char pending[5];
+    int pending_len;
+    int pending_need;
+    int failed;
+} AhoAutomaton;
+
+//Protótipos das funções do autômato
+AhoAutomaton* aho_create(char keywords[][MAX_WORD_SIZE], int num_keywords);
+void aho_reset(AhoAutomaton* ac);
+void aho_feed(AhoAutomaton* ac, const char* data, size_t len);
+void aho_finish(AhoAutomaton* ac);
+int aho_scan_file(AhoAutomaton* ac, const char* filename);
+const int* aho_search(const AhoAutomaton* ac, const char* word, int* num_occurrences);
+void aho_destroy(AhoAutomaton* ac);
+void imprimir_indice_aho(const AhoAutomaton* ac);
+void imprimir_aho_arvore(const AhoAutomaton* ac);
+
+#endif /* AHO_H */
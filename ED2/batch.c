@@ -0,0 +1,246 @@
+/**
+ * @file batch.c
+ * @brief Modo em lote: leitura dos argumentos, criação e escrita dos índices
+ */
+
+#include "batch.h"
+#include "indice_remissivo.h"
+#include "hash.h"
+#include "trie.h"
+#include "docs.h"
+#include "output.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define BATCH_MAX_TEXTOS 256  //Limite de opções --text
+
+//Opções que recebem um valor no argumento seguinte
+static const char* const opcoes_com_valor[] = {
+    "--text", "--keywords", "--engine", "--out", "--output", "--threads"
+};
+
+//Opções da linha de comando
+typedef struct {
+    char* textos[BATCH_MAX_TEXTOS];
+    int num_textos;
+    const char* keywords;
+    const char* saida;
+    int tipo;
+    int por_documento;
+    OutputFormat formato;
+    int num_threads;
+    int compactar;
+} BatchOpcoes;
+
+static void batch_uso(FILE* f, const char* programa) {
+    fprintf(f, "Uso: %s --text ARQ [--text ARQ...] --keywords ARQ [--engine hash|trie|both]\n"
+               "       [--out texto|csv|json] [--output ARQ] [--threads N] [--compact]\n"
+               "Sem argumentos, o programa abre o menu interativo.\n"
+               "  --text ARQ      Arquivo ou diretório de texto (vários ou um diretório: indexados\n"
+               "                  como documentos, com as posições locais a cada documento)\n"
+               "  --keywords ARQ  Arquivo de palavras-chave (separadas por vírgulas ou linhas)\n"
+               "  --engine E      Estrutura: hash, trie ou both/ambas (padrão: both)\n"
+               "  --out F         Formato da saída: texto, csv ou json (padrão: texto)\n"
+               "  --output ARQ    Arquivo de saída (padrão: saída padrão)\n"
+               "  --threads N     Threads da criação dos índices, de 1 a %d (padrão: 1)\n"
+               "  --compact       Compacta as ocorrências (delta + varint) depois da criação\n",
+            programa, HASH_MAX_THREADS);
+}
+
+static int batch_estrutura(const char* nome) {
+    if (strcasecmp(nome, "hash") == 0) return ESTRUTURA_HASH;
+    if (strcasecmp(nome, "trie") == 0) return ESTRUTURA_TRIE;
+    if (strcasecmp(nome, "both") == 0 || strcasecmp(nome, "ambas") == 0) return ESTRUTURA_AMBAS;
+    return 0;
+}
+
+//Lê os argumentos; retorna 1 se válidos, 0 se inválidos e -1 para --help
+static int batch_opcoes(int argc, char* argv[], BatchOpcoes* op) {
+    memset(op, 0, sizeof(*op));
+    op->tipo = ESTRUTURA_AMBAS;
+    op->formato = OUTPUT_PLAIN;
+    op->num_threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char* opcao = argv[i];
+        if (strcmp(opcao, "-h") == 0 || strcmp(opcao, "--help") == 0) return -1;
+        if (strcmp(opcao, "--compact") == 0) {
+            op->compactar = 1;
+            continue;
+        }
+
+        int conhecida = 0;
+        for (size_t k = 0; k < sizeof(opcoes_com_valor) / sizeof(opcoes_com_valor[0]); k++) {
+            conhecida |= strcmp(opcao, opcoes_com_valor[k]) == 0;
+        }
+        if (!conhecida) {
+            fprintf(stderr, "Opção desconhecida: %s\n", opcao);
+            return 0;
+        }
+
+        const char* valor = i + 1 < argc ? argv[++i] : NULL;
+        if (!valor) {
+            fprintf(stderr, "Opção %s sem valor\n", opcao);
+            return 0;
+        }
+        if (strcmp(opcao, "--text") == 0) {
+            if (op->num_textos == BATCH_MAX_TEXTOS) {
+                fprintf(stderr, "Textos demais (até %d opções --text)\n", BATCH_MAX_TEXTOS);
+                return 0;
+            }
+            op->textos[op->num_textos++] = argv[i];  //O mesmo que valor, sem const
+        } else if (strcmp(opcao, "--keywords") == 0) {
+            op->keywords = valor;
+        } else if (strcmp(opcao, "--engine") == 0) {
+            if (!(op->tipo = batch_estrutura(valor))) {
+                fprintf(stderr, "Estrutura inválida: %s (use hash, trie ou both)\n", valor);
+                return 0;
+            }
+        } else if (strcmp(opcao, "--out") == 0) {
+            int formato = output_parse_format(valor);
+            if (formato < 0) {
+                fprintf(stderr, "Formato inválido: %s (use texto, csv ou json)\n", valor);
+                return 0;
+            }
+            op->formato = (OutputFormat)formato;
+        } else if (strcmp(opcao, "--output") == 0) {
+            op->saida = valor;
+        } else if (strcmp(opcao, "--threads") == 0) {
+            char* fim;
+            long n = strtol(valor, &fim, 10);
+            if (*valor == '\0' || *fim != '\0' || n < 1) {
+                fprintf(stderr, "Número de threads inválido: %s\n", valor);
+                return 0;
+            }
+            op->num_threads = n > HASH_MAX_THREADS ? HASH_MAX_THREADS : (int)n;
+        }
+    }
+
+    if (op->num_textos == 0 || !op->keywords) {
+        fprintf(stderr, "As opções --text e --keywords são obrigatórias\n");
+        return 0;
+    }
+
+    //Vários textos ou um diretório: a saída identifica o documento de cada posição
+    //(decidido pelos argumentos, para que o formato não dependa do conteúdo)
+    struct stat st;
+    op->por_documento = op->num_textos > 1 || (stat(op->textos[0], &st) == 0 && S_ISDIR(st.st_mode));
+    return 1;
+}
+
+//Cria a Hash sobre todas as partes: a primeira pela criação paralela, as demais por acréscimo
+static HashTable* batch_criar_hash(TokenCorpus** partes, int num_partes, char keywords[][MAX_WORD_SIZE],
+                                   int num_keywords, const BatchOpcoes* op) {
+    HashTable* ht = NULL;
+    int ok = criar_indice_hash_paralelo(&ht, partes[0]->palavras, partes[0]->posicoes, partes[0]->num_palavras,
+                                        keywords, num_keywords, op->num_threads);
+    for (int p = 1; p < num_partes && ok; p++) {
+        ok = hash_append_indice(ht, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                partes[p]->base, keywords, num_keywords, 0);
+    }
+    if (!ok) {
+        fprintf(stderr, "Falha ao criar o índice remissivo usando tabela hash\n");
+        if (ht) hash_destroy(ht);
+        return NULL;
+    }
+    if (get_compactar_ocorrencias()) hash_compact(ht);
+    return ht;
+}
+
+static TrieNode* batch_criar_trie(TokenCorpus** partes, int num_partes, char keywords[][MAX_WORD_SIZE],
+                                  int num_keywords, const BatchOpcoes* op) {
+    TrieNode* root = NULL;
+    int ok = criar_indice_trie_paralelo(&root, partes[0]->palavras, partes[0]->posicoes, partes[0]->num_palavras,
+                                        keywords, num_keywords, op->num_threads);
+    for (int p = 1; p < num_partes && ok; p++) {
+        ok = trie_append_indice(root, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                partes[p]->base, keywords, num_keywords, 0);
+    }
+    if (!ok) {
+        fprintf(stderr, "Falha ao criar o índice remissivo usando árvore de pesquisa digital\n");
+        if (root) trie_destroy(root);
+        return NULL;
+    }
+    if (get_compactar_ocorrencias()) trie_compact(root);
+    return root;
+}
+
+int batch_run(int argc, char* argv[]) {
+    BatchOpcoes op;
+    int validas = batch_opcoes(argc, argv, &op);
+    if (validas <= 0) {
+        batch_uso(validas < 0 ? stdout : stderr, argv[0]);
+        return validas < 0 ? EXIT_SUCCESS : BATCH_ERRO_USO;
+    }
+
+    //--compact liga a mesma opção de compactação do menu
+    set_compactar_ocorrencias(op.compactar);
+
+    //Palavras-chave no mesmo formato do menu
+    char (*keywords)[MAX_WORD_SIZE] = malloc(MAX_KEYWORDS * sizeof(*keywords));
+    if (!keywords) {
+        fprintf(stderr, "Erro de alocação de memória para as palavras-chave\n");
+        return EXIT_FAILURE;
+    }
+    int num_keywords = ler_keywords_arquivo(op.keywords, keywords, 0, NULL);
+    if (num_keywords <= 0) {
+        fprintf(stderr, num_keywords < 0 ? "Falha ao abrir o arquivo de palavras-chave: %s\n"
+                                         : "Nenhuma palavra-chave válida em %s\n", op.keywords);
+        free(keywords);
+        return EXIT_FAILURE;
+    }
+
+    //Os textos entram como documentos (um único arquivo é um documento com base 0)
+    DocumentSet* documentos = docs_create();
+    int num_docs = documentos ? docs_add_paths(documentos, op.textos, op.num_textos, op.num_threads) : 0;
+    TokenCorpus* ultima = docs_ultima(documentos);
+    if (num_docs == 0 || corpus_total_tokens(ultima) == 0) {
+        fprintf(stderr, num_docs == 0 ? "Nenhum texto foi carregado\n" : "Texto vazio ou sem conteúdo válido\n");
+        docs_destroy(documentos);
+        free(keywords);
+        return EXIT_FAILURE;
+    }
+
+    int num_partes = 0;
+    TokenCorpus** partes = corpus_parts(ultima, &num_partes);
+    if (!partes) {
+        fprintf(stderr, "Erro de alocação de memória para as partes do texto\n");
+        docs_destroy(documentos);
+        free(keywords);
+        return EXIT_FAILURE;
+    }
+
+    int fd = STDOUT_FILENO;
+    if (op.saida && strcmp(op.saida, "-") != 0) {
+        fd = open(op.saida, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) fprintf(stderr, "Erro ao criar o arquivo de saída: %s\n", op.saida);
+    }
+
+    int ok = fd >= 0;
+    OutputWriter out = {0};
+    if (ok) ok = output_open(&out, fd, op.formato);
+    if (ok && op.por_documento) output_set_documents(&out, documentos);
+
+    if (ok && (op.tipo & ESTRUTURA_HASH)) {
+        HashTable* ht = batch_criar_hash(partes, num_partes, keywords, num_keywords, &op);
+        ok = ht && hash_write_index(ht, keywords, num_keywords, &out);
+        if (ht) hash_destroy(ht);
+    }
+    if (ok && (op.tipo & ESTRUTURA_TRIE)) {
+        TrieNode* root = batch_criar_trie(partes, num_partes, keywords, num_keywords, &op);
+        ok = root && trie_write_index(root, keywords, num_keywords, &out);
+        if (root) trie_destroy(root);
+    }
+
+    if (fd >= 0 && out.buffer) ok = output_close(&out) && ok;
+    if (fd > STDOUT_FILENO && close(fd) != 0) {
+        fprintf(stderr, "Erro ao escrever o arquivo de saída: %s\n", op.saida);
+        ok = 0;
+    }
+
+    free(partes);
+    docs_destroy(documentos);
+    free(keywords);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
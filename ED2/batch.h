@@ -0,0 +1,37 @@
+/**
+ * @file batch.h
+ * @brief Modo em lote: cria e escreve os índices a partir da linha de comando,
+ *        sem o menu
+ *
+ * Uso: indice_remissivo --text ARQ [--text ARQ...] --keywords ARQ
+ *                       [--engine hash|trie|both] [--out texto|csv|json]
+ *                       [--output ARQ] [--threads N] [--compact]
+ *
+ * Cada --text acrescenta um arquivo ou diretório; os textos são indexados como
+ * documentos (docs.h), processados em paralelo. Com mais de um --text ou com um
+ * diretório, cada posição sai como o par (documento, posição local ao documento);
+ * com um único arquivo, a saída é a mesma da opção de impressão do menu.
+ *
+ * O arquivo de palavras-chave tem o mesmo formato do menu (ler_keywords_arquivo).
+ * Os índices são criados como na opção 3 do menu (criação paralela da primeira
+ * parte e acréscimo das demais) e escritos por uma única saída com buffer
+ * (output.h), a Hash antes da Trie.
+ *
+ * Mensagens de erro vão para a saída de erro, de modo que a saída padrão contém
+ * apenas o índice.
+ *
+ * @fn int batch_run(int argc, char* argv[])
+ * @brief Executa o modo em lote com os argumentos do programa
+ * @return Código de saída: 0 se sucesso, 1 em falha de execução (arquivos,
+ *         memória, escrita), 2 em argumentos inválidos
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#define BATCH_ERRO_USO 2  //Código de saída para argumentos inválidos
+
+//Protótipos do modo em lote
+int batch_run(int argc, char* argv[]);
+
+#endif /* BATCH_H */
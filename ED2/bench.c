@@ -0,0 +1,505 @@
+/**
+ * @file bench.c
+ * @brief Benchmark dos índices Hash e Trie sobre corpora sintéticos
+ *
+ * Gera textos com frequências de palavras seguindo a lei de Zipf e conjuntos de
+ * palavras-chave de vários tamanhos, e mede separadamente cada fase:
+ * - tokenize: processamento do texto em um TokenCorpus (comum às duas estruturas)
+ * - build: criar_indice_hash / criar_indice_trie
+ * - query: buscas das palavras-chave (hash_search / trie_search)
+ * - print: impressão do índice (saída descartada em /dev/null)
+ * - destroy: liberação da estrutura
+ *
+ * Para cada fase são registrados o tempo total e por operação (ns/op), o pico de
+ * memória residente da fase e o número de alocações. O pico é zerado antes de cada
+ * fase (/proc/self/clear_refs) quando o sistema permite; caso contrário, é o pico
+ * do processo. As alocações são contadas pelos wrappers de malloc/calloc/realloc/
+ * free/strdup/aligned_alloc quando o programa é ligado com -Wl,--wrap (make bench).
+ *
+ * De cada configuração são feitas várias repetições e fica o menor tempo. O
+ * resultado sai em CSV e/ou JSON, para comparar versões.
+ *
+ * Uso: bench_indice [--tokens N,N...] [--vocab N] [--keywords N,N...] [--zipf S]
+ *                   [--reps N] [--queries N] [--seed N] [--csv ARQ] [--json ARQ]
+ * (sem --csv nem --json, o CSV é escrito na saída padrão; "-" também indica a saída padrão)
+ */
+
+#include "indice_remissivo.h"
+#include "hash.h"
+#include "trie.h"
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#define BENCH_MAX_CONFIGS 16
+#define BENCH_MAX_RECORDS 4096
+
+// Contadores de alocação (alterados apenas pelos wrappers)
+static size_t contagem_alocacoes;
+static size_t contagem_liberacoes;
+static size_t bytes_alocados;
+
+#ifdef BENCH_WRAP_MALLOC
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t m, size_t n);
+void* __real_realloc(void* p, size_t n);
+void* __real_aligned_alloc(size_t a, size_t n);
+void __real_free(void* p);
+
+void* __wrap_malloc(size_t n) {
+    contagem_alocacoes++;
+    bytes_alocados += n;
+    return __real_malloc(n);
+}
+
+void* __wrap_calloc(size_t m, size_t n) {
+    contagem_alocacoes++;
+    bytes_alocados += m * n;
+    return __real_calloc(m, n);
+}
+
+void* __wrap_realloc(void* p, size_t n) {
+    contagem_alocacoes++;
+    bytes_alocados += n;
+    return __real_realloc(p, n);
+}
+
+void* __wrap_aligned_alloc(size_t a, size_t n) {
+    contagem_alocacoes++;
+    bytes_alocados += n;
+    return __real_aligned_alloc(a, n);
+}
+
+void __wrap_free(void* p) {
+    if (p) contagem_liberacoes++;
+    __real_free(p);
+}
+
+char* __wrap_strdup(const char* s) {
+    size_t n = strlen(s) + 1;
+    char* copia = __wrap_malloc(n);
+    if (copia) memcpy(copia, s, n);
+    return copia;
+}
+#endif
+
+// Resultado de uma fase
+typedef struct {
+    const char* engine;
+    int tokens;
+    int vocab;
+    int keywords;
+    const char* phase;
+    uint64_t ns;
+    uint64_t ops;
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+    long peak_kb;
+} BenchRecord;
+
+// Medição em andamento
+typedef struct {
+    uint64_t inicio;
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+} BenchMarca;
+
+static BenchRecord registros[BENCH_MAX_RECORDS];
+static int num_registros;
+
+//Gerador xorshift64* (determinístico a partir da semente)
+static uint64_t estado_aleatorio = 88172645463325252ull;
+
+static uint64_t aleatorio(void) {
+    estado_aleatorio ^= estado_aleatorio >> 12;
+    estado_aleatorio ^= estado_aleatorio << 25;
+    estado_aleatorio ^= estado_aleatorio >> 27;
+    return estado_aleatorio * 2685821657736338717ull;
+}
+
+static double aleatorio_unitario(void) {
+    return (double)(aleatorio() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint64_t agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+//Zera o pico de memória residente (VmHWM), se o kernel permitir
+static void zerar_pico(void) {
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    if (fd < 0) return;
+    if (write(fd, "5", 1) < 0) {
+        //Sem suporte: o pico lido será o do processo
+    }
+    close(fd);
+}
+
+//Pico de memória residente em KB (VmHWM, ou ru_maxrss do processo)
+static long ler_pico(void) {
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status) {
+        char linha[256];
+        long kb = -1;
+        while (fgets(linha, sizeof(linha), status)) {
+            if (sscanf(linha, "VmHWM: %ld kB", &kb) == 1) break;
+        }
+        fclose(status);
+        if (kb >= 0) return kb;
+    }
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+static void iniciar_fase(BenchMarca* marca) {
+    zerar_pico();
+    marca->allocs = contagem_alocacoes;
+    marca->frees = contagem_liberacoes;
+    marca->bytes = bytes_alocados;
+    marca->inicio = agora_ns();
+}
+
+//Conclui a fase; entre repetições, guarda o menor tempo
+static void concluir_fase(const BenchMarca* marca, const char* engine, int tokens, int vocab,
+                          int keywords, const char* phase, uint64_t ops, int repeticao) {
+    uint64_t ns = agora_ns() - marca->inicio;
+    long pico = ler_pico();
+
+    BenchRecord* r = NULL;
+    for (int i = 0; i < num_registros; i++) {
+        BenchRecord* x = &registros[i];
+        if (x->tokens == tokens && x->keywords == keywords && x->vocab == vocab &&
+            strcmp(x->engine, engine) == 0 && strcmp(x->phase, phase) == 0) {
+            r = x;
+            break;
+        }
+    }
+    if (!r) {
+        if (num_registros >= BENCH_MAX_RECORDS) return;
+        r = &registros[num_registros++];
+        r->engine = engine;
+        r->tokens = tokens;
+        r->vocab = vocab;
+        r->keywords = keywords;
+        r->phase = phase;
+        r->ns = UINT64_MAX;
+    }
+
+    if (ns < r->ns) r->ns = ns;
+    if (repeticao == 0 || pico > r->peak_kb) r->peak_kb = pico;
+    r->ops = ops;
+    r->allocs = contagem_alocacoes - marca->allocs;
+    r->frees = contagem_liberacoes - marca->frees;
+    r->bytes = bytes_alocados - marca->bytes;
+}
+
+//Palavra sintética do posto r: sílabas em base 16, com acento em parte delas
+//(as formas acentuadas exercitam a normalização das duas estruturas)
+static void palavra_do_posto(int r, char* out) {
+    static const char* silabas[16] = {
+        "ba", "ce", "di", "fo", "gu", "la", "me", "ni",
+        "po", "ru", "sa", "te", "vi", "xo", "zu", "ca"
+    };
+    char digitos[16];
+    int n = 0;
+    int valor = r + 16;  //Ao menos duas sílabas
+    while (valor > 0) {
+        digitos[n++] = (char)(valor % 16);
+        valor /= 16;
+    }
+
+    int len = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        const char* s = silabas[(int)digitos[i]];
+        out[len++] = s[0];
+        if (i == 0 && r % 7 == 3 && s[1] == 'a') {
+            out[len++] = (char)0xC3;  //"á"
+            out[len++] = (char)0xA1;
+        } else {
+            out[len++] = s[1];
+        }
+    }
+    out[len] = '\0';
+}
+
+//Texto com num_tokens palavras sorteadas pela distribuição de Zipf (expoente s)
+static char* gerar_texto(int num_tokens, int vocab, double s, size_t* tamanho) {
+    double* acumulada = malloc(vocab * sizeof(double));
+    size_t capacidade = (size_t)num_tokens * 16 + 16;
+    char* texto = malloc(capacidade);
+    if (!acumulada || !texto) {
+        fprintf(stderr, "Erro de alocação de memória para o corpus sintético\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double total = 0;
+    for (int r = 0; r < vocab; r++) {
+        total += 1.0 / pow(r + 1, s);
+        acumulada[r] = total;
+    }
+
+    size_t len = 0;
+    int inicio_frase = 1;
+    for (int t = 0; t < num_tokens; t++) {
+        //Busca binária do posto sorteado
+        double u = aleatorio_unitario() * total;
+        int lo = 0, hi = vocab - 1;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (acumulada[mid] < u) lo = mid + 1; else hi = mid;
+        }
+
+        char palavra[64];
+        palavra_do_posto(lo, palavra);
+        if (inicio_frase) palavra[0] = (char)toupper((unsigned char)palavra[0]);
+        size_t n = strlen(palavra);
+        memcpy(texto + len, palavra, n);
+        len += n;
+
+        //Pontuação ocasional entre as palavras
+        uint64_t p = aleatorio() % 20;
+        inicio_frase = p == 0;
+        if (p == 0) {
+            memcpy(texto + len, ".\n", 2);
+            len += 2;
+        } else if (p == 1) {
+            memcpy(texto + len, ", ", 2);
+            len += 2;
+        } else {
+            texto[len++] = ' ';
+        }
+    }
+    texto[len] = '\0';
+    free(acumulada);
+    *tamanho = len;
+    return texto;
+}
+
+//Palavras-chave: postos uniformes do vocabulário, com 10% de palavras ausentes
+static void gerar_keywords(char keywords[][MAX_WORD_SIZE], int num_keywords, int vocab) {
+    for (int i = 0; i < num_keywords; i++) {
+        if (i % 10 == 9) {
+            snprintf(keywords[i], MAX_WORD_SIZE, "ausente%c%c", 'a' + i % 26, 'a' + (i / 26) % 26);
+        } else {
+            palavra_do_posto((int)(aleatorio() % (uint64_t)vocab), keywords[i]);
+        }
+    }
+}
+
+//Executa a impressão com a saída padrão descartada
+static void imprimir_descartando(void (*imprimir)(void*), void* estrutura) {
+    fflush(stdout);
+    int salvo = dup(STDOUT_FILENO);
+    int nulo = open("/dev/null", O_WRONLY);
+    if (salvo < 0 || nulo < 0) {
+        if (salvo >= 0) close(salvo);
+        if (nulo >= 0) close(nulo);
+        return;
+    }
+    dup2(nulo, STDOUT_FILENO);
+    close(nulo);
+    imprimir(estrutura);
+    fflush(stdout);
+    dup2(salvo, STDOUT_FILENO);
+    close(salvo);
+}
+
+static void imprimir_hash(void* ht) { imprimir_indice_hash((HashTable*)ht); }
+static void imprimir_trie(void* root) { imprimir_indice_trie((TrieNode*)root); }
+
+static volatile int sumidouro;  //Impede que o compilador descarte as buscas
+
+//Mede as fases de uma estrutura para um corpus e um conjunto de palavras-chave
+static void medir_estrutura(const char* engine, TokenCorpus* corpus, int vocab,
+                            char keywords[][MAX_WORD_SIZE], int num_keywords,
+                            int num_buscas, int repeticao) {
+    int tokens = corpus->num_palavras;
+    int eh_hash = strcmp(engine, "hash") == 0;
+    BenchMarca marca;
+
+    //As funções de impressão leem as palavras-chave globais de cada índice
+    if (eh_hash) {
+        memcpy(get_keywords_hash(), keywords, (size_t)num_keywords * MAX_WORD_SIZE);
+        set_num_keywords_hash(num_keywords);
+    } else {
+        memcpy(get_keywords_trie(), keywords, (size_t)num_keywords * MAX_WORD_SIZE);
+        set_num_keywords_trie(num_keywords);
+    }
+
+    HashTable* ht = NULL;
+    TrieNode* root = NULL;
+    iniciar_fase(&marca);
+    int ok = eh_hash
+        ? criar_indice_hash(&ht, corpus->palavras, corpus->posicoes, tokens, keywords, num_keywords)
+        : criar_indice_trie(&root, corpus->palavras, corpus->posicoes, tokens, keywords, num_keywords);
+    concluir_fase(&marca, engine, tokens, vocab, num_keywords, "build", (uint64_t)tokens, repeticao);
+    if (!ok) {
+        fprintf(stderr, "Falha ao criar o índice %s\n", engine);
+        exit(EXIT_FAILURE);
+    }
+
+    iniciar_fase(&marca);
+    int soma = 0;
+    for (int i = 0; i < num_buscas; i++) {
+        int n;
+        const char* palavra = keywords[i % num_keywords];
+        if (eh_hash) hash_search(ht, palavra, &n); else trie_search(root, palavra, &n);
+        soma += n;
+    }
+    sumidouro = soma;
+    concluir_fase(&marca, engine, tokens, vocab, num_keywords, "query", (uint64_t)num_buscas, repeticao);
+
+    iniciar_fase(&marca);
+    if (eh_hash) imprimir_descartando(imprimir_hash, ht); else imprimir_descartando(imprimir_trie, root);
+    concluir_fase(&marca, engine, tokens, vocab, num_keywords, "print", (uint64_t)num_keywords, repeticao);
+
+    iniciar_fase(&marca);
+    if (eh_hash) hash_destroy(ht); else trie_destroy(root);
+    concluir_fase(&marca, engine, tokens, vocab, num_keywords, "destroy", 1, repeticao);
+}
+
+//Lê uma lista "N,N,..." de inteiros positivos
+static int ler_lista(const char* texto, int* valores, int max) {
+    int n = 0;
+    while (*texto && n < max) {
+        char* fim;
+        long v = strtol(texto, &fim, 10);
+        if (fim == texto || v <= 0 || v > 100000000) return 0;
+        valores[n++] = (int)v;
+        texto = *fim == ',' ? fim + 1 : fim;
+        if (*fim != ',' && *fim != '\0') return 0;
+    }
+    return n;
+}
+
+static FILE* abrir_saida(const char* nome) {
+    if (strcmp(nome, "-") == 0) return stdout;
+    FILE* f = fopen(nome, "w");
+    if (!f) fprintf(stderr, "Erro ao criar o arquivo: %s\n", nome);
+    return f;
+}
+
+static void escrever_csv(FILE* f) {
+    fprintf(f, "engine,tokens,vocab,keywords,phase,ns_total,ops,ns_per_op,allocs,frees,alloc_bytes,peak_rss_kb\n");
+    for (int i = 0; i < num_registros; i++) {
+        const BenchRecord* r = &registros[i];
+        fprintf(f, "%s,%d,%d,%d,%s,%llu,%llu,%.2f,%zu,%zu,%zu,%ld\n",
+                r->engine, r->tokens, r->vocab, r->keywords, r->phase,
+                (unsigned long long)r->ns, (unsigned long long)r->ops,
+                r->ops ? (double)r->ns / (double)r->ops : 0.0,
+                r->allocs, r->frees, r->bytes, r->peak_kb);
+    }
+}
+
+static void escrever_json(FILE* f) {
+    fprintf(f, "[\n");
+    for (int i = 0; i < num_registros; i++) {
+        const BenchRecord* r = &registros[i];
+        fprintf(f, "  {\"engine\": \"%s\", \"tokens\": %d, \"vocab\": %d, \"keywords\": %d, "
+                   "\"phase\": \"%s\", \"ns_total\": %llu, \"ops\": %llu, \"ns_per_op\": %.2f, "
+                   "\"allocs\": %zu, \"frees\": %zu, \"alloc_bytes\": %zu, \"peak_rss_kb\": %ld}%s\n",
+                r->engine, r->tokens, r->vocab, r->keywords, r->phase,
+                (unsigned long long)r->ns, (unsigned long long)r->ops,
+                r->ops ? (double)r->ns / (double)r->ops : 0.0,
+                r->allocs, r->frees, r->bytes, r->peak_kb, i + 1 < num_registros ? "," : "");
+    }
+    fprintf(f, "]\n");
+}
+
+int main(int argc, char* argv[]) {
+    int tamanhos[BENCH_MAX_CONFIGS] = {100000, 1000000};
+    int num_tamanhos = 2;
+    int conjuntos[BENCH_MAX_CONFIGS] = {10, 100, 1000};
+    int num_conjuntos = 3;
+    int vocab = 20000;
+    double zipf = 1.0;
+    int repeticoes = 3;
+    int num_buscas = 200000;
+    const char* arquivo_csv = NULL;
+    const char* arquivo_json = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* valor = i + 1 < argc ? argv[i + 1] : NULL;
+        int ok = valor != NULL;
+        if (ok && strcmp(argv[i], "--tokens") == 0) {
+            ok = (num_tamanhos = ler_lista(valor, tamanhos, BENCH_MAX_CONFIGS)) > 0;
+        } else if (ok && strcmp(argv[i], "--keywords") == 0) {
+            ok = (num_conjuntos = ler_lista(valor, conjuntos, BENCH_MAX_CONFIGS)) > 0;
+            for (int k = 0; ok && k < num_conjuntos; k++) ok = conjuntos[k] <= MAX_KEYWORDS;
+        } else if (ok && strcmp(argv[i], "--vocab") == 0) {
+            ok = (vocab = atoi(valor)) > 0;
+        } else if (ok && strcmp(argv[i], "--zipf") == 0) {
+            ok = (zipf = atof(valor)) > 0;
+        } else if (ok && strcmp(argv[i], "--reps") == 0) {
+            ok = (repeticoes = atoi(valor)) > 0;
+        } else if (ok && strcmp(argv[i], "--queries") == 0) {
+            ok = (num_buscas = atoi(valor)) > 0;
+        } else if (ok && strcmp(argv[i], "--seed") == 0) {
+            estado_aleatorio = strtoull(valor, NULL, 10) | 1u;
+        } else if (ok && strcmp(argv[i], "--csv") == 0) {
+            arquivo_csv = valor;
+        } else if (ok && strcmp(argv[i], "--json") == 0) {
+            arquivo_json = valor;
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            fprintf(stderr, "Uso: %s [--tokens N,N...] [--vocab N] [--keywords N,N...] [--zipf S]\n"
+                            "       [--reps N] [--queries N] [--seed N] [--csv ARQ] [--json ARQ]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+        i++;
+    }
+    if (!arquivo_csv && !arquivo_json) arquivo_csv = "-";
+
+    static char keywords[MAX_KEYWORDS][MAX_WORD_SIZE];
+    for (int t = 0; t < num_tamanhos; t++) {
+        size_t tamanho;
+        char* texto = gerar_texto(tamanhos[t], vocab, zipf, &tamanho);
+        fprintf(stderr, "corpus: %d tokens, vocabulário %d, %zu bytes\n", tamanhos[t], vocab, tamanho);
+
+        for (int rep = 0; rep < repeticoes; rep++) {
+            BenchMarca marca;
+            iniciar_fase(&marca);
+            TokenCorpus* corpus = corpus_create(texto, tamanho);
+            if (!corpus) {
+                fprintf(stderr, "Falha ao processar o corpus sintético\n");
+                return EXIT_FAILURE;
+            }
+            concluir_fase(&marca, "corpus", tamanhos[t], vocab, 0, "tokenize",
+                          (uint64_t)corpus->num_palavras, rep);
+
+            for (int k = 0; k < num_conjuntos; k++) {
+                gerar_keywords(keywords, conjuntos[k], vocab);
+                medir_estrutura("hash", corpus, vocab, keywords, conjuntos[k], num_buscas, rep);
+                medir_estrutura("trie", corpus, vocab, keywords, conjuntos[k], num_buscas, rep);
+            }
+            corpus_release(corpus);
+        }
+        free(texto);
+    }
+
+    if (arquivo_csv) {
+        FILE* f = abrir_saida(arquivo_csv);
+        if (!f) return EXIT_FAILURE;
+        escrever_csv(f);
+        if (f != stdout) fclose(f);
+    }
+    if (arquivo_json) {
+        FILE* f = abrir_saida(arquivo_json);
+        if (!f) return EXIT_FAILURE;
+        escrever_json(f);
+        if (f != stdout) fclose(f);
+    }
+    return EXIT_SUCCESS;
+}
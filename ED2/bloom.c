@@ -0,0 +1,91 @@
+/**
+ * @file bloom.c
+ * @brief Filtro de Bloom em blocos (um bloco de 64 bytes por chave)
+ */
+
+#include "bloom.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define BLOOM_BITS_POR_BLOCO (BLOOM_PALAVRAS_POR_BLOCO * 64)
+
+//Remistura o hash de 32 bits em 64 bits (finalizador do MurmurHash3); os 32 bits
+//altos escolhem o bloco e os 32 baixos, os bits dentro dele
+static uint64_t bloom_mix(unsigned int hash) {
+    uint64_t x = hash;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+//Bloco da chave: redução multiplicativa dos 32 bits altos (sem exigir potência de dois)
+static const uint64_t* bloom_bloco(const BloomFilter* filtro, uint64_t x) {
+    uint32_t indice = (uint32_t)(((x >> 32) * filtro->num_blocos) >> 32);
+    return filtro->blocos + (size_t)indice * BLOOM_PALAVRAS_POR_BLOCO;
+}
+
+//Posições dos bits: os 32 bits baixos espalhados em 64 (finalizador do SplitMix64),
+//dos quais 6 bits por palavra do bloco; não dependem dos bits que escolhem o bloco
+static uint64_t bloom_bits(uint64_t x) {
+    uint64_t y = (uint32_t)x * 0x9e3779b97f4a7c15ULL;
+    y ^= y >> 30;
+    y *= 0xbf58476d1ce4e5b9ULL;
+    y ^= y >> 27;
+    y *= 0x94d049bb133111ebULL;
+    y ^= y >> 31;
+    return y;
+}
+
+BloomFilter* bloom_create(int num_chaves) {
+    BloomFilter* filtro = malloc(sizeof(BloomFilter));
+    if (!filtro) {
+        fprintf(stderr, "Erro de alocação de memória para o filtro de Bloom\n");
+        return NULL;
+    }
+    long long bits = (long long)(num_chaves > 0 ? num_chaves : 1) * BLOOM_BITS_POR_CHAVE;
+    filtro->num_blocos = (uint32_t)((bits + BLOOM_BITS_POR_BLOCO - 1) / BLOOM_BITS_POR_BLOCO);
+
+    size_t bytes = (size_t)filtro->num_blocos * BLOOM_PALAVRAS_POR_BLOCO * sizeof(uint64_t);
+    filtro->blocos = aligned_alloc(64, bytes);
+    if (!filtro->blocos) {
+        fprintf(stderr, "Erro de alocação de memória para o filtro de Bloom\n");
+        free(filtro);
+        return NULL;
+    }
+    memset(filtro->blocos, 0, bytes);
+    return filtro;
+}
+
+void bloom_add(BloomFilter* filtro, unsigned int hash) {
+    if (!filtro) return;
+    uint64_t x = bloom_mix(hash);
+    uint64_t* bloco = (uint64_t*)bloom_bloco(filtro, x);
+    uint64_t bits = bloom_bits(x);
+    for (int i = 0; i < BLOOM_PALAVRAS_POR_BLOCO; i++) {
+        bloco[i] |= (uint64_t)1 << (bits >> (6 * i) & 63);
+    }
+}
+
+int bloom_may_contain(const BloomFilter* filtro, unsigned int hash) {
+    if (!filtro) return 1;
+    uint64_t x = bloom_mix(hash);
+    const uint64_t* bloco = bloom_bloco(filtro, x);
+    uint64_t bits = bloom_bits(x);
+
+    //Acumula os 8 bits sem desvios: basta um zero para rejeitar
+    uint64_t todos = 1;
+    for (int i = 0; i < BLOOM_PALAVRAS_POR_BLOCO; i++) {
+        todos &= bloco[i] >> (bits >> (6 * i) & 63);
+    }
+    return (int)(todos & 1);
+}
+
+void bloom_destroy(BloomFilter* filtro) {
+    if (!filtro) return;
+    free(filtro->blocos);
+    free(filtro);
+}
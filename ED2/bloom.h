@@ -0,0 +1,59 @@
+/**
+ * @file bloom.h
+ * @brief Filtro de Bloom em blocos para descartar rapidamente palavras que não
+ *        são palavras-chave
+ *
+ * O filtro recebe o hash de 32 bits de cada chave (hash_full) e responde "talvez
+ * presente" ou "certamente ausente". Cada chave marca 8 bits dentro de um único
+ * bloco de 64 bytes (uma linha de cache), um bit em cada palavra de 64 bits do
+ * bloco, então a consulta lê uma só linha e não tem desvios por bit. O bloco é
+ * escolhido pelos 32 bits altos do hash remisturado; os bits, por uma segunda
+ * mistura dos 32 bits baixos, de modo que bloco e bits não compartilham bits.
+ *
+ * Com BLOOM_BITS_POR_CHAVE bits por chave a taxa de falsos positivos fica perto
+ * de 0,1%; um falso positivo custa apenas a busca que o filtro teria evitado.
+ *
+ * @struct BloomFilter
+ * @brief Filtro de Bloom em blocos
+ * @var BloomFilter::blocos
+ *    num_blocos blocos de BLOOM_PALAVRAS_POR_BLOCO palavras, alinhados a 64 bytes
+ * @var BloomFilter::num_blocos
+ *    Número de blocos (pelo menos 1)
+ *
+ * @fn BloomFilter* bloom_create(int num_chaves)
+ * @brief Cria um filtro vazio dimensionado para num_chaves chaves
+ * @return Filtro criado, ou NULL em falha de alocação
+ *
+ * @fn void bloom_add(BloomFilter* filtro, unsigned int hash)
+ * @brief Acrescenta uma chave, dada pelo seu hash
+ *
+ * @fn int bloom_may_contain(const BloomFilter* filtro, unsigned int hash)
+ * @brief Consulta uma chave
+ * @return 0 se a chave certamente não foi acrescentada; 1 se talvez tenha sido
+ *         (sempre 1 para filtro NULL)
+ *
+ * @fn void bloom_destroy(BloomFilter* filtro)
+ * @brief Libera o filtro
+ */
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdint.h>
+
+#define BLOOM_PALAVRAS_POR_BLOCO 8  //Palavras de 64 bits por bloco (64 bytes)
+#define BLOOM_BITS_POR_CHAVE 16     //Bits de filtro reservados por chave
+
+//Filtro de Bloom em blocos
+typedef struct {
+    uint64_t* blocos;
+    uint32_t num_blocos;
+} BloomFilter;
+
+//Protótipos do filtro de Bloom
+BloomFilter* bloom_create(int num_chaves);
+void bloom_add(BloomFilter* filtro, unsigned int hash);
+int bloom_may_contain(const BloomFilter* filtro, unsigned int hash);
+void bloom_destroy(BloomFilter* filtro);
+
+#endif /* BLOOM_H */
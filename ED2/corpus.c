@@ -0,0 +1,96 @@
+/**
+ * @file corpus.c
+ * @brief Implementação do corpus de tokens compartilhado por referência
+ */
+
+#include "corpus.h"
+#include "indice_remissivo.h"
+
+// Corpus vazio com uma referência
+static TokenCorpus* corpus_alloc(void) {
+    TokenCorpus* corpus = calloc(1, sizeof(TokenCorpus));
+    if (!corpus) {
+        fprintf(stderr, "Erro de alocação de memória para o corpus\n");
+        return NULL;
+    }
+    corpus->refcount = 1;
+    return corpus;
+}
+
+TokenCorpus* corpus_create(const char* texto, size_t tamanho) {
+    TokenCorpus* corpus = corpus_alloc();
+    if (corpus && !processar_texto(texto, tamanho, corpus)) {
+        corpus_release(corpus);
+        return NULL;
+    }
+    return corpus;
+}
+
+TokenCorpus* corpus_create_from_file(const char* filename) {
+    TokenCorpus* corpus = corpus_alloc();
+    if (corpus && processar_arquivo(filename, corpus) <= 0) {
+        corpus_release(corpus);
+        return NULL;
+    }
+    return corpus;
+}
+
+TokenCorpus* corpus_append_from_file(TokenCorpus* anterior, const char* filename) {
+    TokenCorpus* corpus = corpus_alloc();
+    if (!corpus) return NULL;
+    if (processar_arquivo(filename, corpus) <= 0) {
+        corpus_release(corpus);
+        return NULL;
+    }
+    corpus_continue(corpus, anterior, corpus_total_tokens(anterior));
+    return corpus;
+}
+
+void corpus_continue(TokenCorpus* parte, TokenCorpus* anterior, int base) {
+    parte->base = base;
+    parte->anterior = corpus_retain(anterior);
+}
+
+TokenCorpus* corpus_retain(TokenCorpus* corpus) {
+    if (corpus) corpus->refcount++;
+    return corpus;
+}
+
+void corpus_release(TokenCorpus* corpus) {
+    // Percorre a cadeia sem recursão: cada parte liberada devolve a referência à anterior
+    while (corpus && --corpus->refcount == 0) {
+        TokenCorpus* anterior = corpus->anterior;
+        if (corpus->distintas) {
+            for (int i = 0; i < corpus->num_distintas; i++) {
+                free(corpus->distintas[i]);
+            }
+        }
+        postings_destroy(corpus->postings);  // Libera também as visões em posicoes[] e listas[]
+        free(corpus->distintas);
+        free(corpus->listas);
+        free(corpus->palavras);
+        free(corpus->posicoes);
+        free(corpus);
+        corpus = anterior;
+    }
+}
+
+int corpus_total_tokens(const TokenCorpus* corpus) {
+    return corpus ? corpus->base + corpus->num_palavras : 0;
+}
+
+TokenCorpus** corpus_parts(TokenCorpus* ultima, int* num_partes) {
+    int n = 0;
+    for (TokenCorpus* parte = ultima; parte; parte = parte->anterior) n++;
+
+    TokenCorpus** partes = malloc((n > 0 ? n : 1) * sizeof(TokenCorpus*));
+    if (!partes) return NULL;
+    int i = n;
+    for (TokenCorpus* parte = ultima; parte; parte = parte->anterior) partes[--i] = parte;
+    *num_partes = n;
+    return partes;
+}
+
+int corpus_is_first(const TokenCorpus* corpus, int i) {
+    return corpus->posicoes[i] && corpus->posicoes[i][0] > 0 && corpus->posicoes[i][1] == i;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file corpus.h
+ * @brief Corpus de tokens imutável e compartilhado entre os índices
+ *
+ * O texto é processado uma única vez (processar_texto ou processar_arquivo) e o
+ * resultado fica em um TokenCorpus. Cada palavra distinta é guardada uma única
+ * vez; palavras[i] aponta para a palavra distinta do token i. Os índices Hash, Trie e Radix apenas tomam emprestado o corpus
+ * (corpus_retain), sem copiar palavras nem posições; o corpus é liberado quando
+ * a última referência é devolvida (corpus_release).
+ *
+ * O corpus não é alterado depois de criado: quem precisar de outra ordem das
+ * palavras (por exemplo, para busca binária) deve ordenar um array próprio.
+ *
+ * Um texto que cresce é uma cadeia de corpus: corpus_append_from_file processa
+ * só o trecho novo e cria uma parte que guarda uma referência à anterior. As
+ * posições continuam locais à parte; a posição global do token i é base + i.
+ * Os índices Hash e Trie acrescentam as listas da parte nova (deslocadas por
+ * base) sem reconstruir nada (hash_append_indice, trie_append_indice).
+ *
+ * As posições são os índices dos tokens em palavras[]. Como as listas estão em
+ * ordem crescente, o token i é a primeira ocorrência da sua palavra exatamente
+ * quando posicoes[i][1] == i (ver corpus_is_first).
+ *
+ * @struct TokenCorpus
+ * @brief Tokens do texto e suas listas de posições
+ * @var TokenCorpus::palavras
+ * Palavra de cada token (em minúsculas; aponta para distintas[])
+ * @var TokenCorpus::posicoes
+ * Lista de posições da palavra de cada token (contador no slot 0); tokens da
+ * mesma palavra compartilham a mesma lista
+ * @var TokenCorpus::num_palavras
+ * Número de tokens
+ * @var TokenCorpus::distintas
+ * Palavras distintas, na ordem da primeira ocorrência (donas da memória)
+ * @var TokenCorpus::num_distintas
+ * Número de palavras distintas
+ * @var TokenCorpus::listas
+ * Lista de posições de cada palavra distinta (mesmas listas de posicoes[])
+ * @var TokenCorpus::base
+ * Posição global do primeiro token (tokens de todas as partes anteriores)
+ * @var TokenCorpus::anterior
+ * Parte anterior do texto (referência própria), ou NULL na primeira parte
+ * @var TokenCorpus::postings
+ * Arena onde estão todas as listas de posições
+ * @var TokenCorpus::refcount
+ * Número de referências ativas
+ *
+ * @fn TokenCorpus* corpus_create(const char* texto, size_t tamanho)
+ * @brief Processa um texto em memória e cria um corpus com uma referência
+ * @return Corpus criado (possivelmente sem palavras), ou NULL em caso de falha
+ *
+ * @fn TokenCorpus* corpus_create_from_file(const char* filename)
+ * @brief Processa um arquivo de qualquer tamanho (mmap ou leitura em blocos)
+ * @return Corpus criado (possivelmente sem palavras), ou NULL se o arquivo não
+ *         pôde ser aberto ou processado
+ *
+ * @fn TokenCorpus* corpus_append_from_file(TokenCorpus* anterior, const char* filename)
+ * @brief Processa um arquivo como continuação de anterior (pode ser NULL): a
+ *        nova parte começa na posição global anterior->base + anterior->num_palavras
+ * @return Nova parte com uma referência (e uma referência sua a anterior), ou NULL
+ *
+ * @fn void corpus_continue(TokenCorpus* parte, TokenCorpus* anterior, int base)
+ * @brief Encadeia uma parte recém-criada depois de anterior, a partir da posição
+ *        global base (que não pode ser menor que corpus_total_tokens(anterior))
+ *
+ * @fn TokenCorpus* corpus_retain(TokenCorpus* corpus)
+ * @brief Adiciona uma referência ao corpus e o retorna
+ *
+ * @fn void corpus_release(TokenCorpus* corpus)
+ * @brief Devolve uma referência; libera o corpus quando não restar nenhuma
+ *        (e devolve a referência à parte anterior)
+ *
+ * @fn int corpus_total_tokens(const TokenCorpus* corpus)
+ * @brief Número de tokens do texto até esta parte, inclusive (0 para NULL)
+ *
+ * @fn TokenCorpus** corpus_parts(TokenCorpus* ultima, int* num_partes)
+ * @brief Partes do texto da primeira até ultima (sem adicionar referências)
+ * @return Array a ser liberado com free(), ou NULL em falha de alocação
+ *
+ * @fn int corpus_is_first(const TokenCorpus* corpus, int i)
+ * @brief Indica se o token i é a primeira ocorrência da sua palavra
+ */
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include "postings.h"
+
+typedef struct TokenCorpus {
+    char** palavras;
+    int** posicoes;
+    int num_palavras;
+    char** distintas;
+    int num_distintas;
+    int** listas;
+    PostingStore* postings;
+    int base;
+    struct TokenCorpus* anterior;
+    int refcount;
+} TokenCorpus;
+
+TokenCorpus* corpus_create(const char* texto, size_t tamanho);
+TokenCorpus* corpus_create_from_file(const char* filename);
+TokenCorpus* corpus_append_from_file(TokenCorpus* anterior, const char* filename);
+void corpus_continue(TokenCorpus* parte, TokenCorpus* anterior, int base);
+TokenCorpus* corpus_retain(TokenCorpus* corpus);
+void corpus_release(TokenCorpus* corpus);
+int corpus_total_tokens(const TokenCorpus* corpus);
+TokenCorpus** corpus_parts(TokenCorpus* ultima, int* num_partes);
+int corpus_is_first(const TokenCorpus* corpus, int i);
+
+#endif /* CORPUS_H */
@@ -0,0 +1,317 @@
+/**
+ * @file dat.c
+ * @brief Conversão da Trie em double-array trie e busca nos vetores base/check
+ *
+ * Construção (trie_freeze):
+ * - Percorre a Trie em largura; cada nó recebe um estado
+ * - Para cada estado, procura o menor base tal que base + código de cada filho
+ *   caia em uma célula livre; a célula recebe check = estado pai
+ * - Nós de fim de palavra recebem um identificador em term[] com a palavra
+ *   original e suas posições copiadas para os pools do bloco
+ *
+ * Busca (dat_search):
+ * - t = base[s] + código; a transição existe se check[t] == s
+ *
+ * @note O bloco só contém deslocamentos, então pode ser gravado e mapeado
+ * diretamente; dat_from_buffer() valida um bloco vindo de fora.
+ */
+
+#include "dat.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define DAT_FREE (-1)
+#define DAT_ALIGN(x) (((x) + 7u) & ~(uint64_t)7u)
+
+//Vetores em construção (crescem conforme necessário)
+typedef struct {
+    int32_t* base;
+    int32_t* check;
+    int32_t* term;
+    uint32_t capacity;
+    uint32_t used;  //Maior célula ocupada + 1
+} DatBuilder;
+
+static int dat_reserve(DatBuilder* b, uint32_t needed) {
+    if (needed <= b->capacity) return 1;
+
+    uint32_t new_capacity = b->capacity ? b->capacity : 256;
+    while (new_capacity < needed) new_capacity *= 2;
+
+    int32_t* base = realloc(b->base, new_capacity * sizeof(int32_t));
+    if (!base) return 0;
+    b->base = base;
+    int32_t* check = realloc(b->check, new_capacity * sizeof(int32_t));
+    if (!check) return 0;
+    b->check = check;
+    int32_t* term = realloc(b->term, new_capacity * sizeof(int32_t));
+    if (!term) return 0;
+    b->term = term;
+
+    for (uint32_t i = b->capacity; i < new_capacity; i++) {
+        b->base[i] = 0;
+        b->check[i] = DAT_FREE;
+        b->term[i] = -1;
+    }
+    b->capacity = new_capacity;
+    return 1;
+}
+
+//Código de transição de um símbolo normalizado (1-27; 0 = inválido)
+static int dat_code(char c) {
+    if (c == '-') return 27;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 1;
+    return 0;
+}
+
+typedef struct {
+    TrieNode* node;
+    uint32_t state;
+} DatQueueItem;
+
+DoubleArrayTrie* trie_freeze(TrieNode* root) {
+    if (!root) return NULL;
+
+    uint32_t num_nodes = trie_node_count(root);
+    DatQueueItem* queue = malloc(num_nodes * sizeof(DatQueueItem));
+    DatBuilder b = {0};
+    if (!queue || !dat_reserve(&b, num_nodes + 28)) {
+        fprintf(stderr, "Erro de alocação de memória para double-array trie\n");
+        free(queue);
+        free(b.base);
+        free(b.check);
+        free(b.term);
+        return NULL;
+    }
+
+    //Primeira passada: transições e contagem das palavras
+    uint32_t head = 0, tail = 0;
+    uint32_t num_words = 0;
+    uint64_t postings_size = 0, strings_size = 0;
+    uint32_t first_free = 1;
+    int failed = 0;
+
+    b.check[0] = 0;  //Raiz (nunca é destino de transição, pois base >= 0 e código >= 1)
+    b.used = 1;
+    queue[tail++] = (DatQueueItem){root, 0};
+
+    while (head < tail && !failed) {
+        DatQueueItem item = queue[head++];
+        TrieNode* node = item.node;
+
+        if (node->is_end_of_word) {
+            b.term[item.state] = (int32_t)num_words++;
+            postings_size += node->num_occurrences;
+            strings_size += strlen(node->original_word ? node->original_word : "") + 1;
+        }
+
+        int codes[27];
+        int num_codes = 0;
+        for (int i = 0; i < 27; i++) {
+            if (node->children[i]) codes[num_codes++] = i + 1;
+        }
+        if (num_codes == 0) continue;
+
+        //Procura o menor base em que todas as células dos filhos estão livres
+        while (first_free < b.capacity && b.check[first_free] != DAT_FREE) first_free++;
+        int32_t base = (int32_t)first_free - codes[0];
+        if (base < 0) base = 0;
+        for (;; base++) {
+            if (!dat_reserve(&b, (uint32_t)base + 28)) {
+                failed = 1;
+                break;
+            }
+            int ok = 1;
+            for (int k = 0; k < num_codes && ok; k++) {
+                if (b.check[base + codes[k]] != DAT_FREE) ok = 0;
+            }
+            if (ok) break;
+        }
+        if (failed) break;
+
+        b.base[item.state] = base;
+        for (int k = 0; k < num_codes; k++) {
+            uint32_t t = (uint32_t)(base + codes[k]);
+            b.check[t] = (int32_t)item.state;
+            if (t + 1 > b.used) b.used = t + 1;
+            queue[tail++] = (DatQueueItem){trie_node_child(root, node, codes[k] - 1), t};
+        }
+    }
+
+    if (failed || postings_size > UINT32_MAX || strings_size > UINT32_MAX) {
+        fprintf(stderr, "Erro ao construir double-array trie\n");
+        free(queue);
+        free(b.base);
+        free(b.check);
+        free(b.term);
+        return NULL;
+    }
+
+    //Monta o bloco contíguo
+    uint32_t num_states = b.used;
+    uint64_t offset = DAT_ALIGN(sizeof(DoubleArrayTrie));
+    uint64_t base_off = offset;      offset = DAT_ALIGN(offset + (uint64_t)num_states * sizeof(int32_t));
+    uint64_t check_off = offset;     offset = DAT_ALIGN(offset + (uint64_t)num_states * sizeof(int32_t));
+    uint64_t term_off = offset;      offset = DAT_ALIGN(offset + (uint64_t)num_states * sizeof(int32_t));
+    uint64_t words_off = offset;     offset = DAT_ALIGN(offset + (uint64_t)num_words * sizeof(DatWord));
+    uint64_t postings_off = offset;  offset = DAT_ALIGN(offset + postings_size * sizeof(int32_t));
+    uint64_t strings_off = offset;   offset = DAT_ALIGN(offset + strings_size);
+
+    unsigned char* block = calloc(1, offset);
+    if (!block) {
+        fprintf(stderr, "Erro de alocação de memória para double-array trie\n");
+        free(queue);
+        free(b.base);
+        free(b.check);
+        free(b.term);
+        return NULL;
+    }
+
+    DoubleArrayTrie* dat = (DoubleArrayTrie*)block;
+    dat->magic = DAT_MAGIC;
+    dat->version = DAT_VERSION;
+    dat->num_states = num_states;
+    dat->num_words = num_words;
+    dat->postings_size = (uint32_t)postings_size;
+    dat->strings_size = (uint32_t)strings_size;
+    dat->total_size = offset;
+    dat->base_off = base_off;
+    dat->check_off = check_off;
+    dat->term_off = term_off;
+    dat->words_off = words_off;
+    dat->postings_off = postings_off;
+    dat->strings_off = strings_off;
+
+    memcpy(block + base_off, b.base, num_states * sizeof(int32_t));
+    memcpy(block + check_off, b.check, num_states * sizeof(int32_t));
+    memcpy(block + term_off, b.term, num_states * sizeof(int32_t));
+
+    //Segunda passada: copia palavras e posições na ordem dos identificadores
+    DatWord* words = (DatWord*)(block + words_off);
+    int32_t* postings = (int32_t*)(block + postings_off);
+    char* strings = (char*)(block + strings_off);
+    uint32_t next_posting = 0, next_string = 0;
+    for (uint32_t i = 0; i < tail; i++) {
+        TrieNode* node = queue[i].node;
+        if (!node->is_end_of_word) continue;
+
+        DatWord* w = &words[b.term[queue[i].state]];
+        const char* original = node->original_word ? node->original_word : "";
+        size_t len = strlen(original) + 1;
+        memcpy(strings + next_string, original, len);
+        w->string_off = next_string;
+        next_string += (uint32_t)len;
+
+        PostingCursor cur;
+        posting_cursor_init(&cur, node->packed_occurrences ? NULL : node->occurrences,
+                            node->packed_occurrences, node->num_occurrences);
+        w->postings_off = next_posting;
+        int position;
+        while (posting_cursor_next(&cur, &position)) postings[next_posting++] = position;
+        w->count = next_posting - w->postings_off;
+    }
+
+    free(queue);
+    free(b.base);
+    free(b.check);
+    free(b.term);
+    return dat;
+}
+
+//Percorre a chave normalizada e retorna a palavra armazenada, ou NULL
+static const DatWord* dat_find(const DoubleArrayTrie* dat, const char* word) {
+    if (!dat || !word) return NULL;
+
+    char key[MAX_WORD_SIZE];
+    int len = trie_normalize_word(word, key, MAX_WORD_SIZE);
+    if (len == 0) return NULL;
+
+    const unsigned char* block = (const unsigned char*)dat;
+    const int32_t* base = (const int32_t*)(block + dat->base_off);
+    const int32_t* check = (const int32_t*)(block + dat->check_off);
+    const int32_t* term = (const int32_t*)(block + dat->term_off);
+
+    uint32_t s = 0;
+    for (int i = 0; i < len; i++) {
+        uint32_t t = (uint32_t)base[s] + (uint32_t)dat_code(key[i]);
+        if (t >= dat->num_states || check[t] != (int32_t)s) return NULL;
+        s = t;
+    }
+
+    if (term[s] < 0) return NULL;
+    return (const DatWord*)(block + dat->words_off) + term[s];
+}
+
+const int* dat_search(const DoubleArrayTrie* dat, const char* word, int* num_occurrences) {
+    const DatWord* w = dat_find(dat, word);
+    if (!w) {
+        if (num_occurrences) *num_occurrences = 0;
+        return NULL;
+    }
+
+    if (num_occurrences) *num_occurrences = (int)w->count;
+    return (const int*)((const unsigned char*)dat + dat->postings_off) + w->postings_off;
+}
+
+const char* dat_original_word(const DoubleArrayTrie* dat, const char* word) {
+    const DatWord* w = dat_find(dat, word);
+    if (!w) return NULL;
+    return (const char*)dat + dat->strings_off + w->string_off;
+}
+
+size_t dat_size(const DoubleArrayTrie* dat) {
+    return dat ? (size_t)dat->total_size : 0;
+}
+
+//Verifica se uma seção está dentro do bloco e alinhada
+static int dat_section_ok(uint64_t off, uint64_t len, size_t size) {
+    return (off & 7u) == 0 && off <= size && len <= size - off;
+}
+
+//Valida um bloco vindo de arquivo ou de mmap: além do cabeçalho, cada
+//identificador de term[] e cada palavra, para que as buscas não precisem
+//conferir deslocamentos
+const DoubleArrayTrie* dat_from_buffer(const void* buffer, size_t size) {
+    if (!buffer || ((uintptr_t)buffer & 7u) != 0 || size < sizeof(DoubleArrayTrie)) return NULL;
+
+    const DoubleArrayTrie* dat = (const DoubleArrayTrie*)buffer;
+    if (dat->magic != DAT_MAGIC || dat->version != DAT_VERSION || dat->total_size > size) {
+        return NULL;
+    }
+
+    uint64_t states_bytes = (uint64_t)dat->num_states * sizeof(int32_t);
+    if (dat->num_states == 0 ||
+        !dat_section_ok(dat->base_off, states_bytes, size) ||
+        !dat_section_ok(dat->check_off, states_bytes, size) ||
+        !dat_section_ok(dat->term_off, states_bytes, size) ||
+        !dat_section_ok(dat->words_off, (uint64_t)dat->num_words * sizeof(DatWord), size) ||
+        !dat_section_ok(dat->postings_off, (uint64_t)dat->postings_size * sizeof(int32_t), size) ||
+        !dat_section_ok(dat->strings_off, dat->strings_size, size)) {
+        return NULL;
+    }
+
+    const unsigned char* block = (const unsigned char*)buffer;
+    const int32_t* term = (const int32_t*)(block + dat->term_off);
+    for (uint32_t s = 0; s < dat->num_states; s++) {
+        if (term[s] >= 0 && (uint32_t)term[s] >= dat->num_words) return NULL;
+    }
+
+    //Toda palavra original termina dentro do pool, que acaba em '\0'
+    const char* strings = (const char*)(block + dat->strings_off);
+    if (dat->strings_size > 0 && strings[dat->strings_size - 1] != '\0') return NULL;
+
+    const DatWord* words = (const DatWord*)(block + dat->words_off);
+    for (uint32_t i = 0; i < dat->num_words; i++) {
+        if (words[i].string_off >= dat->strings_size || words[i].count > INT32_MAX ||
+            (uint64_t)words[i].postings_off + words[i].count > dat->postings_size) {
+            return NULL;
+        }
+    }
+
+    return dat;
+}
+
+void dat_destroy(DoubleArrayTrie* dat) {
+    free(dat);
+}
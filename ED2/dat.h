@@ -0,0 +1,92 @@
+/**
+* @file dat.h
+* @brief Trie de vetor duplo (double-array trie) somente leitura
+*
+* Depois de criado, o índice Trie pode ser "congelado" em uma double-array trie:
+* as transições ficam nos vetores base/check, de modo que cada símbolo da busca
+* custa duas leituras de vetor em vez de seguir ponteiros. Os símbolos são os
+* mesmos da Trie (26 letras + hífen, normalizados), codificados de 1 a 27.
+*
+* A estrutura é um único bloco contíguo de memória, sem ponteiros: todas as
+* referências internas são deslocamentos a partir do início do bloco. Por isso
+* o bloco pode ser gravado em disco e mapeado de volta com mmap (dat_from_buffer).
+*
+* Layout do bloco (todos os inteiros em 32 bits, na ordem da máquina):
+* - DoubleArrayTrie (cabeçalho)
+* - base[num_states], check[num_states], term[num_states]
+* - words[num_words] (DatWord)
+* - postings[postings_size] (posições de todas as palavras)
+* - strings[strings_size] (palavras originais terminadas em '\0')
+*
+* @struct DoubleArrayTrie
+* @brief Cabeçalho do bloco; os campos *_off são deslocamentos em bytes
+*
+* @struct DatWord
+* @brief Palavra armazenada: deslocamentos da palavra original e das posições
+*
+* @fn DoubleArrayTrie* trie_freeze(TrieNode* root)
+* @brief Converte uma Trie construída em uma double-array trie
+* @return Bloco alocado com malloc (liberar com dat_destroy) ou NULL em caso de falha
+*
+* @fn const int* dat_search(const DoubleArrayTrie* dat, const char* word, int* num_occurrences)
+* @brief Busca uma palavra (mesmo contrato de trie_search)
+*
+* @fn const char* dat_original_word(const DoubleArrayTrie* dat, const char* word)
+* @brief Retorna a palavra original armazenada para a chave, ou NULL
+*
+* @fn size_t dat_size(const DoubleArrayTrie* dat)
+* @brief Tamanho total do bloco em bytes (para gravação em disco)
+*
+* @fn const DoubleArrayTrie* dat_from_buffer(const void* buffer, size_t size)
+* @brief Valida um bloco lido ou mapeado da memória e o retorna, ou NULL se inválido
+*
+* Confere o alinhamento e os limites das seções, os identificadores de term[] e
+* as palavras (deslocamentos dentro dos pools); as buscas confiam no bloco validado
+*
+* @fn void dat_destroy(DoubleArrayTrie* dat)
+* @brief Libera um bloco criado por trie_freeze
+*/
+
+#ifndef DAT_H
+#define DAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "trie.h"
+
+#define DAT_MAGIC 0x31544144u  /* "DAT1" */
+#define DAT_VERSION 1u
+
+//Cabeçalho do bloco contíguo
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_states;
+    uint32_t num_words;
+    uint32_t postings_size;
+    uint32_t strings_size;
+    uint64_t total_size;
+    uint64_t base_off;
+    uint64_t check_off;
+    uint64_t term_off;
+    uint64_t words_off;
+    uint64_t postings_off;
+    uint64_t strings_off;
+} DoubleArrayTrie;
+
+//Palavra armazenada no bloco
+typedef struct {
+    uint32_t string_off;
+    uint32_t postings_off;
+    uint32_t count;
+} DatWord;
+
+//Protótipos das funções da double-array trie
+DoubleArrayTrie* trie_freeze(TrieNode* root);
+const int* dat_search(const DoubleArrayTrie* dat, const char* word, int* num_occurrences);
+const char* dat_original_word(const DoubleArrayTrie* dat, const char* word);
+size_t dat_size(const DoubleArrayTrie* dat);
+const DoubleArrayTrie* dat_from_buffer(const void* buffer, size_t size);
+void dat_destroy(DoubleArrayTrie* dat);
+
+#endif /* DAT_H */
@@ -0,0 +1,219 @@
+/**
+ * @file docs.c
+ * @brief Coleção de documentos: expansão de diretórios, processamento paralelo
+ *        dos arquivos e localização das posições globais
+ */
+
+#include "docs.h"
+#include "indice_remissivo.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+//Lista de caminhos de arquivos (donos das strings)
+typedef struct {
+    char** itens;
+    int num;
+    int capacidade;
+} ListaCaminhos;
+
+//Processamento paralelo: cada thread pega o próximo arquivo ainda não processado
+typedef struct {
+    char* const* caminhos;
+    TokenCorpus** partes;
+    int num;
+    atomic_int proximo;
+} Ingestao;
+
+DocumentSet* docs_create(void) {
+    DocumentSet* ds = calloc(1, sizeof(DocumentSet));
+    if (!ds) fprintf(stderr, "Erro de alocação de memória para os documentos\n");
+    return ds;
+}
+
+//Acrescenta uma cópia do caminho à lista
+static int lista_adicionar(ListaCaminhos* lista, const char* caminho) {
+    if (lista->num == lista->capacidade) {
+        int nova_cap = lista->capacidade ? lista->capacidade * 2 : 16;
+        char** novos = realloc(lista->itens, nova_cap * sizeof(char*));
+        if (!novos) {
+            fprintf(stderr, "Erro de alocação de memória para os caminhos\n");
+            return 0;
+        }
+        lista->itens = novos;
+        lista->capacidade = nova_cap;
+    }
+    char* copia = strdup(caminho);
+    if (!copia) {
+        fprintf(stderr, "Erro de alocação de memória para os caminhos\n");
+        return 0;
+    }
+    lista->itens[lista->num++] = copia;
+    return 1;
+}
+
+static void lista_liberar(ListaCaminhos* lista) {
+    for (int i = 0; i < lista->num; i++) free(lista->itens[i]);
+    free(lista->itens);
+}
+
+static int comparar_caminhos(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+//Acrescenta um caminho: arquivos entram direto; diretórios são expandidos em
+//ordem alfabética (recursivamente), sem as entradas ocultas
+static int expandir_caminho(ListaCaminhos* lista, const char* caminho) {
+    struct stat st;
+    if (stat(caminho, &st) != 0) {
+        fprintf(stderr, "Caminho inexistente: %s\n", caminho);
+        return 1;  //Ignorado, como um arquivo que não pôde ser lido
+    }
+    if (!S_ISDIR(st.st_mode)) return lista_adicionar(lista, caminho);
+
+    DIR* dir = opendir(caminho);
+    if (!dir) {
+        fprintf(stderr, "Erro ao abrir o diretório: %s\n", caminho);
+        return 1;
+    }
+    ListaCaminhos entradas = {NULL, 0, 0};
+    size_t len = strlen(caminho);
+    int ok = 1;
+    for (struct dirent* e; ok && (e = readdir(dir)) != NULL;) {
+        if (e->d_name[0] == '.') continue;
+        char* completo = malloc(len + 1 + strlen(e->d_name) + 1);
+        if (!completo) {
+            fprintf(stderr, "Erro de alocação de memória para os caminhos\n");
+            ok = 0;
+            break;
+        }
+        sprintf(completo, len && caminho[len - 1] == '/' ? "%s%s" : "%s/%s", caminho, e->d_name);
+        ok = lista_adicionar(&entradas, completo);
+        free(completo);
+    }
+    closedir(dir);
+
+    qsort(entradas.itens, entradas.num, sizeof(char*), comparar_caminhos);
+    for (int i = 0; i < entradas.num && ok; i++) ok = expandir_caminho(lista, entradas.itens[i]);
+    lista_liberar(&entradas);
+    return ok;
+}
+
+static void* ingestao_run(void* arg) {
+    Ingestao* in = (Ingestao*)arg;
+    for (int i; (i = atomic_fetch_add(&in->proximo, 1)) < in->num;) {
+        in->partes[i] = corpus_create_from_file(in->caminhos[i]);
+    }
+    return NULL;
+}
+
+//Garante espaço para mais um documento
+static int docs_reservar(DocumentSet* ds) {
+    if (ds->num_docs < ds->capacidade) return 1;
+    int nova_cap = ds->capacidade ? ds->capacidade * 2 : 16;
+    char** nomes = realloc(ds->nomes, nova_cap * sizeof(char*));
+    if (nomes) ds->nomes = nomes;
+    TokenCorpus** partes = nomes ? realloc(ds->partes, nova_cap * sizeof(TokenCorpus*)) : NULL;
+    if (partes) ds->partes = partes;
+    if (!nomes || !partes) {
+        fprintf(stderr, "Erro de alocação de memória para os documentos\n");
+        return 0;
+    }
+    ds->capacidade = nova_cap;
+    return 1;
+}
+
+int docs_add_paths(DocumentSet* ds, char* const caminhos[], int n, int num_threads) {
+    if (!ds || !caminhos || n <= 0) return 0;
+
+    ListaCaminhos lista = {NULL, 0, 0};
+    int ok = 1;
+    for (int i = 0; i < n && ok; i++) ok = expandir_caminho(&lista, caminhos[i]);
+    TokenCorpus** partes = ok && lista.num > 0 ? calloc(lista.num, sizeof(TokenCorpus*)) : NULL;
+    if (!partes) {
+        if (ok && lista.num > 0) fprintf(stderr, "Erro de alocação de memória para os documentos\n");
+        lista_liberar(&lista);
+        return 0;
+    }
+
+    //A tabela de delimitadores é montada na primeira tokenização: monta antes das threads
+    tabela_delimitadores();
+    Ingestao in;
+    in.caminhos = lista.itens;
+    in.partes = partes;
+    in.num = lista.num;
+    atomic_init(&in.proximo, 0);
+
+    if (num_threads > lista.num) num_threads = lista.num;
+    if (num_threads > DOCS_MAX_THREADS) num_threads = DOCS_MAX_THREADS;
+    pthread_t threads[DOCS_MAX_THREADS];
+    int started = 0;
+    for (; started < num_threads - 1; started++) {
+        if (pthread_create(&threads[started], NULL, ingestao_run, &in) != 0) break;
+    }
+    ingestao_run(&in);  //A thread atual também processa arquivos
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+
+    //Encadeia os documentos na ordem dos caminhos, separados por DOCS_SEPARACAO posições
+    int acrescentados = 0;
+    for (int i = 0; i < lista.num; i++) {
+        if (!partes[i]) {
+            fprintf(stderr, "Documento ignorado: %s\n", lista.itens[i]);
+            continue;
+        }
+        if (!docs_reservar(ds)) {
+            corpus_release(partes[i]);
+            continue;
+        }
+        TokenCorpus* anterior = docs_ultima(ds);
+        corpus_continue(partes[i], anterior, anterior ? corpus_total_tokens(anterior) + DOCS_SEPARACAO : 0);
+        ds->nomes[ds->num_docs] = lista.itens[i];
+        ds->partes[ds->num_docs++] = partes[i];
+        lista.itens[i] = NULL;  //Agora pertence à coleção
+        acrescentados++;
+    }
+
+    free(partes);
+    lista_liberar(&lista);
+    return acrescentados;
+}
+
+TokenCorpus* docs_ultima(const DocumentSet* ds) {
+    return ds && ds->num_docs > 0 ? ds->partes[ds->num_docs - 1] : NULL;
+}
+
+int docs_find(const DocumentSet* ds, int posicao) {
+    if (!ds || ds->num_docs == 0 || posicao < 0) return -1;
+
+    //Último documento com base <= posicao
+    int esq = 0, dir = ds->num_docs - 1;
+    while (esq < dir) {
+        int meio = esq + (dir - esq + 1) / 2;
+        if (ds->partes[meio]->base <= posicao) esq = meio;
+        else dir = meio - 1;
+    }
+    const TokenCorpus* parte = ds->partes[esq];
+    return posicao >= parte->base && posicao < parte->base + parte->num_palavras ? esq : -1;
+}
+
+int docs_group(const DocumentSet* ds, const int* posicoes, int n, int inicio, int* doc) {
+    *doc = inicio < n ? docs_find(ds, posicoes[inicio]) : -1;
+    if (*doc < 0) return inicio + 1;
+
+    int fim = ds->partes[*doc]->base + ds->partes[*doc]->num_palavras;
+    int i = inicio + 1;
+    while (i < n && posicoes[i] < fim) i++;
+    return i;
+}
+
+void docs_destroy(DocumentSet* ds) {
+    if (!ds) return;
+    for (int d = 0; d < ds->num_docs; d++) {
+        corpus_release(ds->partes[d]);
+        free(ds->nomes[d]);
+    }
+    free(ds->nomes);
+    free(ds->partes);
+    free(ds);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file docs.h
+ * @brief Coleção de documentos indexados juntos (vários arquivos ou diretórios)
+ *
+ * Cada documento é uma parte da cadeia de corpus (corpus.h): as posições de todos
+ * os documentos formam um único espaço global, e o documento d ocupa as posições
+ * partes[d]->base .. partes[d]->base + partes[d]->num_palavras - 1. Entre dois
+ * documentos ficam DOCS_SEPARACAO posições vazias, de modo que frases e
+ * consultas NEAR com distância menor que a separação nunca cruzam documentos.
+ *
+ * Assim os índices Hash e Trie guardam os pares (documento, posição) como uma
+ * única posição global, com a mesma compactação delta + varint das listas
+ * (postings.h); o par é recuperado com docs_find, por busca binária nas bases.
+ *
+ * Os arquivos são processados em paralelo (cada thread pega o próximo arquivo
+ * ainda não processado) e encadeados na ordem dos caminhos; diretórios são
+ * expandidos recursivamente, em ordem alfabética, ignorando entradas ocultas.
+ *
+ * @struct DocumentSet
+ * @brief Documentos carregados
+ * @var DocumentSet::nomes
+ *    Caminho de cada documento
+ * @var DocumentSet::partes
+ *    Corpus de cada documento (uma referência própria por documento)
+ * @var DocumentSet::num_docs
+ *    Número de documentos
+ * @var DocumentSet::capacidade
+ *    Capacidade dos arrays nomes e partes
+ *
+ * @fn DocumentSet* docs_create(void)
+ * @brief Cria uma coleção vazia
+ *
+ * @fn int docs_add_paths(DocumentSet* ds, char* const caminhos[], int n, int num_threads)
+ * @brief Acrescenta os arquivos indicados (diretórios são expandidos) como novos documentos
+ * @param num_threads Threads de processamento (até DOCS_MAX_THREADS)
+ * @return Número de documentos acrescentados (arquivos que falharam são ignorados)
+ *
+ * @fn TokenCorpus* docs_ultima(const DocumentSet* ds)
+ * @brief Última parte da cadeia (mantém todas as anteriores), ou NULL se vazia
+ *
+ * @fn int docs_find(const DocumentSet* ds, int posicao)
+ * @brief Documento que contém uma posição global (-1 se nenhum)
+ *
+ * @fn int docs_group(const DocumentSet* ds, const int* posicoes, int n, int inicio, int* doc)
+ * @brief Agrupa uma lista ordenada de posições globais por documento
+ * @param doc Recebe o documento de posicoes[inicio] (-1 se nenhum)
+ * @return Índice da primeira posição depois de inicio que está em outro documento
+ *
+ * @fn void docs_destroy(DocumentSet* ds)
+ * @brief Devolve as referências aos documentos e libera a coleção
+ */
+
+#ifndef DOCS_H
+#define DOCS_H
+
+#include "corpus.h"
+
+#define DOCS_SEPARACAO 1024  //Posições vazias entre documentos consecutivos
+#define DOCS_MAX_THREADS 64
+
+//Coleção de documentos
+typedef struct {
+    char** nomes;
+    TokenCorpus** partes;
+    int num_docs;
+    int capacidade;
+} DocumentSet;
+
+//Protótipos das funções da coleção
+DocumentSet* docs_create(void);
+int docs_add_paths(DocumentSet* ds, char* const caminhos[], int n, int num_threads);
+TokenCorpus* docs_ultima(const DocumentSet* ds);
+int docs_find(const DocumentSet* ds, int posicao);
+int docs_group(const DocumentSet* ds, const int* posicoes, int n, int inicio, int* doc);
+void docs_destroy(DocumentSet* ds);
+
+#endif /* DOCS_H */
@@ -9,31 +9,65 @@
  * em um texto. A tabela usa endereçamento aberto com sondagem linear para resolução de colisões
  * e redimensionamento dinâmico para manter a eficiência.
  *
+ * A capacidade é sempre uma potência de dois, de modo que o índice inicial é obtido por
+ * máscara (sem divisões). Um vetor separado de bytes de controle guarda, para cada slot,
+ * um fragmento de 7 bits do hash (ou HASH_CTRL_EMPTY); a sondagem examina grupos de
+ * HASH_GROUP_WIDTH slots de uma vez (SSE2 quando disponível, laço escalar caso contrário)
+ * e só consulta as entradas cujo fragmento coincide.
+ *
  * Características principais:
  * - Função hash FNV-1a para melhor distribuição
- * - Redimensionamento automático quando fator de carga > 0.7
+ * - Hash completo (32 bits) guardado em cada entrada: as sondagens comparam o
+ *   hash antes da string e o redimensionamento não recalcula hashes
+ * - Redimensionamento automático quando fator de carga > 0.7 (capacidade dobra)
  * - Suporte a múltiplas ocorrências por palavra
- * - Tratamento case-insensitive das palavras
+ * - Palavras comparadas pela chave normalizada (normalize.h: sem acentos e sem
+ *   distinção de caixa), guardada com seu tamanho e comparada com memcmp
  * - Visualização da estrutura em diferentes formatos
+ * - Compactação opcional das ocorrências (delta + varint) com leitura por cursor
+ * - Número e duração dos redimensionamentos guardados na tabela (hash_stats) e
+ *   contadores opcionais de sondagem nas inserções e buscas (stats.h, INDICE_STATS)
  *
  * Estruturas principais:
  * @struct HashEntry
- *    - word: palavra armazenada
+ *    - word: palavra armazenada (primeira forma encontrada)
+ *    - key/key_len: chave normalizada da palavra e seu tamanho
+ *    - hash: hash completo da palavra (hash_full)
  *    - occurrences: array com posições da palavra
  *    - num_occurrences: número atual de ocorrências
  *    - max_occurrences: capacidade máxima do array de ocorrências
+ *    - packed_occurrences/packed_size: ocorrências compactadas (opcional)
+ *    - unsorted: ocorrências acrescentadas fora de ordem no modo em lote
  *
  * @struct HashTable
  *    - table: array de HashEntry
- *    - size: tamanho atual da tabela
+ *    - ctrl: bytes de controle (fragmento do hash ou vazio), com espelho do primeiro grupo
+ *    - size: tamanho atual da tabela (potência de dois)
  *    - entries: número de entradas ocupadas
+ *    - bulk: modo de inserção em lote ativo
+ *    - resizes/resize_ns: redimensionamentos feitos e tempo total gasto neles
  *
  * Funções principais:
  * - hash_create(): Cria nova tabela hash
  * - hash_insert(): Insere palavra e posição
+ * - hash_insert_positions(): Insere palavra com uma lista ordenada de posições
+ * - hash_begin_bulk()/hash_finalize(): Inserção em lote (acrescenta sem ordenar;
+ *   ordena e remove duplicatas uma vez por entrada no final)
  * - hash_search(): Busca palavra e retorna ocorrências
+ * - hash_search_cursor(): Busca palavra e retorna cursor sobre as ocorrências
+ * - hash_search_batch(): Busca um lote de palavras com pré-carregamento dos slots
+ * - hash_search_batch_filtered()/hash_bloom_filter(): Busca em lote precedida de um
+ *   filtro de Bloom das chaves, que descarta a maioria das palavras ausentes sem
+ *   sondar a tabela (usada na procura das palavras-chave entre os tokens)
+ * - hash_compact(): Compacta as ocorrências de todas as entradas
  * - hash_resize(): Redimensiona tabela quando necessário
  * - criar_indice_hash(): Cria índice remissivo
+ * - criar_indice_hash_paralelo(): Cria o índice com várias threads (tabelas por
+ *   intervalo de tokens combinadas por k-way merge)
+ * - hash_append_indice(): Acrescenta as ocorrências de uma nova parte do texto
+ *   ou de novas palavras-chave a um índice existente
+ * - hash_write_index(): Escreve o índice em ordem alfabética em uma saída com
+ *   buffer (output.h: texto, CSV ou JSON)
  * - imprimir_indice_hash(): Imprime índice em ordem alfabética
  * - imprimir_estrutura_hash(): Visualiza estrutura interna
  * - imprimir_hash_arvore(): Visualiza em formato de árvore
@@ -51,6 +85,52 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include "normalize.h"
+#include "stats.h"
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Arredonda a capacidade para a próxima potência de dois (mínimo de um grupo)
+static int hash_capacity(int size) {
+    int capacity = HASH_GROUP_WIDTH;
+    while (capacity < size) capacity *= 2;
+    return capacity;
+}
+
+//Aloca as entradas e os bytes de controle de uma tabela com capacidade size
+static int hash_alloc_slots(HashTable* ht, int size) {
+    HashEntry* table = (HashEntry*)calloc(size, sizeof(HashEntry));
+    unsigned char* ctrl = (unsigned char*)malloc(size + HASH_GROUP_WIDTH);
+    if (table == NULL || ctrl == NULL) {
+        free(table);
+        free(ctrl);
+        return 0;
+    }
+
+    //Inicializa todas as entradas
+    for (int i = 0; i < size; i++) {
+        table[i].word = NULL;
+        table[i].key = NULL;
+        table[i].key_len = 0;
+        table[i].hash = 0;
+        table[i].occurrences = NULL;
+        table[i].num_occurrences = 0;
+        table[i].max_occurrences = 0;
+        table[i].packed_occurrences = NULL;
+        table[i].packed_size = 0;
+        table[i].unsorted = 0;
+    }
+    memset(ctrl, HASH_CTRL_EMPTY, size + HASH_GROUP_WIDTH);
+
+    ht->table = table;
+    ht->ctrl = ctrl;
+    ht->size = size;
+    return 1;
+}
 
 //Cria uma nova tabela hash
 HashTable* hash_create(int size) {
@@ -60,161 +140,357 @@ HashTable* hash_create(int size) {
         exit(EXIT_FAILURE);
     }
 
-    ht->size = size;
     ht->entries = 0;
-    ht->table = (HashEntry*)calloc(size, sizeof(HashEntry));
-    if (ht->table == NULL) {
+    ht->bulk = 0;
+    ht->resizes = 0;
+    ht->resize_ns = 0;
+    if (!hash_alloc_slots(ht, hash_capacity(size))) {
         free(ht);
         fprintf(stderr, "Erro de alocação de memória para HashEntry\n");
         exit(EXIT_FAILURE);
     }
 
-    //Inicializa todas as entradas
-    for (int i = 0; i < size; i++) {
-        ht->table[i].word = NULL;
-        ht->table[i].occurrences = NULL;
-        ht->table[i].num_occurrences = 0;
-        ht->table[i].max_occurrences = 0;
-    }
-
     return ht;
 }
 
-//Função de hash melhorada (FNV-1a hash)
-unsigned int hash_function(const char* word, int size) {
+//FNV-1a sobre os bytes de uma chave já normalizada
+static unsigned int hash_key(const char* key, int key_len) {
     unsigned int hash = 2166136261u;  //Valor inicial (offset) padrão do FNV-1a de 32 bits
-    for (; *word; word++) {
-        hash ^= tolower(*word);
+    for (int i = 0; i < key_len; i++) {
+        hash ^= (unsigned char)key[i];
         hash *= 16777619u;  //Número primo usado pelo FNV-1a para multiplicação
     }
-    return hash % size;
+    return hash;
+}
+
+//Função de hash melhorada (FNV-1a hash) da chave normalizada, sem redução ao tamanho da tabela
+unsigned int hash_full(const char* word) {
+    char key[MAX_WORD_SIZE];
+    int key_len = normalize_key(word, key, MAX_WORD_SIZE);
+    return hash_key(key, key_len);
+}
+
+//Índice hash da palavra em uma tabela de tamanho size (potência de dois)
+unsigned int hash_function(const char* word, int size) {
+    return hash_full(word) & (unsigned int)(size - 1);
+}
+
+//Fragmento de 7 bits guardado no byte de controle (bits altos, independentes do índice)
+static unsigned char hash_fragment(unsigned int hash) {
+    return (unsigned char)(hash >> 25);
 }
 
-//Redimensiona a tabela hash 
+//Grava o byte de controle, espelhando os primeiros slots no fim do vetor
+//para que um grupo que passe do último slot possa ser lido de uma vez
+static void hash_set_ctrl(HashTable* ht, unsigned int index, unsigned char value) {
+    ht->ctrl[index] = value;
+    if (index < HASH_GROUP_WIDTH) ht->ctrl[ht->size + index] = value;
+}
+
+//Pré-carrega uma linha de cache que será lida em breve
+#if defined(__GNUC__)
+#define HASH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define HASH_PREFETCH(addr) ((void)(addr))
+#endif
+
+static unsigned int hash_lowest_bit(unsigned int mask) {
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int bit = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+//Compara um grupo de HASH_GROUP_WIDTH bytes de controle de uma vez.
+//match recebe os slots com o mesmo fragmento; empty recebe os slots vazios
+static void hash_group_match(const unsigned char* ctrl, unsigned char fragment,
+                             unsigned int* match, unsigned int* empty) {
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    *match = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)fragment)));
+    *empty = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)HASH_CTRL_EMPTY)));
+#else
+    *match = 0;
+    *empty = 0;
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++) {
+        if (ctrl[i] == fragment) *match |= 1u << i;
+        if (ctrl[i] == HASH_CTRL_EMPTY) *empty |= 1u << i;
+    }
+#endif
+}
+
+//Localiza a palavra, ou o slot vazio onde ela seria inserida, usando sondagem linear
+//em grupos: os bytes de controle filtram os candidatos e o hash guardado é comparado
+//antes da chave normalizada, evitando memcmp na maioria das colisões.
+//Retorna 1 se encontrou, 0 se parou em um slot vazio e -1 se a tabela está cheia
+static int hash_probe(const HashTable* ht, const char* key, int key_len, unsigned int hash,
+                      unsigned int* slot) {
+    unsigned int mask = (unsigned int)ht->size - 1;
+    unsigned int pos = hash & mask;
+    unsigned char fragment = hash_fragment(hash);
+
+    for (int step = 0; step <= ht->size / HASH_GROUP_WIDTH; step++) {
+        unsigned int match, empty;
+        hash_group_match(ht->ctrl + pos, fragment, &match, &empty);
+
+        //A sequência de sondagem termina no primeiro slot vazio
+        if (empty) match &= (empty & (0u - empty)) - 1;
+
+        while (match) {
+            unsigned int index = (pos + hash_lowest_bit(match)) & mask;
+            const HashEntry* entry = &ht->table[index];
+            STATS_ADD(hash_key_compares, 1);
+            if (entry->hash == hash && entry->key_len == key_len &&
+                memcmp(entry->key, key, key_len) == 0) {
+                STATS_ADD(hash_probe_groups, step + 1);
+                *slot = index;
+                return 1;
+            }
+            match &= match - 1;
+        }
+
+        if (empty) {
+            STATS_ADD(hash_probe_groups, step + 1);
+            *slot = (pos + hash_lowest_bit(empty)) & mask;
+            return 0;
+        }
+        pos = (pos + HASH_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+//Redimensiona a tabela hash (dobra a capacidade, mantendo potência de dois)
 int hash_resize(HashTable* ht) {
     int old_size = ht->size;
     HashEntry* old_table = ht->table;
-    int new_size = old_size * 2 + 1;
+    unsigned char* old_ctrl = ht->ctrl;
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
     
     //Criar nova tabela e inicializar todas as entradas
-    HashEntry* new_table = (HashEntry*)calloc(new_size, sizeof(HashEntry));
-    if (new_table == NULL) return 0;
-    
-    for (int i = 0; i < new_size; i++) {
-        new_table[i].word = NULL;
-        new_table[i].occurrences = NULL;
-        new_table[i].num_occurrences = 0;
-        new_table[i].max_occurrences = 0;
+    if (!hash_alloc_slots(ht, old_size * 2)) {
+        ht->table = old_table;
+        ht->ctrl = old_ctrl;
+        ht->size = old_size;
+        return 0;
     }
     
-    //Reinsere as entradas antigas uma por uma
+    //Reinsere as entradas antigas uma por uma, a partir do hash guardado.
+    //A nova tabela tem mais slots livres que entradas, então sempre há posição
     for (int i = 0; i < old_size; i++) {
         if (old_table[i].word != NULL) {
-            unsigned int index = hash_function(old_table[i].word, new_size);
-            unsigned int initial_index = index;
-            
-            //Encontra nova posição usando sondagem linear
-            while (new_table[index].word != NULL) {
-                index = (index + 1) % new_size;
-                if (index == initial_index) {
-                    //Falha na realocação, restaura estado original
-                    for (int j = 0; j < new_size; j++) {
-                        if (new_table[j].word != NULL) {
-                            free(new_table[j].word);
-                            free(new_table[j].occurrences);
-                        }
-                    }
-                    free(new_table);
-                    return 0;
-                }
-            }
+            unsigned int index;
+            hash_probe(ht, old_table[i].key, old_table[i].key_len, old_table[i].hash, &index);
             
             //Copia a entrada para a nova posição
-            new_table[index].word = old_table[i].word;
-            new_table[index].occurrences = old_table[i].occurrences;
-            new_table[index].num_occurrences = old_table[i].num_occurrences;
-            new_table[index].max_occurrences = old_table[i].max_occurrences;
+            ht->table[index] = old_table[i];
+            hash_set_ctrl(ht, index, hash_fragment(old_table[i].hash));
         }
     }
     
-    //Atualiza a tabela hash
-    free(old_table);  //Libera apenas a tabela, não os dados
-    ht->table = new_table;
-    ht->size = new_size;
+    //Libera apenas a tabela antiga, não os dados
+    free(old_table);
+    free(old_ctrl);
+
+    //Contabiliza o redimensionamento (hash_stats)
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    ht->resizes++;
+    ht->resize_ns += (unsigned long long)((fim.tv_sec - inicio.tv_sec) * 1000000000LL +
+                                          (fim.tv_nsec - inicio.tv_nsec));
+    STATS_ADD(hash_resizes, 1);
     
     return 1;
 }
 
-//Insere uma palavra na tabela hash 
-void hash_insert(HashTable* ht, const char* word, int position) {
-    if (!ht || !word) return;
-    
+//Descompacta as ocorrências de uma entrada para permitir novas inserções
+static int hash_entry_unpack(HashEntry* entry) {
+    int capacity = entry->num_occurrences > 10 ? entry->num_occurrences : 10;
+    int* raw = (int*)malloc(capacity * sizeof(int));
+    if (raw == NULL) {
+        fprintf(stderr, "Erro de alocação de memória para ocorrências\n");
+        return 0;
+    }
+    postings_unpack(entry->packed_occurrences, entry->num_occurrences, raw);
+
+    free(entry->packed_occurrences);
+    entry->packed_occurrences = NULL;
+    entry->packed_size = 0;
+    entry->occurrences = raw;
+    entry->max_occurrences = capacity;
+    return 1;
+}
+
+//Localiza a entrada da palavra, criando-a se necessário. O ponteiro devolvido
+//vale até a próxima inserção (que pode redimensionar a tabela)
+static HashEntry* hash_entry_get(HashTable* ht, const char* word) {
     //Redimensiona se necessário
     if (ht->entries > ht->size * 0.7) {
         if (!hash_resize(ht)) {
             fprintf(stderr, "Falha ao redimensionar a tabela hash\n");
-            return;
+            return NULL;
         }
     }
 
-    unsigned int index = hash_function(word, ht->size);
-    unsigned int initial_index = index;
+    char key[MAX_WORD_SIZE];
+    int key_len = normalize_key(word, key, MAX_WORD_SIZE);
+    unsigned int hash = hash_key(key, key_len);
+    unsigned int index;
+    STATS_ADD(hash_inserts, 1);
 
     //Busca posição usando sondagem linear
-    while (ht->table[index].word != NULL && strcasecmp(ht->table[index].word, word) != 0) {
-        index = (index + 1) % ht->size;
-        if (index == initial_index) {
-            fprintf(stderr, "Tabela hash cheia!\n");
-            return;
-        }
+    if (hash_probe(ht, key, key_len, hash, &index) < 0) {
+        fprintf(stderr, "Tabela hash cheia!\n");
+        return NULL;
     }
 
     //Nova entrada
     if (ht->table[index].word == NULL) {
-        ht->table[index].word = strdup(word);
-        if (ht->table[index].word == NULL) {
+        //Chave normalizada e palavra original ficam em um único bloco
+        size_t word_len = strlen(word);
+        char* block = (char*)malloc(key_len + 1 + word_len + 1);
+        if (block == NULL) {
             fprintf(stderr, "Erro de alocação de memória para palavra\n");
-            return;
+            return NULL;
         }
+        memcpy(block, key, key_len + 1);
+        memcpy(block + key_len + 1, word, word_len + 1);
+        ht->table[index].key = block;
+        ht->table[index].key_len = key_len;
+        ht->table[index].word = block + key_len + 1;
+        ht->table[index].hash = hash;
+        hash_set_ctrl(ht, index, hash_fragment(hash));
 
         ht->table[index].max_occurrences = 10;
         ht->table[index].occurrences = (int*)malloc(10 * sizeof(int));
         if (ht->table[index].occurrences == NULL) {
             fprintf(stderr, "Erro de alocação de memória para ocorrências\n");
-            free(ht->table[index].word);
+            free(ht->table[index].key);
+            ht->table[index].key = NULL;
             ht->table[index].word = NULL;
-            return;
+            return NULL;
         }
         ht->entries++;
     }
 
-    //Verifica se posição já existe (duplicata)
-    for (int i = 0; i < ht->table[index].num_occurrences; i++) {
-        if (ht->table[index].occurrences[i] == position) {
-            return;  //Não insere duplicatas
+    //Entrada compactada volta ao formato bruto antes de receber posições
+    if (ht->table[index].packed_occurrences != NULL && !hash_entry_unpack(&ht->table[index])) {
+        return NULL;
+    }
+
+    return &ht->table[index];
+}
+
+//Acrescenta uma posição às ocorrências de uma entrada
+static void hash_entry_add(HashTable* ht, HashEntry* entry, int position) {
+    int n = entry->num_occurrences;
+
+    //Posição repetida no fim da lista (caso comum ao reinserir em ordem)
+    if (n > 0 && entry->occurrences[n - 1] == position) return;
+
+    //Modo em lote: fora de ordem apenas marca a entrada para hash_finalize
+    int slot = n;
+    if (n > 0 && entry->occurrences[n - 1] > position) {
+        if (ht->bulk) {
+            entry->unsorted = 1;
+        } else {
+            //Busca binária pela posição de inserção, rejeitando duplicatas
+            int left = 0, right = n - 1;
+            while (left <= right) {
+                int mid = left + (right - left) / 2;
+                if (entry->occurrences[mid] == position) return;  //Não insere duplicatas
+                if (entry->occurrences[mid] < position) left = mid + 1;
+                else right = mid - 1;
+            }
+            slot = left;
         }
     }
 
     //Expande array se necessário
-    if (ht->table[index].num_occurrences >= ht->table[index].max_occurrences) {
-        int new_size = ht->table[index].max_occurrences * 2;
-        int* new_arr = (int*)realloc(ht->table[index].occurrences, new_size * sizeof(int));
+    if (n >= entry->max_occurrences) {
+        int new_size = entry->max_occurrences * 2;
+        int* new_arr = (int*)realloc(entry->occurrences, new_size * sizeof(int));
         if (new_arr == NULL) {
             fprintf(stderr, "Erro ao realocar memória para ocorrências\n");
             return;
         }
-        ht->table[index].occurrences = new_arr;
-        ht->table[index].max_occurrences = new_size;
+        entry->occurrences = new_arr;
+        entry->max_occurrences = new_size;
     }
 
-    //Insere mantendo ordem
-    int i = ht->table[index].num_occurrences;
-    while (i > 0 && ht->table[index].occurrences[i-1] > position) {
-        ht->table[index].occurrences[i] = ht->table[index].occurrences[i-1];
-        i--;
+    //Insere mantendo ordem (no modo em lote, sempre no final)
+    memmove(&entry->occurrences[slot + 1], &entry->occurrences[slot], (n - slot) * sizeof(int));
+    entry->occurrences[slot] = position;
+    entry->num_occurrences++;
+}
+
+//Insere uma palavra na tabela hash 
+void hash_insert(HashTable* ht, const char* word, int position) {
+    if (!ht || !word) return;
+
+    HashEntry* entry = hash_entry_get(ht, word);
+    if (entry != NULL) hash_entry_add(ht, entry, position);
+}
+
+//Insere uma palavra com várias posições, localizando a entrada uma única vez
+void hash_insert_positions(HashTable* ht, const char* word, const int* positions, int count) {
+    if (!ht || !word || !positions || count <= 0) return;
+
+    HashEntry* entry = hash_entry_get(ht, word);
+    if (entry == NULL) return;
+
+    //Reserva espaço para todas as posições de uma vez
+    int needed = entry->num_occurrences + count;
+    if (needed > entry->max_occurrences) {
+        int* new_arr = (int*)realloc(entry->occurrences, needed * sizeof(int));
+        if (new_arr == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para ocorrências\n");
+            return;
+        }
+        entry->occurrences = new_arr;
+        entry->max_occurrences = needed;
+    }
+
+    for (int i = 0; i < count; i++) {
+        hash_entry_add(ht, entry, positions[i]);
+    }
+}
+
+//Ativa o modo de inserção em lote
+void hash_begin_bulk(HashTable* ht) {
+    if (ht) ht->bulk = 1;
+}
+
+static int compare_positions(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+//Ordena e remove duplicatas das entradas inseridas fora de ordem e encerra o modo em lote
+void hash_finalize(HashTable* ht) {
+    if (ht == NULL) return;
+
+    for (int i = 0; i < ht->size; i++) {
+        HashEntry* entry = &ht->table[i];
+        if (entry->word == NULL || !entry->unsorted) continue;
+
+        qsort(entry->occurrences, entry->num_occurrences, sizeof(int), compare_positions);
+        int n = 0;
+        for (int j = 0; j < entry->num_occurrences; j++) {
+            if (n == 0 || entry->occurrences[n - 1] != entry->occurrences[j]) {
+                entry->occurrences[n++] = entry->occurrences[j];
+            }
+        }
+        entry->num_occurrences = n;
+        entry->unsorted = 0;
     }
-    ht->table[index].occurrences[i] = position;
-    ht->table[index].num_occurrences++;
+    ht->bulk = 0;
 }
 
 //Busca uma palavra na tabela hash
@@ -224,24 +500,133 @@ int* hash_search(HashTable* ht, const char* word, int* num_occurrences) {
         return NULL;
     }
 
-    unsigned int index = hash_function(word, ht->size);
-    unsigned int initial_index = index;
-
-    while (ht->table[index].word != NULL) {
-        if (strcasecmp(ht->table[index].word, word) == 0) {
-            *num_occurrences = ht->table[index].num_occurrences;
-            return ht->table[index].occurrences;
-        }
-        index = (index + 1) % ht->size;
-        if (index == initial_index) break;
+    char key[MAX_WORD_SIZE];
+    int key_len = normalize_key(word, key, MAX_WORD_SIZE);
+    unsigned int index;
+    STATS_ADD(hash_searches, 1);
+    if (hash_probe(ht, key, key_len, hash_key(key, key_len), &index) == 1) {
+        STATS_ADD(hash_hits, 1);
+        *num_occurrences = ht->table[index].num_occurrences;
+        return ht->table[index].occurrences;
     }
 
     *num_occurrences = 0;
     return NULL;
 }
 
+//Inicializa um cursor sobre as ocorrências de uma entrada
+static void hash_entry_cursor(const HashEntry* entry, PostingCursor* cursor) {
+    posting_cursor_init(cursor, entry->occurrences, entry->packed_occurrences, entry->num_occurrences);
+}
+
+//Busca uma palavra e retorna um cursor sobre suas ocorrências
+int hash_search_cursor(HashTable* ht, const char* word, PostingCursor* cursor) {
+    if (!cursor) return 0;
+    posting_cursor_init(cursor, NULL, NULL, 0);
+    if (!ht || !word) return 0;
+
+    char key[MAX_WORD_SIZE];
+    int key_len = normalize_key(word, key, MAX_WORD_SIZE);
+    unsigned int index;
+    STATS_ADD(hash_searches, 1);
+    if (hash_probe(ht, key, key_len, hash_key(key, key_len), &index) == 1) {
+        STATS_ADD(hash_hits, 1);
+        hash_entry_cursor(&ht->table[index], cursor);
+        return 1;
+    }
+
+    return 0;
+}
+
+//Busca um lote de palavras. Para cada grupo, primeiro calcula as chaves e os
+//hashes e pré-carrega o grupo de controle e o slot inicial de cada palavra; só
+//depois resolve as sondagens, de modo que as faltas de cache do grupo se sobrepõem.
+//Com filtro, as palavras que ele rejeita nem são pré-carregadas
+int hash_search_batch_filtered(HashTable* ht, const BloomFilter* filtro, const char* const words[], int n,
+                               int* results[], int counts[]) {
+    if (!results || n <= 0) return 0;
+
+    int found = 0, rejected = 0;
+    for (int base = 0; base < n; base += HASH_BATCH_SIZE) {
+        int m = n - base < HASH_BATCH_SIZE ? n - base : HASH_BATCH_SIZE;
+        char keys[HASH_BATCH_SIZE][MAX_WORD_SIZE];
+        int key_lens[HASH_BATCH_SIZE];
+        unsigned int hashes[HASH_BATCH_SIZE];
+
+        //Fase 1: hashes e pré-carregamento
+        for (int j = 0; j < m; j++) {
+            const char* word = words[base + j];
+            key_lens[j] = -1;
+            if (!ht || !word) continue;
+
+            int key_len = normalize_key(word, keys[j], MAX_WORD_SIZE);
+            hashes[j] = hash_key(keys[j], key_len);
+            if (filtro && !bloom_may_contain(filtro, hashes[j])) {
+                rejected++;  //Certamente ausente: nenhuma sondagem
+                continue;
+            }
+            key_lens[j] = key_len;
+            unsigned int pos = hashes[j] & ((unsigned int)ht->size - 1);
+            HASH_PREFETCH(ht->ctrl + pos);
+            HASH_PREFETCH(&ht->table[pos]);
+        }
+
+        //Fase 2: sondagens (as linhas já estão a caminho do cache)
+        for (int j = 0; j < m; j++) {
+            unsigned int index;
+            results[base + j] = NULL;
+            if (counts) counts[base + j] = 0;
+            if (key_lens[j] < 0 || hash_probe(ht, keys[j], key_lens[j], hashes[j], &index) != 1) continue;
+
+            results[base + j] = ht->table[index].occurrences;
+            if (counts) counts[base + j] = ht->table[index].num_occurrences;
+            found++;
+        }
+    }
+    STATS_ADD(hash_searches, n);
+    STATS_ADD(hash_hits, found);
+    STATS_ADD(hash_filter_rejects, rejected);
+    return found;
+}
+
+int hash_search_batch(HashTable* ht, const char* const words[], int n, int* results[], int counts[]) {
+    return hash_search_batch_filtered(ht, NULL, words, n, results, counts);
+}
+
+//Filtro de Bloom com os hashes guardados nas entradas (os mesmos de hash_full)
+BloomFilter* hash_bloom_filter(const HashTable* ht) {
+    if (ht == NULL) return NULL;
+    BloomFilter* filtro = bloom_create(ht->entries);
+    if (filtro == NULL) return NULL;
+    for (int i = 0; i < ht->size; i++) {
+        if (ht->table[i].word != NULL) bloom_add(filtro, ht->table[i].hash);
+    }
+    return filtro;
+}
+
+//Compacta as ocorrências de todas as entradas da tabela
+void hash_compact(HashTable* ht) {
+    if (ht == NULL) return;
+    hash_finalize(ht);  //A compactação exige listas ordenadas
+
+    for (int i = 0; i < ht->size; i++) {
+        HashEntry* entry = &ht->table[i];
+        if (entry->word == NULL || entry->occurrences == NULL) continue;
+
+        unsigned char* packed;
+        int size = postings_pack(entry->occurrences, entry->num_occurrences, &packed);
+        if (size < 0) continue;  //Mantém o formato bruto em caso de falha
+
+        free(entry->occurrences);
+        entry->occurrences = NULL;
+        entry->max_occurrences = 0;
+        entry->packed_occurrences = packed;
+        entry->packed_size = size;
+    }
+}
+
 //Cria o índice remissivo usando hash de forma otimizada
-int criar_indice_hash(HashTable** ht, char* palavras[], int* posicoes[], int num_palavras, 
+int criar_indice_hash(HashTable** ht, char* const palavras[], int* const posicoes[], int num_palavras, 
                      char keywords[][MAX_WORD_SIZE], int num_keywords) {
     if (*ht != NULL) hash_destroy(*ht);
     
@@ -257,76 +642,235 @@ int criar_indice_hash(HashTable** ht, char* palavras[], int* posicoes[], int num
             hash_insert(keyword_ht, keywords[i], -1);
         }
     }
+    //Filtro das palavras-chave: a maioria dos tokens não é palavra-chave e é
+    //descartada lendo um bloco de 64 bytes, sem sondar keyword_ht
+    BloomFilter* filtro = hash_bloom_filter(keyword_ht);
     
-    //Processa palavras
-    for (int i = 0; i < num_palavras; i++) {
-        if (palavras[i] && palavras[i][0] != '\0') {  //Verifica se a palavra é válida
+    //Processa palavras. posicoes[i] já contém todas as posições da palavra, em ordem,
+    //então cada palavra é inserida uma única vez e as posições são apenas acrescentadas.
+    //As palavras-chave são procuradas em lotes, com pré-carregamento dos slots
+    hash_begin_bulk(*ht);
+    int* chaves[HASH_BATCH_SIZE];
+    for (int inicio = 0; inicio < num_palavras; inicio += HASH_BATCH_SIZE) {
+        int m = num_palavras - inicio < HASH_BATCH_SIZE ? num_palavras - inicio : HASH_BATCH_SIZE;
+        hash_search_batch_filtered(keyword_ht, filtro, (const char* const*)palavras + inicio, m, chaves, NULL);
+
+        for (int j = 0; j < m; j++) {
+            int i = inicio + j;
+            if (chaves[j] == NULL || palavras[i][0] == '\0') continue;  //Não é palavra-chave
+
             int dummy;
-            if (hash_search(keyword_ht, palavras[i], &dummy) != NULL) {
-                for (int j = 1; j <= posicoes[i][0]; j++) {
-                    hash_insert(*ht, palavras[i], posicoes[i][j]);
-                }
+            if (hash_search(*ht, palavras[i], &dummy) == NULL) {
+                hash_insert_positions(*ht, palavras[i], posicoes[i] + 1, posicoes[i][0]);
             }
         }
     }
+    hash_finalize(*ht);
     
+    bloom_destroy(filtro);
     hash_destroy(keyword_ht);
     return 1;
 }
 
+//Trabalho de uma thread na criação paralela: um intervalo de tokens e uma tabela própria
+typedef struct {
+    HashTable* shard;
+    HashTable* keyword_ht;
+    const BloomFilter* filtro;
+    char* const* palavras;
+    int inicio;
+    int fim;
+} HashWorker;
+
+//Preenche a tabela da thread com as posições das palavras-chave do seu intervalo.
+//Os tokens são percorridos em ordem, então as listas saem ordenadas
+static void* hash_worker_run(void* arg) {
+    HashWorker* w = (HashWorker*)arg;
+    int* chaves[HASH_BATCH_SIZE];
+    hash_begin_bulk(w->shard);
+    for (int inicio = w->inicio; inicio < w->fim; inicio += HASH_BATCH_SIZE) {
+        int m = w->fim - inicio < HASH_BATCH_SIZE ? w->fim - inicio : HASH_BATCH_SIZE;
+        hash_search_batch_filtered(w->keyword_ht, w->filtro, (const char* const*)w->palavras + inicio, m, chaves, NULL);
+
+        for (int j = 0; j < m; j++) {
+            if (chaves[j] != NULL && w->palavras[inicio + j][0] != '\0') {
+                hash_insert(w->shard, w->palavras[inicio + j], inicio + j);
+            }
+        }
+    }
+    hash_finalize(w->shard);
+    return NULL;
+}
+
+//Cria o índice remissivo com várias threads. Os tokens são divididos em
+//num_threads intervalos; cada thread preenche sua própria tabela e, no final,
+//as listas de cada palavra (já ordenadas) são combinadas com um k-way merge
+int criar_indice_hash_paralelo(HashTable** ht, char* const palavras[], int* const posicoes[],
+                               int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords,
+                               int num_threads) {
+    if (num_threads > num_palavras) num_threads = num_palavras;
+    if (num_threads > HASH_MAX_THREADS) num_threads = HASH_MAX_THREADS;
+    if (num_threads <= 1) {
+        return criar_indice_hash(ht, palavras, posicoes, num_palavras, keywords, num_keywords);
+    }
+
+    if (*ht != NULL) hash_destroy(*ht);
+    int initial_size = num_keywords * 2;
+    if (initial_size < INITIAL_HASH_SIZE) initial_size = INITIAL_HASH_SIZE;
+    *ht = hash_create(initial_size);
+
+    //Tabela de palavras-chave e seu filtro, somente lidos pelas threads
+    HashTable* keyword_ht = hash_create(num_keywords * 2);
+    for (int i = 0; i < num_keywords; i++) {
+        if (keywords[i][0] != '\0') hash_insert(keyword_ht, keywords[i], -1);
+    }
+    BloomFilter* filtro = hash_bloom_filter(keyword_ht);
+
+    HashWorker workers[HASH_MAX_THREADS];
+    pthread_t threads[HASH_MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shard = hash_create(initial_size);
+        workers[t].keyword_ht = keyword_ht;
+        workers[t].filtro = filtro;
+        workers[t].palavras = palavras;
+        workers[t].inicio = (int)((long long)num_palavras * t / num_threads);
+        workers[t].fim = (int)((long long)num_palavras * (t + 1) / num_threads);
+    }
+    for (; started < num_threads; started++) {
+        if (pthread_create(&threads[started], NULL, hash_worker_run, &workers[started]) != 0) break;
+    }
+    //Intervalos cujas threads não puderam ser criadas são processados aqui
+    for (int t = started; t < num_threads; t++) hash_worker_run(&workers[t]);
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+
+    //Merge: cada palavra é combinada uma vez, na primeira tabela em que aparece
+    const int* lists[HASH_MAX_THREADS];
+    int counts[HASH_MAX_THREADS];
+    int ok = 1;
+    hash_begin_bulk(*ht);
+    for (int t = 0; t < num_threads && ok; t++) {
+        HashTable* shard = workers[t].shard;
+        for (int i = 0; i < shard->size && ok; i++) {
+            const char* word = shard->table[i].word;
+            int dummy;
+            if (word == NULL || hash_search(*ht, word, &dummy) != NULL) continue;
+
+            int total = 0;
+            for (int u = 0; u < num_threads; u++) {
+                lists[u] = hash_search(workers[u].shard, word, &counts[u]);
+                total += counts[u];
+            }
+            int* merged = (int*)malloc(total * sizeof(int));
+            if (merged == NULL) {
+                fprintf(stderr, "Erro de alocação de memória para ocorrências\n");
+                ok = 0;
+                break;
+            }
+            int n = postings_merge(lists, counts, num_threads, merged);
+            hash_insert_positions(*ht, word, merged, n);
+            free(merged);
+        }
+    }
+    hash_finalize(*ht);
+
+    for (int t = 0; t < num_threads; t++) hash_destroy(workers[t].shard);
+    bloom_destroy(filtro);
+    hash_destroy(keyword_ht);
+    return ok;
+}
+
+//Acrescenta a um índice existente as ocorrências de uma parte do texto. As
+//palavras são as distintas da parte, cada uma com sua lista inteira, então cada
+//palavra-chave é procurada uma única vez. As posições são deslocadas por base;
+//listas que chegam fora de ordem (outra grafia da mesma chave) são ordenadas
+//por hash_finalize
+int hash_append_indice(HashTable* ht, char* const palavras[], int* const posicoes[], int num_palavras,
+                       int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira) {
+    if (ht == NULL || num_palavras < 0 || primeira < 0) return 0;
+    if (primeira >= num_keywords || num_palavras == 0) return 1;
+
+    //Palavras-chave novas, sem as chaves que já estão entre as anteriores
+    HashTable* anteriores = hash_create(primeira * 2);
+    for (int i = 0; i < primeira; i++) {
+        if (keywords[i][0] != '\0') hash_insert(anteriores, keywords[i], -1);
+    }
+    HashTable* keyword_ht = hash_create((num_keywords - primeira) * 2);
+    for (int i = primeira; i < num_keywords; i++) {
+        int dummy;
+        if (keywords[i][0] != '\0' && hash_search(anteriores, keywords[i], &dummy) == NULL) {
+            hash_insert(keyword_ht, keywords[i], -1);
+        }
+    }
+    hash_destroy(anteriores);
+    BloomFilter* filtro = hash_bloom_filter(keyword_ht);
+
+    int* deslocadas = NULL;
+    int capacidade = 0, ok = 1;
+    int* chaves[HASH_BATCH_SIZE];
+    hash_begin_bulk(ht);
+    for (int inicio = 0; inicio < num_palavras && ok; inicio += HASH_BATCH_SIZE) {
+        int m = num_palavras - inicio < HASH_BATCH_SIZE ? num_palavras - inicio : HASH_BATCH_SIZE;
+        hash_search_batch_filtered(keyword_ht, filtro, (const char* const*)palavras + inicio, m, chaves, NULL);
+
+        for (int j = 0; j < m; j++) {
+            int i = inicio + j;
+            if (chaves[j] == NULL || palavras[i][0] == '\0') continue;  //Não é palavra-chave
+
+            int count = posicoes[i][0];
+            const int* lista = posicoes[i] + 1;
+            if (base != 0) {
+                if (count > capacidade) {
+                    int* novo = (int*)realloc(deslocadas, count * sizeof(int));
+                    if (novo == NULL) {
+                        fprintf(stderr, "Erro de alocação de memória para ocorrências\n");
+                        ok = 0;
+                        break;
+                    }
+                    deslocadas = novo;
+                    capacidade = count;
+                }
+                for (int k = 0; k < count; k++) deslocadas[k] = lista[k] + base;
+                lista = deslocadas;
+            }
+            hash_insert_positions(ht, palavras[i], lista, count);
+        }
+    }
+    hash_finalize(ht);
+
+    free(deslocadas);
+    bloom_destroy(filtro);
+    hash_destroy(keyword_ht);
+    return ok;
+}
+
 //Estrutura auxiliar para ordenação
 typedef struct {
     char* word;
-    int* positions;
+    const HashEntry* entry;
     int count;
 } WordEntry;
 
-//Função de comparação para qsort
+//Função de comparação para qsort (ordem das chaves normalizadas)
 static int compare_entries(const void* a, const void* b) {
-    return strcasecmp(((WordEntry*)a)->word, ((WordEntry*)b)->word);
+    return strcmp(((WordEntry*)a)->entry->key, ((WordEntry*)b)->entry->key);
 }
 
-//Imprime o índice em ordem alfabética
-void imprimir_indice_hash(HashTable* ht) {
-    if (ht == NULL) {
-        printf("Índice hash não criado.\n");
-        return;
-    }
-
-    //Obtém as palavras-chave que foram utilizadas para criar o índice
-    char (*keywords)[MAX_WORD_SIZE] = get_keywords_hash();
-    int num_keywords = get_num_keywords_hash();
-    
-    //Marca as palavras-chave que forem encontradas
-    int* found_keywords = (int*)calloc(num_keywords, sizeof(int));
-    if (!found_keywords) {
-        printf("Erro ao alocar memória para verificação de palavras-chave.\n");
-        return;
-    }
+//Escreve o índice em ordem alfabética, seguido das palavras-chave ausentes
+int hash_write_index(HashTable* ht, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out) {
+    if (ht == NULL || out == NULL) return 0;
 
     //Aloca array de entradas
     WordEntry* entries = (WordEntry*)malloc(ht->entries * sizeof(WordEntry));
-    if (!entries) {
-        free(found_keywords);
-        return;
-    }
+    if (!entries) return 0;
     
     //Coleta entradas não nulas
     int idx = 0;
     for (int i = 0; i < ht->size; i++) {
         if (ht->table[i].word != NULL) {
             entries[idx].word = ht->table[i].word;
-            entries[idx].positions = ht->table[i].occurrences;
+            entries[idx].entry = &ht->table[i];
             entries[idx].count = ht->table[i].num_occurrences;
-            
-            //Marca a palavra-chave como encontrada
-            for (int j = 0; j < num_keywords; j++) {
-                if (strcasecmp(keywords[j], entries[idx].word) == 0) {
-                    found_keywords[j] = 1;
-                    break;
-                }
-            }
-            
             idx++;
         }
     }
@@ -334,26 +878,40 @@ void imprimir_indice_hash(HashTable* ht) {
     //Ordena usando qsort
     qsort(entries, ht->entries, sizeof(WordEntry), compare_entries);
 
-    //Imprime resultado
-    printf("\n=== Índice Hash ===\n");
+    output_index_begin(out, "Hash");
     for (int i = 0; i < idx; i++) {
-        printf("%s: ", entries[i].word);
-        for (int j = 0; j < entries[i].count; j++) {
-            printf("%d", entries[i].positions[j]);
-            if (j < entries[i].count - 1) printf(", ");
-        }
-        printf("\n");
+        output_word_begin(out, entries[i].word);
+        PostingCursor cur;
+        hash_entry_cursor(entries[i].entry, &cur);
+        int position;
+        while (posting_cursor_next(&cur, &position)) output_position(out, position);
+        output_word_end(out);
     }
     
-    //Imprime as palavras-chave que não foram encontradas
+    //Palavras-chave ausentes: uma busca na própria tabela por palavra-chave
     for (int i = 0; i < num_keywords; i++) {
-        if (!found_keywords[i] && keywords[i][0] != '\0') {
-            printf("%s: Não foi encontrada no texto.\n", keywords[i]);
+        PostingCursor cur;
+        if (keywords[i][0] != '\0' && !hash_search_cursor(ht, keywords[i], &cur)) {
+            output_missing(out, keywords[i]);
         }
     }
+    output_index_end(out);
 
     free(entries);
-    free(found_keywords);
+    return !out->error;
+}
+
+//Imprime o índice em ordem alfabética
+void imprimir_indice_hash(HashTable* ht) {
+    if (ht == NULL) {
+        printf("Índice hash não criado.\n");
+        return;
+    }
+
+    OutputWriter out;
+    if (!output_open(&out, STDOUT_FILENO, OUTPUT_PLAIN)) return;
+    hash_write_index(ht, get_keywords_hash(), get_num_keywords_hash(), &out);
+    output_close(&out);
 }
 
 //Função para visualizar a estrutura da tabela hash em formato de árvore
@@ -389,7 +947,7 @@ void imprimir_estrutura_hash(HashTable* ht) {
     //Calcular colisões
     for (int i = 0; i < ht->size; i++) {
         if (ht->table[i].word != NULL) {
-            unsigned int pos_ideal = hash_function(ht->table[i].word, ht->size);
+            unsigned int pos_ideal = ht->table[i].hash & (unsigned int)(ht->size - 1);
             int dist = ((unsigned int)i >= pos_ideal) ? (i - (int)pos_ideal) : (ht->size + i - (int)pos_ideal);
             colisoes[dist]++;
             if (dist > max_colisoes) max_colisoes = dist;
@@ -419,7 +977,7 @@ void imprimir_estrutura_hash(HashTable* ht) {
     int mostrados = 0;
     for (int i = 0; i < ht->size && mostrados < 20; i++) {
         if (ht->table[i].word != NULL) {
-            unsigned int pos_ideal = hash_function(ht->table[i].word, ht->size);
+            unsigned int pos_ideal = ht->table[i].hash & (unsigned int)(ht->size - 1);
             int deslocamento = ((unsigned int)i >= pos_ideal) ? (i - (int)pos_ideal) : (ht->size + i - (int)pos_ideal);
             
             printf("[%d] -> %s (hash ideal: %d, deslocamento: %d, ocorrências: %d)\n", 
@@ -454,7 +1012,7 @@ void imprimir_hash_arvore(HashTable* ht) {
     for (int i = 0; i < ht->size; i++) {
         if (ht->table[i].word != NULL) {
             entries[idx].word = ht->table[i].word;
-            entries[idx].positions = ht->table[i].occurrences;
+            entries[idx].entry = &ht->table[i];
             entries[idx].count = ht->table[i].num_occurrences;
             idx++;
         }
@@ -463,28 +1021,32 @@ void imprimir_hash_arvore(HashTable* ht) {
     //Ordena
     qsort(entries, idx, sizeof(WordEntry), compare_entries);
     
-    //Imprime em formato de árvore
+    //Imprime em formato de árvore, acumulando tudo na saída com buffer
+    OutputWriter out;
+    if (!output_open(&out, STDOUT_FILENO, OUTPUT_PLAIN)) {
+        free(entries);
+        return;
+    }
     for (int i = 0; i < idx; i++) {
-        if (i == idx - 1) {
-            printf("└── %s (%d ocorrências)\n", entries[i].word, entries[i].count);
-            for (int j = 0; j < entries[i].count; j++) {
-                if (j == entries[i].count - 1) {
-                    printf("    └── Posição: %d\n", entries[i].positions[j]);
-                } else {
-                    printf("    ├── Posição: %d\n", entries[i].positions[j]);
-                }
-            }
-        } else {
-            printf("├── %s (%d ocorrências)\n", entries[i].word, entries[i].count);
-            for (int j = 0; j < entries[i].count; j++) {
-                if (j == entries[i].count - 1) {
-                    printf("│   └── Posição: %d\n", entries[i].positions[j]);
-                } else {
-                    printf("│   ├── Posição: %d\n", entries[i].positions[j]);
-                }
-            }
+        const char* ramo = (i == idx - 1) ? "└── " : "├── ";
+        const char* recuo = (i == idx - 1) ? "    " : "│   ";
+        output_str(&out, ramo);
+        output_str(&out, entries[i].word);
+        output_write(&out, " (", 2);
+        output_int(&out, entries[i].count);
+        output_str(&out, " ocorrências)\n");
+
+        PostingCursor cur;
+        hash_entry_cursor(entries[i].entry, &cur);
+        int position;
+        for (int j = 0; posting_cursor_next(&cur, &position); j++) {
+            output_str(&out, recuo);
+            output_str(&out, j == entries[i].count - 1 ? "└── Posição: " : "├── Posição: ");
+            output_int(&out, position);
+            output_write(&out, "\n", 1);
         }
     }
+    output_close(&out);
     
     free(entries);
 }
@@ -495,11 +1057,13 @@ void hash_destroy(HashTable* ht) {
 
     for (int i = 0; i < ht->size; i++) {
         if (ht->table[i].word != NULL) {
-            free(ht->table[i].word);
+            free(ht->table[i].key);  //Bloco com a chave e a palavra original
             free(ht->table[i].occurrences);
+            free(ht->table[i].packed_occurrences);
         }
     }
 
     free(ht->table);
+    free(ht->ctrl);
     free(ht);
 }
\ No newline at end of file
@@ -8,32 +8,58 @@
  * @struct HashEntry
  * @brief Estrutura que representa uma entrada na tabela hash
  * @var HashEntry::word
- * String contendo a palavra armazenada
+ * String contendo a palavra armazenada (primeira forma encontrada no texto)
+ * @var HashEntry::key
+ * Chave normalizada (normalize_key); word fica no mesmo bloco, logo após a chave
+ * @var HashEntry::key_len
+ * Tamanho da chave normalizada em bytes
+ * @var HashEntry::hash
+ * Hash completo (32 bits) da palavra, reaproveitado nas sondagens e no redimensionamento
  * @var HashEntry::occurrences
  * Array com as posições onde a palavra ocorre
  * @var HashEntry::num_occurrences
  * Número atual de ocorrências armazenadas
  * @var HashEntry::max_occurrences
  * Capacidade máxima do array de ocorrências
+ * @var HashEntry::packed_occurrences
+ * Ocorrências no formato compactado (delta + varint), ou NULL
+ * @var HashEntry::packed_size
+ * Tamanho em bytes das ocorrências compactadas
+ * @var HashEntry::unsorted
+ * Indica ocorrências acrescentadas fora de ordem no modo em lote (pendentes de hash_finalize)
  *
  * @struct HashTable
  * @brief Estrutura principal da tabela hash
  * @var HashTable::table
  * Array de entradas HashEntry
+ * @var HashTable::ctrl
+ * Bytes de controle: fragmento de 7 bits do hash de cada slot ou HASH_CTRL_EMPTY
+ * (size + HASH_GROUP_WIDTH bytes; o primeiro grupo é espelhado no final)
  * @var HashTable::size
- * Tamanho total da tabela
+ * Tamanho total da tabela (sempre potência de dois)
  * @var HashTable::entries
  * Número atual de entradas ocupadas
+ * @var HashTable::bulk
+ * Modo de inserção em lote: hash_insert apenas acrescenta as posições
+ * @var HashTable::resizes
+ * Número de redimensionamentos desde hash_create
+ * @var HashTable::resize_ns
+ * Tempo total gasto nos redimensionamentos, em nanossegundos
  *
  * @fn HashTable* hash_create(int size)
  * @brief Cria uma nova tabela hash
- * @param size Tamanho inicial da tabela
+ * @param size Tamanho inicial da tabela (arredondado para a próxima potência de dois)
  * @return Ponteiro para a tabela hash criada
  *
+ * @fn unsigned int hash_full(const char* word)
+ * @brief Calcula o hash completo (FNV-1a, 32 bits) da chave normalizada de uma palavra
+ * @param word Palavra a ser calculada
+ * @return Hash de 32 bits
+ *
  * @fn unsigned int hash_function(const char* word, int size)
  * @brief Calcula o índice hash para uma palavra
  * @param word Palavra a ser calculada
- * @param size Tamanho da tabela
+ * @param size Tamanho da tabela (potência de dois)
  * @return Índice calculado
  *
  * @fn void hash_insert(HashTable* ht, const char* word, int position)
@@ -42,12 +68,56 @@
  * @param word Palavra a ser inserida
  * @param position Posição da palavra no texto
  *
+ * @fn void hash_insert_positions(HashTable* ht, const char* word, const int* positions, int count)
+ * @brief Insere uma palavra com várias posições (uma única busca pela entrada)
+ * @param ht Ponteiro para a tabela hash
+ * @param word Palavra a ser inserida
+ * @param positions Posições em ordem crescente
+ * @param count Número de posições
+ *
+ * @fn void hash_begin_bulk(HashTable* ht)
+ * @brief Ativa o modo em lote: posições são acrescentadas em O(1) amortizado, sem ordenar
+ * @param ht Ponteiro para a tabela hash
+ *
+ * @fn void hash_finalize(HashTable* ht)
+ * @brief Ordena e remove duplicatas das entradas pendentes e encerra o modo em lote
+ * @param ht Ponteiro para a tabela hash
+ * @note As ocorrências só devem ser lidas depois de hash_finalize
+ *
  * @fn int* hash_search(HashTable* ht, const char* word, int* num_occurrences)
  * @brief Busca uma palavra na tabela hash
  * @param ht Ponteiro para a tabela hash
  * @param word Palavra a ser buscada
  * @param num_occurrences Ponteiro para armazenar número de ocorrências
- * @return Array com as posições da palavra
+ * @return Array com as posições da palavra (NULL se a entrada estiver compactada)
+ *
+ * @fn int hash_search_cursor(HashTable* ht, const char* word, PostingCursor* cursor)
+ * @brief Busca uma palavra e inicializa um cursor sobre suas ocorrências
+ * @param ht Ponteiro para a tabela hash
+ * @param word Palavra a ser buscada
+ * @param cursor Cursor a ser inicializado (lê listas brutas ou compactadas)
+ * @return 1 se a palavra foi encontrada, 0 caso contrário
+ *
+ * @fn int hash_search_batch(HashTable* ht, const char* const words[], int n, int* results[], int counts[])
+ * @brief Busca um lote de palavras, pré-carregando os slots de cada grupo de
+ *        HASH_BATCH_SIZE palavras antes de resolver as sondagens
+ * @param results Recebe, para cada palavra, o mesmo ponteiro que hash_search retornaria
+ * @param counts Recebe o número de ocorrências de cada palavra (pode ser NULL)
+ * @return Número de palavras encontradas
+ *
+ * @fn int hash_search_batch_filtered(HashTable* ht, const BloomFilter* filtro, const char* const words[], int n, int* results[], int counts[])
+ * @brief Como hash_search_batch, mas as palavras rejeitadas pelo filtro (montado
+ *        com hash_bloom_filter da mesma tabela) recebem NULL sem sondar a tabela
+ * @param filtro Filtro das chaves da tabela (NULL = sem filtro)
+ * @return Número de palavras encontradas
+ *
+ * @fn BloomFilter* hash_bloom_filter(const HashTable* ht)
+ * @brief Cria um filtro de Bloom com os hashes de todas as chaves da tabela
+ * @return Filtro criado, ou NULL em falha de alocação (as buscas seguem sem filtro)
+ *
+ * @fn void hash_compact(HashTable* ht)
+ * @brief Converte as ocorrências de todas as entradas para o formato compactado
+ * @param ht Ponteiro para a tabela hash
  *
  * @fn void hash_destroy(HashTable* ht)
  * @brief Libera a memória alocada pela tabela hash
@@ -58,7 +128,7 @@
  * @param ht Ponteiro para a tabela hash
  * @return 1 se sucesso, 0 se falha
  *
- * @fn int criar_indice_hash(HashTable** ht, char* palavras[], int* posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords)
+ * @fn int criar_indice_hash(HashTable** ht, char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords)
  * @brief Cria um índice remissivo usando tabela hash
  * @param ht Ponteiro para ponteiro da tabela hash
  * @param palavras Array de palavras do texto
@@ -68,8 +138,28 @@
  * @param num_keywords Número de palavras-chave
  * @return 1 se sucesso, 0 se falha
  *
+ * @fn int criar_indice_hash_paralelo(HashTable** ht, char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords, int num_threads)
+ * @brief Cria o índice remissivo com num_threads threads (até HASH_MAX_THREADS)
+ * @param num_threads Número de threads; 1 ou menos usa criar_indice_hash
+ * @return 1 se sucesso, 0 se falha
+ *
+ * @fn int hash_append_indice(HashTable* ht, char* const palavras[], int* const posicoes[], int num_palavras, int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira)
+ * @brief Acrescenta ao índice as ocorrências de uma parte do texto, sem reconstruí-lo
+ * @param palavras Palavras distintas da parte (TokenCorpus::distintas)
+ * @param posicoes Lista de cada palavra distinta (TokenCorpus::listas), com posições locais à parte
+ * @param base Posição global do primeiro token da parte (somada a cada posição)
+ * @param primeira Só keywords[primeira..num_keywords) são indexadas; as anteriores já
+ *        estão no índice e as novas com a mesma chave de uma delas são ignoradas
+ * @return 1 se sucesso, 0 se falha
+ *
+ * @fn int hash_write_index(HashTable* ht, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out)
+ * @brief Escreve o índice em ordem alfabética e as palavras-chave ausentes em uma
+ *        saída com buffer (texto, CSV ou JSON)
+ * @return 1 se sucesso, 0 se ht ou out for NULL, em falha de alocação ou de escrita
+ *
  * @fn void imprimir_indice_hash(HashTable* ht)
- * @brief Imprime o índice remissivo da tabela hash
+ * @brief Imprime o índice remissivo da tabela hash (hash_write_index em texto, na
+ *        saída padrão, com as palavras-chave do último índice criado)
  * @param ht Ponteiro para a tabela hash
  *
  * @fn void imprimir_hash_arvore(HashTable* ht)
@@ -81,31 +171,64 @@
 #define HASH_H
 
 #include "indice_remissivo.h"
+#include "bloom.h"
+#include "output.h"
+
+#define HASH_GROUP_WIDTH 16   //Slots examinados por grupo na sondagem
+#define HASH_CTRL_EMPTY 0x80  //Byte de controle de slot vazio
+#define HASH_MAX_THREADS 64   //Limite de threads da criação paralela
+#define HASH_BATCH_SIZE 16    //Palavras por grupo em hash_search_batch
 
 //Definição da estrutura de entrada da tabela hash
 typedef struct {
     char* word;
+    char* key;
+    int key_len;
+    unsigned int hash;
     int* occurrences;
     int num_occurrences;
     int max_occurrences;
+    unsigned char* packed_occurrences;
+    int packed_size;
+    int unsorted;
 } HashEntry;
 
 //Definição da estrutura da tabela hash
 typedef struct {
     HashEntry* table;
+    unsigned char* ctrl;
     int size;
     int entries;
+    int bulk;
+    int resizes;
+    unsigned long long resize_ns;
 } HashTable;
 
 //Protótipos das funções da tabela hash
 HashTable* hash_create(int size);
+unsigned int hash_full(const char* word);
 unsigned int hash_function(const char* word, int size);
 void hash_insert(HashTable* ht, const char* word, int position);
+void hash_insert_positions(HashTable* ht, const char* word, const int* positions, int count);
+void hash_begin_bulk(HashTable* ht);
+void hash_finalize(HashTable* ht);
 int* hash_search(HashTable* ht, const char* word, int* num_occurrences);
+int hash_search_cursor(HashTable* ht, const char* word, PostingCursor* cursor);
+int hash_search_batch(HashTable* ht, const char* const words[], int n, int* results[], int counts[]);
+int hash_search_batch_filtered(HashTable* ht, const BloomFilter* filtro, const char* const words[], int n,
+                               int* results[], int counts[]);
+BloomFilter* hash_bloom_filter(const HashTable* ht);
+void hash_compact(HashTable* ht);
 void hash_destroy(HashTable* ht);
 int hash_resize(HashTable* ht);
-int criar_indice_hash(HashTable** ht, char* palavras[], int* posicoes[], int num_palavras, 
+int criar_indice_hash(HashTable** ht, char* const palavras[], int* const posicoes[], int num_palavras, 
                      char keywords[][MAX_WORD_SIZE], int num_keywords);
+int criar_indice_hash_paralelo(HashTable** ht, char* const palavras[], int* const posicoes[],
+                               int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords,
+                               int num_threads);
+int hash_append_indice(HashTable* ht, char* const palavras[], int* const posicoes[], int num_palavras,
+                       int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira);
+int hash_write_index(HashTable* ht, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out);
 void imprimir_indice_hash(HashTable* ht);
 void imprimir_hash_arvore(HashTable* ht);
 
@@ -12,11 +12,10 @@
  * @note Definições importantes:
  * - MAX_WORD_SIZE: Tamanho máximo para palavras (100 caracteres)
  * - INITIAL_HASH_SIZE: Tamanho inicial da tabela hash (1023 posições)
- * - MAX_TEXT_SIZE: Tamanho máximo do texto a ser processado (100000 caracteres)
  * - MAX_KEYWORDS: Número máximo de palavras-chave suportadas (1000 palavras)
  * 
  * @section funcionalidades Principais Funcionalidades
- * - Carregamento de arquivo de texto
+ * - Carregamento de arquivo de texto (sem limite de tamanho: mmap ou leitura em blocos)
  * - Carregamento de palavras-chave
  * - Processamento de texto para identificação de palavras-chave
  * - Gerenciamento de recursos para ambas estruturas (Hash e Trie)
@@ -25,6 +24,11 @@
  * - ESTRUTURA_HASH (1): Utiliza apenas tabela hash
  * - ESTRUTURA_TRIE (2): Utiliza apenas árvore trie
  * - ESTRUTURA_AMBAS (3): Utiliza ambas as estruturas
+ * - ESTRUTURA_RADIX (4): Utiliza a árvore radix (trie compactada por caminhos)
+ * - ESTRUTURA_AHO (8): Autômato de Aho-Corasick (varre o arquivo uma vez, sem tokens)
+ *
+ * Os valores podem ser combinados como máscara de bits (ESTRUTURA_AMBAS é
+ * ESTRUTURA_HASH | ESTRUTURA_TRIE).
  */
 #ifndef INDICE_REMISSIVO_H
 #define INDICE_REMISSIVO_H
@@ -34,48 +38,58 @@
 #include <string.h>
 #include <strings.h>
 #include <ctype.h>
+#include "postings.h"
+#include "corpus.h"
 
 /* Definições e constantes */
 #define MAX_WORD_SIZE 100
 #define INITIAL_HASH_SIZE 1023
-#define MAX_TEXT_SIZE 100000
 #define MAX_KEYWORDS 1000
 
 /* Tipos de estrutura de dados */
 typedef enum {
     ESTRUTURA_HASH = 1,
     ESTRUTURA_TRIE = 2,
-    ESTRUTURA_AMBAS = 3
+    ESTRUTURA_AMBAS = 3,
+    ESTRUTURA_RADIX = 4,
+    ESTRUTURA_AHO = 8
 } TipoEstrutura;
 
 /* Protótipos de funções para manipulação do sistema */
-int carregar_arquivo_texto(const char* filename, char* texto);
 int carregar_keywords(const char* filename, char keywords[][MAX_WORD_SIZE], int* num_keywords);
-void processar_texto(char* texto, char* palavras[], int* posicoes[], int* num_palavras);
+int ler_keywords_arquivo(const char* filename, char keywords[][MAX_WORD_SIZE], int primeira, int* conteudo);
+int processar_texto(const char* texto, size_t tamanho, TokenCorpus* corpus);
+int processar_arquivo(const char* filename, TokenCorpus* corpus);
+int percorrer_arquivo(const char* filename, int (*consumir)(void* ctx, const char* dados, size_t tamanho),
+                      void* ctx);
+const unsigned char* tabela_delimitadores(void);
 void limpar_recursos(void);
 void limpar_recursos_hash(void);
 void limpar_recursos_trie(void);
+void limpar_recursos_radix(void);
+void limpar_recursos_aho(void);
+void limpar_recursos_salvo(void);
 
 /* Funções de acesso específicas para hash e trie */
-char* get_texto_hash(void);
-char* get_texto_trie(void);
-void set_texto_hash(char* texto);
-void set_texto_trie(char* texto);
-char** get_palavras_hash(void);
-char** get_palavras_trie(void);
-int** get_posicoes_hash(void);
-int** get_posicoes_trie(void);
-int get_num_palavras_hash(void);
-int get_num_palavras_trie(void);
-void set_num_palavras_hash(int num);
-void set_num_palavras_trie(int num);
+/* Corpus emprestado por cada índice (set_* não adiciona referência; limpar_recursos_* a devolve) */
+void set_corpus_hash(TokenCorpus* corpus);
+void set_corpus_trie(TokenCorpus* corpus);
+void set_corpus_radix(TokenCorpus* corpus);
+TokenCorpus* get_corpus_hash(void);
+TokenCorpus* get_corpus_trie(void);
+TokenCorpus* get_corpus_radix(void);
 char (*get_keywords_hash(void))[MAX_WORD_SIZE];
 char (*get_keywords_trie(void))[MAX_WORD_SIZE];
+char (*get_keywords_radix(void))[MAX_WORD_SIZE];
 int get_num_keywords_hash(void);
 int get_num_keywords_trie(void);
-int get_num_keywords_hash(void);
-int get_num_keywords_trie(void);
+int get_num_keywords_radix(void);
 void set_num_keywords_hash(int num);
 void set_num_keywords_trie(int num);
+void set_num_keywords_radix(int num);
+
+/* Formato das ocorrências nos índices criados (0 = bruto, 1 = compactado) */
+void set_compactar_ocorrencias(int ativo);
+int get_compactar_ocorrencias(void);
 
 #endif /* INDICE_REMISSIVO_H */
\ No newline at end of file
@@ -11,10 +11,24 @@
  * - Imprimir índices remissivos
  * - Visualizar representação em árvore das estruturas
  * - Excluir índices
+ * - Salvar os índices Hash e Trie em arquivo e carregá-los depois (mmap), sem
+ *   reconstruí-los a partir do texto
+ * - Exibir estatísticas das estruturas Hash e Trie (sondagem, forma e memória)
+ * - Buscar na Trie por prefixo (autocompletar), curingas ou intervalo de palavras
+ * - Acrescentar novos trechos de texto e novas palavras-chave aos índices Hash e
+ *   Trie criados, sem reconstruí-los
+ * - Carregar vários documentos de uma vez (arquivos ou diretórios, processados em
+ *   paralelo) e obter as ocorrências separadas por documento
+ * - Criar e escrever os índices sem o menu, pela linha de comando (modo em lote,
+ *   batch.h), por exemplo:
+ *   indice_remissivo --text texto.txt --keywords chaves.txt --engine both --out csv
  * 
  * O programa utiliza duas estruturas de dados principais:
  * 1. Tabela Hash: Para busca rápida de palavras
  * 2. Árvore Trie: Para busca eficiente de prefixos
+ * 3. Árvore Radix: Trie compactada por caminhos (opção "radix")
+ * 4. Autômato de Aho-Corasick: busca as palavras-chave em uma única varredura do
+ *    arquivo, sem tokens em memória (opção "aho")
  * 
  * Recursos e Limitações:
  * - Suporte a caracteres UTF-8
@@ -29,12 +43,25 @@
  * - imprimir_indice_menu(): Exibe índices remissivos
  * - imprimir_representacao_arvore_menu(): Visualiza estrutura em árvore
  * - excluir_indice_menu(): Remove índices e libera memória
+ * - buscar_palavra_menu(): Busca uma palavra pela API de consulta (query.h)
+ * - salvar_indices_menu(): Grava os índices Hash e Trie congelados (store.h)
+ * - carregar_indices_menu(): Mapeia um arquivo de índices gravado
+ * - estatisticas_menu(): Exibe as estatísticas (stats.h) da Hash e da Trie criadas
+ * - buscar_padrao_menu(): Consulta por prefixo, curinga ou intervalo na Trie (match.h)
+ * - consulta_termos_menu(): Consulta com vários termos (and, or, frase, near)
+ * - carregar_documentos_menu(): Carrega vários documentos (arquivos ou diretórios)
  * 
  * Variáveis Globais:
- * - texto_comum: Armazena texto carregado
  * - keywords_comum: Lista de palavras-chave
- * - palavras_comum: Array de palavras processadas
- * - posicoes_comum: Array de posições das palavras
+ * - corpus_comum: Corpus de tokens do texto carregado, emprestado (sem cópia)
+ *   pelos índices criados; com trechos acrescentados, é a última parte da cadeia
+ *   (corpus.h), que mantém as anteriores
+ * - documentos: Coleção de documentos (docs.h) quando vários textos foram
+ *   carregados juntos; as posições são então mostradas por documento
+ * - consulta: Índice de consulta com a Hash e a Trie publicadas; toda estrutura
+ *   é retirada da consulta antes de ser destruída
+ * - indice salvo (get_indice_salvo): Hash e/ou Trie carregadas de arquivo; cada parte
+ *   vale até ser excluída ou substituída por um índice criado
  * 
  * @note Requer alocação dinâmica de memória
  */
@@ -42,28 +69,32 @@
 #include "indice_remissivo.h"
 #include "trie.h"
 #include "hash.h"
+#include "radix.h"
+#include "aho.h"
+#include "query.h"
+#include "store.h"
+#include "stats.h"
+#include "match.h"
+#include "docs.h"
+#include "batch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <locale.h>
 
 // Declarações de funções externas
-extern void set_texto_hash(char*);
-extern void set_texto_trie(char*);
-extern char* get_texto_hash(void);
-extern char* get_texto_trie(void);
 extern void set_trie_root(TrieNode*);
 extern TrieNode* get_trie_root(void);
+extern void set_radix_root(RadixNode*);
+extern RadixNode* get_radix_root(void);
+extern void set_aho_automaton(AhoAutomaton*);
+extern AhoAutomaton* get_aho_automaton(void);
 extern void set_hash_table(HashTable*);
 extern HashTable* get_hash_table(void);
-extern char** get_palavras_hash(void);
-extern char** get_palavras_trie(void);
-extern int** get_posicoes_hash(void);
-extern int** get_posicoes_trie(void);
-extern int get_num_palavras_hash(void);
-extern int get_num_palavras_trie(void);
-extern void set_num_palavras_hash(int);
-extern void set_num_palavras_trie(int);
+extern void set_indice_salvo(IndexStore*);
+extern IndexStore* get_indice_salvo(void);
+extern void set_corpus_hash(TokenCorpus*);
+extern void set_corpus_trie(TokenCorpus*);
 extern char (*get_keywords_hash(void))[MAX_WORD_SIZE];
 extern char (*get_keywords_trie(void))[MAX_WORD_SIZE];
 extern int get_num_keywords_hash(void);
@@ -83,28 +114,43 @@ static void imprimir_indice_menu(void);
 static void imprimir_representacao_arvore_menu(void);
 static void excluir_indice_menu(void);
 static void limpar_recursos_comuns(void);
+static int converter_estrutura(const char* opcao);
+static int ler_num_threads(void);
+static void ler_compactacao(void);
+static void buscar_palavra_menu(void);
+static void publicar_consulta(void);
+static void retirar_da_consulta(int tipo);
+static void salvar_indices_menu(void);
+static void carregar_indices_menu(void);
+static void descartar_salvo(int tipo);
+static void estatisticas_menu(void);
+static void buscar_padrao_menu(void);
+static void consulta_termos_menu(void);
+static void acrescentar_texto_aos_indices(TokenCorpus* parte);
+static void acrescentar_keywords_aos_indices(int primeira);
+static void perguntar_exclusao_indices(void);
+static void carregar_documentos_menu(void);
+static void imprimir_posicoes(const int* posicoes, int total);
 
 // Variáveis globais compartilhadas (static para escopo de arquivo)
-static char texto_comum[MAX_TEXT_SIZE];
 static char keywords_comum[MAX_KEYWORDS][MAX_WORD_SIZE];
 static int num_keywords_comum;
-static char** palavras_comum;
-static int** posicoes_comum;
-static int num_palavras_comum;
+static TokenCorpus* corpus_comum;
+static char arquivo_texto[256];  // Arquivo do texto carregado (varrido pelo autômato)
 static int texto_carregado;
 static int keywords_carregadas;
+static QueryIndex* consulta;
+static QueryReader* leitor_consulta;
+static DocumentSet* documentos;
 
-int main() {
+int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "");
-    palavras_comum = calloc(MAX_TEXT_SIZE, sizeof(char*));
-    posicoes_comum = calloc(MAX_TEXT_SIZE, sizeof(int*));
     
-    if (!palavras_comum || !posicoes_comum) {
-        fprintf(stderr, "Erro: falha na alocação de memória\n");
-        free(palavras_comum);
-        free(posicoes_comum);
-        return EXIT_FAILURE;
-    }
+    // Com argumentos, o programa roda em lote e não abre o menu
+    if (argc > 1) return batch_run(argc, argv);
+    
+    consulta = query_index_create();
+    leitor_consulta = query_reader_register(consulta);
     
     for (int opcao = -1; opcao != 0;) {
         exibir_menu();
@@ -118,19 +164,24 @@ int main() {
             case 4: imprimir_indice_menu(); break;
             case 5: imprimir_representacao_arvore_menu(); break;
             case 6: excluir_indice_menu(); break;
+            case 7: buscar_palavra_menu(); break;
+            case 8: salvar_indices_menu(); break;
+            case 9: carregar_indices_menu(); break;
+            case 10: estatisticas_menu(); break;
+            case 11: buscar_padrao_menu(); break;
+            case 12: consulta_termos_menu(); break;
+            case 13: carregar_documentos_menu(); break;
             default: printf("Opção inválida!\n");
         }
     }
     
+    retirar_da_consulta(ESTRUTURA_AMBAS);
     limpar_recursos();
+    query_reader_unregister(leitor_consulta);
+    query_index_destroy(consulta);
     
-    // Libera memória dos arrays comuns
-    for (int i = 0; i < num_palavras_comum; i++) {
-        free(palavras_comum[i]);
-        free(posicoes_comum[i]);
-    }
-    free(palavras_comum);
-    free(posicoes_comum);
+    // Devolve a referência ao corpus comum
+    limpar_recursos_comuns();
     
     return EXIT_SUCCESS;
 }
@@ -143,6 +194,13 @@ static void exibir_menu(void) {
            "|4. Imprimir índices                 |\n"
            "|5. Imprimir representação em árvore |\n"
            "|6. Excluir índices                  |\n"
+           "|7. Buscar palavra                   |\n"
+           "|8. Salvar índices em arquivo        |\n"
+           "|9. Carregar índices de arquivo      |\n"
+           "|10. Estatísticas dos índices        |\n"
+           "|11. Buscar por padrão               |\n"
+           "|12. Consulta com vários termos      |\n"
+           "|13. Carregar vários documentos      |\n"
            "|0. Sair                             |\n"
            " ====================================\n\n"
            "Escolha: ");
@@ -150,71 +208,192 @@ static void exibir_menu(void) {
 }
 
 // Função auxiliar para limpar os recursos comuns
+// (os índices criados mantêm suas próprias referências ao corpus)
 static void limpar_recursos_comuns(void) {
-    for (int i = 0; i < num_palavras_comum; i++) {
-        free(palavras_comum[i]);
-        free(posicoes_comum[i]);
-        palavras_comum[i] = NULL;
-        posicoes_comum[i] = NULL;
+    corpus_release(corpus_comum);
+    corpus_comum = NULL;
+    texto_carregado = 0;
+    if (documentos) {
+        docs_destroy(documentos);
+        documentos = NULL;
+        set_compactar_ocorrencias(0);
     }
-    num_palavras_comum = texto_carregado = 0;
 }
 
-static void sanitize_keyword(char *str) {
-    char *src = str;
-    char *dst = str;
-    while (*src) {
-        unsigned char uc = (unsigned char)*src;
-        if (isalnum(uc) || uc == '-' || uc > 127) {
-            *dst++ = *src;
-        }
-        src++;
-    }
-    *dst = '\0';
+// Publica na consulta as estruturas Hash e Trie existentes
+static void publicar_consulta(void) {
+    query_index_publish(consulta, get_hash_table(), get_trie_root());
+}
+
+// Retira da consulta as estruturas indicadas; ao retornar, podem ser destruídas
+static void retirar_da_consulta(int tipo) {
+    query_index_publish(consulta,
+                        (tipo & ESTRUTURA_HASH) ? NULL : get_hash_table(),
+                        (tipo & ESTRUTURA_TRIE) ? NULL : get_trie_root());
+}
+
+// Converte a opção digitada para o tipo de estrutura (0 se inválida)
+static int converter_estrutura(const char* opcao) {
+    if (strcmp(opcao, "hash") == 0) return ESTRUTURA_HASH;
+    if (strcmp(opcao, "trie") == 0) return ESTRUTURA_TRIE;
+    if (strcmp(opcao, "ambas") == 0) return ESTRUTURA_AMBAS;
+    if (strcmp(opcao, "radix") == 0) return ESTRUTURA_RADIX;
+    if (strcmp(opcao, "aho") == 0) return ESTRUTURA_AHO;
+    return 0;
 }
 
 static void carregar_texto(void) {
     char filename[256];
+    int acrescentar = 0;
     
-    if (get_hash_table() || get_trie_root()) {
-        printf("Aviso: Já existem índices carregados. Deseja excluí-los? (s/n): ");
-        if (getchar() == 's') {
-            getchar(); // Limpa o \n
-            excluir_indice_menu();
-        } else {
-            getchar(); // Limpa o \n
-        }
+    // Um novo trecho pode continuar o texto carregado, atualizando os índices
+    if (texto_carregado) {
+        printf("Acrescentar ao texto já carregado? (s/n): ");
+        acrescentar = getchar() == 's';
+        getchar(); // Limpa o \n
     }
     
-    limpar_recursos_comuns();
+    if (!acrescentar) {
+        perguntar_exclusao_indices();
+        limpar_recursos_comuns();
+    }
 
     do {
         printf("Nome do arquivo de texto: ");
         if (!fgets(filename, sizeof(filename), stdin)) continue;
         filename[strcspn(filename, "\n")] = 0;
         
-        if (!carregar_arquivo_texto(filename, texto_comum)) {
+        if (acrescentar && documentos) {
+            // Com vários documentos, o arquivo (ou diretório) entra como novos documentos
+            int antes = documentos->num_docs;
+            char* caminhos[1] = {filename};
+            if (docs_add_paths(documentos, caminhos, 1, 1) == 0) {
+                printf("Erro ao carregar arquivo!\n");
+                continue;
+            }
+            corpus_release(corpus_comum);
+            corpus_comum = corpus_retain(docs_ultima(documentos));
+            printf("%d documento(s) acrescentado(s) (%d no total)\n", documentos->num_docs - antes,
+                   documentos->num_docs);
+            for (int d = antes; d < documentos->num_docs; d++) acrescentar_texto_aos_indices(documentos->partes[d]);
+            break;
+        }
+        
+        if (acrescentar) {
+            // Só o trecho novo é processado; suas posições continuam as do texto
+            TokenCorpus* parte = corpus_append_from_file(corpus_comum, filename);
+            if (!parte || !parte->num_palavras) {
+                printf(parte ? "Arquivo vazio ou sem conteúdo válido.\n" : "Erro ao carregar arquivo!\n");
+                corpus_release(parte);
+                continue;
+            }
+            corpus_release(corpus_comum);  // A nova parte mantém a anterior
+            corpus_comum = parte;
+            strcpy(arquivo_texto, filename);
+            printf("Texto acrescentado com sucesso (%d palavras, %d no total)\n",
+                   parte->num_palavras, corpus_total_tokens(parte));
+            acrescentar_texto_aos_indices(parte);
+            break;
+        }
+        
+        // O arquivo é processado diretamente (mmap ou blocos), sem cópia em memória
+        corpus_comum = corpus_create_from_file(filename);
+        if (!corpus_comum) {
             printf("Erro ao carregar arquivo!\n");
             continue;
         }
-
-        processar_texto(texto_comum, palavras_comum, posicoes_comum, &num_palavras_comum);
         
-        if (!num_palavras_comum) {
+        if (!corpus_comum->num_palavras) {
             printf("Arquivo vazio ou sem conteúdo válido.\n");
+            limpar_recursos_comuns();
             continue;
         }
         
         texto_carregado = 1;
-        printf("Texto carregado com sucesso (%d palavras)\n", num_palavras_comum);
+        strcpy(arquivo_texto, filename);
+        printf("Texto carregado com sucesso (%d palavras)\n", corpus_comum->num_palavras);
         break;
     } while (1);
 }
 
+// Oferece a exclusão dos índices existentes antes de carregar outro texto
+static void perguntar_exclusao_indices(void) {
+    if (get_hash_table() || get_trie_root() || get_radix_root() || get_aho_automaton()) {
+        printf("Aviso: Já existem índices carregados. Deseja excluí-los? (s/n): ");
+        if (getchar() == 's') {
+            getchar(); // Limpa o \n
+            excluir_indice_menu();
+        } else {
+            getchar(); // Limpa o \n
+        }
+    }
+}
+
+/* Carrega vários documentos de uma vez (arquivos e diretórios separados por
+ * espaço), processados em paralelo. Cada documento continua a cadeia de corpus,
+ * e os índices criados depois mostram as ocorrências por documento */
+static void carregar_documentos_menu(void) {
+    char linha[4096];
+    
+    perguntar_exclusao_indices();
+    limpar_recursos_comuns();
+    
+    printf("Arquivos ou diretórios (separados por espaço): ");
+    fflush(stdout);
+    if (!fgets(linha, sizeof(linha), stdin)) return;
+    linha[strcspn(linha, "\n")] = '\0';
+    
+    int num_caminhos = 0, capacidade = 16;
+    char** caminhos = malloc(capacidade * sizeof(char*));
+    for (char* c = strtok(linha, " \t"); c && caminhos; c = strtok(NULL, " \t")) {
+        if (num_caminhos == capacidade) {
+            capacidade *= 2;
+            char** novos = realloc(caminhos, capacidade * sizeof(char*));
+            if (!novos) free(caminhos);
+            caminhos = novos;
+            if (!caminhos) break;
+        }
+        caminhos[num_caminhos++] = c;
+    }
+    if (!caminhos || num_caminhos == 0) {
+        printf(caminhos ? "Nenhum caminho informado.\n" : "Erro de alocação de memória para os caminhos.\n");
+        free(caminhos);
+        return;
+    }
+    int num_threads = ler_num_threads();
+    
+    documentos = docs_create();
+    int num_docs = documentos ? docs_add_paths(documentos, caminhos, num_caminhos, num_threads) : 0;
+    free(caminhos);
+    TokenCorpus* ultima = docs_ultima(documentos);
+    if (num_docs == 0 || corpus_total_tokens(ultima) == 0) {
+        printf("Nenhum documento com conteúdo válido.\n");
+        limpar_recursos_comuns();
+        return;
+    }
+    
+    // Coleções grandes: ocorrências compactadas (delta + varint) nos índices criados
+    set_compactar_ocorrencias(1);
+    corpus_comum = corpus_retain(ultima);
+    texto_carregado = 1;
+    snprintf(arquivo_texto, sizeof(arquivo_texto), "%s", documentos->nomes[0]);
+    
+    long long palavras = 0;
+    for (int d = 0; d < num_docs; d++) palavras += documentos->partes[d]->num_palavras;
+    printf("%d documento(s) carregado(s) (%lld palavras)\n", num_docs, palavras);
+}
+
 /* Função para carregar a lista de palavras-chave */
 void carregar_lista_keywords(void) {
     char filename[256];
-    char buffer[1024];  // Buffer para ler uma linha inteira
+    int primeira = 0;  // Primeira palavra-chave nova
+    
+    // Novas palavras-chave podem se somar às carregadas, atualizando os índices
+    if (keywords_carregadas) {
+        printf("Acrescentar às palavras-chave carregadas? (s/n): ");
+        if (getchar() == 's') primeira = num_keywords_comum;
+        getchar(); // Limpa o \n
+    }
     
     do {
         printf("Digite o nome do arquivo de palavras-chave: ");
@@ -223,50 +402,21 @@ void carregar_lista_keywords(void) {
         fgets(filename, sizeof(filename), stdin);
         filename[strcspn(filename, "\n")] = '\0';
         
-        FILE *file = fopen(filename, "r");
-        if (!file) {
+        int has_non_whitespace;  // Indica se o arquivo tem conteúdo não-branco
+        int total = ler_keywords_arquivo(filename, keywords_comum, primeira, &has_non_whitespace);
+        if (total < 0) {
             printf("Falha ao abrir o arquivo de palavras-chave.\n");
             continue;
         }
+        num_keywords_comum = total;
         
-        num_keywords_comum = 0;
-        int has_non_whitespace = 0;  // Flag para verificar se há conteúdo não-branco
-        
-        while (fgets(buffer, sizeof(buffer), file) && num_keywords_comum < MAX_KEYWORDS) {
-            buffer[strcspn(buffer, "\n")] = '\0';  // Remove newline
-            
-            // Verifica se a linha tem algum caractere não-branco
-            for (int i = 0; buffer[i]; i++) {
-                if (buffer[i] != ' ' && buffer[i] != '\t') {
-                    has_non_whitespace = 1;
-                    break;
-                }
-            }
-            
-            if (!has_non_whitespace) continue;  // Pula linhas que só têm espaços
-            
-            char *token = strtok(buffer, ",");  // Divide a linha por vírgulas
-            while (token && num_keywords_comum < MAX_KEYWORDS) {
-                // Remove espaços e sanitiza
-                while (*token == ' ') token++;
-                int len = strlen(token);
-                while (len > 0 && token[len-1] == ' ') token[--len] = '\0';
-    
-                // Sanitiza o token (remove pontuações)
-                sanitize_keyword(token);
-                len = strlen(token);
-    
-                if (len > 0) {
-                    strncpy(keywords_comum[num_keywords_comum], token, MAX_WORD_SIZE - 1);
-                    keywords_comum[num_keywords_comum][MAX_WORD_SIZE - 1] = '\0';
-                    num_keywords_comum++;
-                }
-                token = strtok(NULL, ",");
-            }
+        if (primeira > 0 && has_non_whitespace) {
+            printf("%d palavra(s)-chave acrescentada(s) (total: %d).\n",
+                   num_keywords_comum - primeira, num_keywords_comum);
+            acrescentar_keywords_aos_indices(primeira);
+            break;
         }
         
-        fclose(file);
-        
         if (num_keywords_comum == 0 || !has_non_whitespace) {
             printf("O arquivo está vazio ou contém apenas espaços em branco. Por favor, forneça um arquivo com palavras-chave.\n");
             continue;
@@ -280,6 +430,100 @@ void carregar_lista_keywords(void) {
     } while (1);
 }
 
+// Troca a referência de um índice ao corpus pela última parte do texto
+static void trocar_corpus(TokenCorpus* (*get)(void), void (*set)(TokenCorpus*), TokenCorpus* parte) {
+    TokenCorpus* antigo = get();
+    set(corpus_retain(parte));
+    corpus_release(antigo);
+}
+
+/* Acrescenta um novo trecho do texto aos índices Hash e Trie criados, sem
+ * reconstruí-los. A Radix e o autômato não aceitam acréscimos e são excluídos */
+static void acrescentar_texto_aos_indices(TokenCorpus* parte) {
+    retirar_da_consulta(ESTRUTURA_AMBAS);
+    
+    HashTable* ht = get_hash_table();
+    if (ht) {
+        int ok = hash_append_indice(ht, parte->distintas, parte->listas, parte->num_distintas, parte->base,
+                                    get_keywords_hash(), get_num_keywords_hash(), 0);
+        if (get_compactar_ocorrencias()) hash_compact(ht);
+        trocar_corpus(get_corpus_hash, set_corpus_hash, parte);
+        printf(ok ? "Índice hash atualizado.\n" : "Falha ao atualizar o índice hash.\n");
+    }
+    
+    TrieNode* root = get_trie_root();
+    if (root) {
+        int ok = trie_append_indice(root, parte->distintas, parte->listas, parte->num_distintas, parte->base,
+                                    get_keywords_trie(), get_num_keywords_trie(), 0);
+        if (get_compactar_ocorrencias()) trie_compact(root);
+        trocar_corpus(get_corpus_trie, set_corpus_trie, parte);
+        printf(ok ? "Índice trie atualizado.\n" : "Falha ao atualizar o índice trie.\n");
+    }
+    
+    if (get_radix_root()) {
+        limpar_recursos_radix();
+        printf("A árvore radix não aceita acréscimos e foi excluída.\n");
+    }
+    if (get_aho_automaton()) {
+        limpar_recursos_aho();
+        printf("O autômato de Aho-Corasick não aceita acréscimos e foi excluído.\n");
+    }
+    
+    publicar_consulta();
+}
+
+// Acrescenta keywords_comum[primeira..] às palavras-chave de um índice; retorna
+// a posição da primeira nova na lista do índice
+static int copiar_keywords_novas(char (*keywords)[MAX_WORD_SIZE], int* num_keywords, int primeira) {
+    int inicio = *num_keywords;
+    for (int k = primeira; k < num_keywords_comum && *num_keywords < MAX_KEYWORDS; k++) {
+        memcpy(keywords[(*num_keywords)++], keywords_comum[k], MAX_WORD_SIZE);
+    }
+    return inicio;
+}
+
+/* Indexa nos índices Hash e Trie criados só as palavras-chave novas
+ * (keywords_comum[primeira..]), procurando-as nas palavras distintas de cada
+ * parte do texto, sem reconstruir os índices */
+static void acrescentar_keywords_aos_indices(int primeira) {
+    retirar_da_consulta(ESTRUTURA_AMBAS);
+    
+    HashTable* ht = get_hash_table();
+    int num_partes;
+    TokenCorpus** partes = ht ? corpus_parts(get_corpus_hash(), &num_partes) : NULL;
+    if (partes) {
+        int num = get_num_keywords_hash();
+        int inicio = copiar_keywords_novas(get_keywords_hash(), &num, primeira);
+        set_num_keywords_hash(num);
+        int ok = 1;
+        for (int p = 0; p < num_partes && ok; p++) {
+            ok = hash_append_indice(ht, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                    partes[p]->base, get_keywords_hash(), num, inicio);
+        }
+        if (get_compactar_ocorrencias()) hash_compact(ht);
+        printf(ok ? "Índice hash atualizado.\n" : "Falha ao atualizar o índice hash.\n");
+        free(partes);
+    }
+    
+    TrieNode* root = get_trie_root();
+    partes = root ? corpus_parts(get_corpus_trie(), &num_partes) : NULL;
+    if (partes) {
+        int num = get_num_keywords_trie();
+        int inicio = copiar_keywords_novas(get_keywords_trie(), &num, primeira);
+        set_num_keywords_trie(num);
+        int ok = 1;
+        for (int p = 0; p < num_partes && ok; p++) {
+            ok = trie_append_indice(root, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                    partes[p]->base, get_keywords_trie(), num, inicio);
+        }
+        if (get_compactar_ocorrencias()) trie_compact(root);
+        printf(ok ? "Índice trie atualizado.\n" : "Falha ao atualizar o índice trie.\n");
+        free(partes);
+    }
+    
+    publicar_consulta();
+}
+
 /* Função para criar o índice remissivo */
 void criar_indice_menu(void) {
     char opcao[10];
@@ -294,26 +538,47 @@ void criar_indice_menu(void) {
         return;
     }
     
-    printf("Criar índice em qual estrutura? (hash/trie/ambas): ");
+    printf("Criar índice em qual estrutura? (hash/trie/radix/aho/ambas): ");
     fgets(opcao, sizeof(opcao), stdin);
     opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
+    
+    // Radix e Aho-Corasick só indexam um texto carregado de uma única vez
+    if ((tipo & (ESTRUTURA_RADIX | ESTRUTURA_AHO)) && corpus_comum->anterior) {
+        printf("A árvore radix e o autômato não aceitam texto em várias partes (trechos acrescentados ou vários documentos).\n");
+        tipo &= ~(ESTRUTURA_RADIX | ESTRUTURA_AHO);
+        if (!tipo) return;
+    }
+    
+    // Hash e Trie podem ser construídas em paralelo (a Radix é sempre serial)
+    int num_threads = 1;
+    if (tipo & (ESTRUTURA_HASH | ESTRUTURA_TRIE)) {
+        num_threads = ler_num_threads();
+        ler_compactacao();
+    }
+    
+    // Hash e Trie indexam todas as partes do texto: a primeira pela criação
+    // normal e as demais por acréscimo
+    int num_partes = 1;
+    TokenCorpus** partes = NULL;
+    if (tipo & (ESTRUTURA_HASH | ESTRUTURA_TRIE)) {
+        partes = corpus_parts(corpus_comum, &num_partes);
+        if (!partes) {
+            printf("Erro de alocação de memória para as partes do texto.\n");
+            return;
+        }
+    }
     
-    if (strcmp(opcao, "hash") == 0 || strcmp(opcao, "ambas") == 0) {
-        // Copiar dados para a estrutura hash
+    // As estruturas reconstruídas saem da consulta antes de serem liberadas
+    // (e substituem as carregadas de arquivo)
+    retirar_da_consulta(tipo);
+    descartar_salvo(tipo);
+    
+    if (tipo & ESTRUTURA_HASH) {
+        // Empresta o corpus comum para a estrutura hash (sem copiar)
         limpar_recursos_hash();
-        set_texto_hash(texto_comum);
-        
-        // Copiar palavras e posições para hash
-        for (int i = 0; i < num_palavras_comum; i++) {
-            get_palavras_hash()[i] = strdup(palavras_comum[i]);
-            
-            // Copiar posições
-            int* pos_original = posicoes_comum[i];
-            int count = pos_original[0] + 1; // +1 para o contador no início
-            get_posicoes_hash()[i] = (int*)malloc(count * sizeof(int));
-            memcpy(get_posicoes_hash()[i], pos_original, count * sizeof(int));
-        }
-        set_num_palavras_hash(num_palavras_comum);
+        TokenCorpus* corpus = corpus_retain(corpus_comum);
+        set_corpus_hash(corpus);
         
         // Copiar keywords para hash
         memcpy(get_keywords_hash(), keywords_comum, num_keywords_comum * MAX_WORD_SIZE);
@@ -321,32 +586,28 @@ void criar_indice_menu(void) {
         
         // Criar o índice hash
         HashTable* ht = get_hash_table();
-        if (criar_indice_hash(&ht, get_palavras_hash(), get_posicoes_hash(),
-                            get_num_palavras_hash(), get_keywords_hash(),
-                            get_num_keywords_hash())) {
+        int ok = criar_indice_hash_paralelo(&ht, partes[0]->palavras, partes[0]->posicoes,
+                                            partes[0]->num_palavras, get_keywords_hash(),
+                                            get_num_keywords_hash(), num_threads);
+        for (int p = 1; p < num_partes && ok; p++) {
+            ok = hash_append_indice(ht, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                    partes[p]->base, get_keywords_hash(), get_num_keywords_hash(), 0);
+        }
+        if (ok) {
+            if (get_compactar_ocorrencias()) hash_compact(ht);
             set_hash_table(ht);
             printf("Índice remissivo usando tabela hash criado com sucesso.\n");
         } else {
+            if (ht) hash_destroy(ht);
             printf("Falha ao criar o índice remissivo usando tabela hash.\n");
         }
     }
     
-    if (strcmp(opcao, "trie") == 0 || strcmp(opcao, "ambas") == 0) {
-        // Copiar dados para a estrutura trie
+    if (tipo & ESTRUTURA_TRIE) {
+        // Empresta o corpus comum para a estrutura trie (sem copiar)
         limpar_recursos_trie();
-        set_texto_trie(texto_comum);
-        
-        // Copiar palavras e posições para trie
-        for (int i = 0; i < num_palavras_comum; i++) {
-            get_palavras_trie()[i] = strdup(palavras_comum[i]);
-            
-            // Copiar posições
-            int* pos_original = posicoes_comum[i];
-            int count = pos_original[0] + 1; // +1 para o contador no início
-            get_posicoes_trie()[i] = (int*)malloc(count * sizeof(int));
-            memcpy(get_posicoes_trie()[i], pos_original, count * sizeof(int));
-        }
-        set_num_palavras_trie(num_palavras_comum);
+        TokenCorpus* corpus = corpus_retain(corpus_comum);
+        set_corpus_trie(corpus);
         
         // Copiar keywords para trie
         memcpy(get_keywords_trie(), keywords_comum, num_keywords_comum * MAX_WORD_SIZE);
@@ -354,131 +615,649 @@ void criar_indice_menu(void) {
         
         // Criar o índice trie
         TrieNode* root = get_trie_root();
-        if (criar_indice_trie(&root, get_palavras_trie(), get_posicoes_trie(),
-                           get_num_palavras_trie(), get_keywords_trie(),
-                           get_num_keywords_trie())) {
+        int ok = criar_indice_trie_paralelo(&root, partes[0]->palavras, partes[0]->posicoes,
+                                            partes[0]->num_palavras, get_keywords_trie(),
+                                            get_num_keywords_trie(), num_threads);
+        for (int p = 1; p < num_partes && ok; p++) {
+            ok = trie_append_indice(root, partes[p]->distintas, partes[p]->listas, partes[p]->num_distintas,
+                                    partes[p]->base, get_keywords_trie(), get_num_keywords_trie(), 0);
+        }
+        if (ok) {
+            if (get_compactar_ocorrencias()) trie_compact(root);
             set_trie_root(root);
             printf("Índice remissivo usando árvore de pesquisa digital criado com sucesso.\n");
         } else {
+            if (root) trie_destroy(root);
             printf("Falha ao criar o índice remissivo usando árvore de pesquisa digital.\n");
         }
     }
     
-    if (strcmp(opcao, "hash") != 0 && strcmp(opcao, "trie") != 0 && strcmp(opcao, "ambas") != 0) {
-        printf("Opção inválida. Use 'hash', 'trie' ou 'ambas'.\n");
+    if (tipo & ESTRUTURA_RADIX) {
+        // Empresta o corpus comum para a estrutura radix (sem copiar)
+        limpar_recursos_radix();
+        TokenCorpus* corpus = corpus_retain(corpus_comum);
+        set_corpus_radix(corpus);
+        
+        memcpy(get_keywords_radix(), keywords_comum, num_keywords_comum * MAX_WORD_SIZE);
+        set_num_keywords_radix(num_keywords_comum);
+        
+        // Criar o índice radix
+        RadixNode* root = get_radix_root();
+        if (criar_indice_radix(&root, corpus->palavras, corpus->posicoes,
+                               corpus->num_palavras, get_keywords_radix(),
+                               get_num_keywords_radix())) {
+            set_radix_root(root);
+            printf("Índice remissivo usando árvore radix criado com sucesso.\n");
+        } else {
+            if (root) radix_destroy(root);
+            printf("Falha ao criar o índice remissivo usando árvore radix.\n");
+        }
+    }
+    
+    if (tipo & ESTRUTURA_AHO) {
+        // Varre o arquivo de texto uma única vez, sem usar o corpus de tokens
+        limpar_recursos_aho();
+        AhoAutomaton* ac = aho_create(keywords_comum, num_keywords_comum);
+        if (aho_scan_file(ac, arquivo_texto) == 1) {
+            set_aho_automaton(ac);
+            printf("Índice remissivo usando autômato de Aho-Corasick criado com sucesso.\n");
+        } else {
+            aho_destroy(ac);
+            printf("Falha ao criar o índice remissivo usando autômato de Aho-Corasick.\n");
+        }
+    }
+    
+    if (!tipo) {
+        printf("Opção inválida. Use 'hash', 'trie', 'radix', 'aho' ou 'ambas'.\n");
     }
+    
+    free(partes);
+    publicar_consulta();
+}
+
+/* Lê o número de threads para a criação do índice (Enter = 1) */
+static int ler_num_threads(void) {
+    char entrada[16];
+    printf("Número de threads (1-%d, Enter = 1): ", HASH_MAX_THREADS);
+    fflush(stdout);
+    
+    if (!fgets(entrada, sizeof(entrada), stdin)) return 1;
+    int num_threads = atoi(entrada);
+    if (num_threads < 1) return 1;
+    if (num_threads > HASH_MAX_THREADS) return HASH_MAX_THREADS;
+    return num_threads;
+}
+
+/* Pergunta se as ocorrências dos índices criados serão compactadas (Enter = mantém) */
+static void ler_compactacao(void) {
+    char entrada[16];
+    printf("Compactar as ocorrências (delta + varint)? (s/n, Enter = %s): ",
+           get_compactar_ocorrencias() ? "s" : "n");
+    fflush(stdout);
+    
+    if (!fgets(entrada, sizeof(entrada), stdin)) return;
+    if (entrada[0] == 's' || entrada[0] == 'S') set_compactar_ocorrencias(1);
+    else if (entrada[0] == 'n' || entrada[0] == 'N') set_compactar_ocorrencias(0);
 }
 
 /* Função para imprimir o índice remissivo */
 void imprimir_indice_menu(void) {
     char opcao[10];
-    printf("Qual estrutura deseja imprimir (hash/trie/ambas): ");
+    printf("Qual estrutura deseja imprimir (hash/trie/radix/aho/ambas): ");
     fflush(stdout);
     
     fgets(opcao, sizeof(opcao), stdin);
     opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
     printf("=== ÍNDICES CRIADOS ===\n\n");
     
-    if (strcmp(opcao, "hash") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_HASH) {
+        IndexStore* salvo = get_indice_salvo();
         if (get_hash_table() != NULL) {
             imprimir_indice_hash(get_hash_table());
+        } else if (salvo && salvo->hash) {
+            imprimir_indice_hash_imagem(salvo->hash, salvo->keywords_hash, salvo->num_keywords_hash);
         } else {
             printf("=================================\n");
             printf("Índice hash não foi criado ainda.\n");
         }
     }
     
-    if (strcmp(opcao, "trie") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_TRIE) {
+        IndexStore* salvo = get_indice_salvo();
         if (get_trie_root() != NULL) {
             imprimir_indice_trie(get_trie_root());
+        } else if (salvo && salvo->trie) {
+            imprimir_indice_dat(salvo->trie, salvo->keywords_trie, salvo->num_keywords_trie);
         } else {
             printf("=================================\n");
             printf("Índice trie não foi criado ainda.\n");
         }
     }
     
-    if (strcmp(opcao, "hash") != 0 && strcmp(opcao, "trie") != 0 && strcmp(opcao, "ambas") != 0) {
-        printf("Opção inválida. Use 'hash', 'trie' ou 'ambas'.\n");
+    if (tipo & ESTRUTURA_RADIX) {
+        if (get_radix_root() != NULL) {
+            imprimir_indice_radix(get_radix_root());
+        } else {
+            printf("=================================\n");
+            printf("Índice radix não foi criado ainda.\n");
+        }
+    }
+    
+    if (tipo & ESTRUTURA_AHO) {
+        if (get_aho_automaton() != NULL) {
+            imprimir_indice_aho(get_aho_automaton());
+        } else {
+            printf("=================================\n");
+            printf("Índice Aho-Corasick não foi criado ainda.\n");
+        }
+    }
+    
+    if (!tipo) {
+        printf("Opção inválida. Use 'hash', 'trie', 'radix', 'aho' ou 'ambas'.\n");
     }
 }
 
 /* Função para excluir o índice remissivo */
 void excluir_indice_menu(void) {
     char opcao[10];
-    printf("Qual estrutura deseja excluir (hash/trie/ambas): ");
+    printf("Qual estrutura deseja excluir (hash/trie/radix/aho/ambas): ");
     fflush(stdout);
     
     fgets(opcao, sizeof(opcao), stdin);
     opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
+    retirar_da_consulta(tipo);
     
-    if (strcmp(opcao, "hash") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_HASH) {
         HashTable* ht = get_hash_table();
         if (ht != NULL) {
             hash_destroy(ht);
             set_hash_table(NULL);
             printf("Índice hash excluído.\n");
+        } else if (get_indice_salvo() && get_indice_salvo()->hash) {
+            descartar_salvo(ESTRUTURA_HASH);
+            printf("Índice hash excluído.\n");
         } else {
             printf("Índice hash não existe.\n");
         }
         
-        if (strcmp(opcao, "hash") == 0) {
+        if (tipo == ESTRUTURA_HASH) {
             limpar_recursos_hash();
         }
     }
     
-    if (strcmp(opcao, "trie") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_TRIE) {
         TrieNode* root = get_trie_root();
         if (root != NULL) {
             trie_destroy(root);
             set_trie_root(NULL);
             printf("Índice trie excluído.\n");
+        } else if (get_indice_salvo() && get_indice_salvo()->trie) {
+            descartar_salvo(ESTRUTURA_TRIE);
+            printf("Índice trie excluído.\n");
         } else {
             printf("Índice trie não existe.\n");
         }
         
-        if (strcmp(opcao, "trie") == 0) {
+        if (tipo == ESTRUTURA_TRIE) {
             limpar_recursos_trie();
         }
     }
     
-    if (strcmp(opcao, "ambas") == 0) {
-        limpar_recursos();
+    if (tipo & ESTRUTURA_RADIX) {
+        RadixNode* root = get_radix_root();
+        if (root != NULL) {
+            radix_destroy(root);
+            set_radix_root(NULL);
+            printf("Índice radix excluído.\n");
+        } else {
+            printf("Índice radix não existe.\n");
+        }
+        limpar_recursos_radix();
     }
     
-    if (strcmp(opcao, "hash") != 0 && strcmp(opcao, "trie") != 0 && 
-        strcmp(opcao, "ambas") != 0) {
-        printf("Opção inválida. Use 'hash', 'trie' ou 'ambas'.\n");
+    if (tipo & ESTRUTURA_AHO) {
+        if (get_aho_automaton() != NULL) {
+            limpar_recursos_aho();
+            printf("Índice Aho-Corasick excluído.\n");
+        } else {
+            printf("Índice Aho-Corasick não existe.\n");
+        }
+    }
+    
+    if (tipo == ESTRUTURA_AMBAS) {
+        limpar_recursos_hash();
+        limpar_recursos_trie();
+    }
+    
+    if (!tipo) {
+        printf("Opção inválida. Use 'hash', 'trie', 'radix', 'aho' ou 'ambas'.\n");
     }
 }
 
 /* Nova função para imprimir a representação em árvore */
 void imprimir_representacao_arvore_menu(void) {
     char opcao[10];
-    printf("Qual estrutura deseja visualizar como árvore (hash/trie/ambas): ");
+    printf("Qual estrutura deseja visualizar como árvore (hash/trie/radix/aho/ambas): ");
     fflush(stdout);
     
     fgets(opcao, sizeof(opcao), stdin);
     opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
     
-    if (strcmp(opcao, "hash") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_HASH) {
         if (get_hash_table() != NULL) {
             imprimir_hash_arvore(get_hash_table());
+        } else if (get_indice_salvo() && get_indice_salvo()->hash) {
+            printf("=================================\n");
+            printf("O índice hash carregado de arquivo não tem representação em árvore.\n");
         } else {
             printf("=================================\n");
             printf("A arvore hash não foi criada ainda.\n");
         }
     }
     
-    if (strcmp(opcao, "trie") == 0 || strcmp(opcao, "ambas") == 0) {
+    if (tipo & ESTRUTURA_TRIE) {
         if (get_trie_root() != NULL) {
             imprimir_trie_arvore(get_trie_root());
+        } else if (get_indice_salvo() && get_indice_salvo()->trie) {
+            printf("=================================\n");
+            printf("O índice trie carregado de arquivo não tem representação em árvore.\n");
         } else {
             printf("=================================\n");
             printf("A arvore trie não foi criada ainda.\n");
         }
     }
     
-    if (strcmp(opcao, "hash") != 0 && strcmp(opcao, "trie") != 0 && strcmp(opcao, "ambas") != 0) {
+    if (tipo & ESTRUTURA_RADIX) {
+        if (get_radix_root() != NULL) {
+            imprimir_radix_arvore(get_radix_root());
+        } else {
+            printf("=================================\n");
+            printf("A arvore radix não foi criada ainda.\n");
+        }
+    }
+    
+    if (tipo & ESTRUTURA_AHO) {
+        if (get_aho_automaton() != NULL) {
+            imprimir_aho_arvore(get_aho_automaton());
+        } else {
+            printf("=================================\n");
+            printf("O autômato Aho-Corasick não foi criado ainda.\n");
+        }
+    }
+    
+    if (!tipo) {
+        printf("Opção inválida. Use 'hash', 'trie', 'radix', 'aho' ou 'ambas'.\n");
+    }
+}
+
+// Imprime uma lista de posições; com vários documentos, uma linha por documento,
+// com as posições locais ao documento
+static void imprimir_posicoes(const int* posicoes, int total) {
+    if (!documentos) {
+        printf(": ");
+        for (int i = 0; i < total; i++) {
+            printf(i ? ", %d" : "%d", posicoes[i]);
+        }
+        printf("\n");
+        return;
+    }
+    
+    int doc, num_docs = 0;
+    for (int inicio = 0; inicio < total; inicio = docs_group(documentos, posicoes, total, inicio, &doc)) num_docs++;
+    printf(" em %d documento(s):\n", num_docs);
+    for (int inicio = 0; inicio < total;) {
+        int fim = docs_group(documentos, posicoes, total, inicio, &doc);
+        int base = doc >= 0 ? documentos->partes[doc]->base : 0;
+        printf("  %s (%d): ", doc >= 0 ? documentos->nomes[doc] : "?", fim - inicio);
+        for (int i = inicio; i < fim; i++) {
+            printf(i > inicio ? ", %d" : "%d", posicoes[i] - base);
+        }
+        printf("\n");
+        inicio = fim;
+    }
+}
+
+// Imprime a lista de ocorrências encontrada por uma busca
+static void imprimir_ocorrencias(const char* nome, const int* posicoes, int total) {
+    if (total == 0) {
+        printf("%s: palavra não encontrada.\n", nome);
+        return;
+    }
+    printf("%s: %d ocorrência(s)", nome, total);
+    imprimir_posicoes(posicoes, total);
+}
+
+// Imprime as ocorrências de uma palavra em uma das estruturas publicadas
+static void imprimir_busca(const char* nome, TipoEstrutura estrutura, const char* palavra) {
+    int posicoes[64];
+    int total = query_search(leitor_consulta, estrutura, palavra, posicoes, 64);
+
+    // Lista maior que o buffer local: busca de novo em um buffer do tamanho exato
+    int* todas = posicoes;
+    if (total > 64) {
+        todas = malloc(total * sizeof(int));
+        if (todas) {
+            total = query_search(leitor_consulta, estrutura, palavra, todas, total);
+        } else {
+            todas = posicoes;
+            total = 64;
+        }
+    }
+
+    imprimir_ocorrencias(nome, todas, total);
+    if (todas != posicoes) free(todas);
+}
+
+/* Função para buscar uma palavra nos índices publicados */
+static void buscar_palavra_menu(void) {
+    char palavra[MAX_WORD_SIZE];
+    
+    IndexStore* salvo = get_indice_salvo();
+    int hash_salva = salvo && salvo->hash && !get_hash_table();
+    int trie_salva = salvo && salvo->trie && !get_trie_root();
+    if (!get_hash_table() && !get_trie_root() && !hash_salva && !trie_salva) {
+        printf("Nenhum índice hash ou trie foi criado ainda.\n");
+        return;
+    }
+    
+    printf("Palavra: ");
+    fflush(stdout);
+    if (!fgets(palavra, sizeof(palavra), stdin)) return;
+    palavra[strcspn(palavra, "\n")] = '\0';
+    
+    int total;
+    if (get_hash_table()) imprimir_busca("Hash", ESTRUTURA_HASH, palavra);
+    if (hash_salva) {
+        const int* posicoes = hash_image_search(salvo->hash, palavra, &total);
+        imprimir_ocorrencias("Hash", posicoes, total);
+    }
+    if (get_trie_root()) imprimir_busca("Trie", ESTRUTURA_TRIE, palavra);
+    if (trie_salva) {
+        const int* posicoes = dat_search(salvo->trie, palavra, &total);
+        imprimir_ocorrencias("Trie", posicoes, total);
+    }
+}
+
+// Descarta as partes indicadas do arquivo de índices carregado; o arquivo é
+// fechado quando não resta nenhuma
+static void descartar_salvo(int tipo) {
+    IndexStore* salvo = get_indice_salvo();
+    if (!salvo) return;
+    if (tipo & ESTRUTURA_HASH) salvo->hash = NULL;
+    if (tipo & ESTRUTURA_TRIE) salvo->trie = NULL;
+    if (!salvo->hash && !salvo->trie) limpar_recursos_salvo();
+}
+
+// Lê o nome de um arquivo de índices ('\0' se a leitura falhar)
+static void ler_nome_arquivo(char* filename, size_t tamanho) {
+    printf("Nome do arquivo de índices: ");
+    fflush(stdout);
+    if (!fgets(filename, tamanho, stdin)) filename[0] = '\0';
+    filename[strcspn(filename, "\n")] = '\0';
+}
+
+/* Grava os índices Hash e Trie (criados ou carregados) em um arquivo */
+static void salvar_indices_menu(void) {
+    IndexStore* salvo = get_indice_salvo();
+    HashTable* ht = get_hash_table();
+    TrieNode* root = get_trie_root();
+    
+    if (!ht && !root && !salvo) {
+        printf("Nenhum índice hash ou trie foi criado ainda.\n");
+        return;
+    }
+    
+    char filename[256];
+    ler_nome_arquivo(filename, sizeof(filename));
+    if (!filename[0]) return;
+    
+    // Índices criados são congelados; os carregados já estão no formato do arquivo
+    HashImage* hash_criada = ht ? hash_freeze(ht) : NULL;
+    DoubleArrayTrie* trie_criada = root ? trie_freeze(root) : NULL;
+    int ok = (!ht || hash_criada) && (!root || trie_criada);
+    
+    if (ok) {
+        const HashImage* hash = hash_criada ? hash_criada : (salvo ? salvo->hash : NULL);
+        const DoubleArrayTrie* trie = trie_criada ? trie_criada : (salvo ? salvo->trie : NULL);
+        ok = store_save(filename,
+                        hash, ht ? get_keywords_hash() : salvo->keywords_hash,
+                        ht ? get_num_keywords_hash() : salvo->num_keywords_hash,
+                        trie, root ? get_keywords_trie() : salvo->keywords_trie,
+                        root ? get_num_keywords_trie() : salvo->num_keywords_trie);
+    }
+    
+    hash_image_destroy(hash_criada);
+    dat_destroy(trie_criada);
+    printf(ok ? "Índices salvos em %s.\n" : "Falha ao salvar os índices em %s.\n", filename);
+}
+
+/* Carrega um arquivo de índices no lugar dos índices Hash e Trie existentes */
+static void carregar_indices_menu(void) {
+    char filename[256];
+    ler_nome_arquivo(filename, sizeof(filename));
+    if (!filename[0]) return;
+    
+    IndexStore* store = store_load(filename);
+    if (!store) {
+        printf("Falha ao carregar os índices de %s.\n", filename);
+        return;
+    }
+    
+    retirar_da_consulta(ESTRUTURA_AMBAS);
+    limpar_recursos_hash();
+    limpar_recursos_trie();
+    limpar_recursos_salvo();
+    set_indice_salvo(store);
+    
+    printf("Índices carregados de %s (hash: %s, trie: %s).\n", filename,
+           store->hash ? "sim" : "não", store->trie ? "sim" : "não");
+}
+
+/* Exibe as estatísticas das estruturas Hash e Trie criadas */
+static void estatisticas_menu(void) {
+    char opcao[10];
+    printf("Estatísticas de qual estrutura (hash/trie/ambas): ");
+    fflush(stdout);
+    
+    fgets(opcao, sizeof(opcao), stdin);
+    opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
+    
+    if (tipo & ESTRUTURA_HASH) {
+        HashStats st;
+        if (hash_stats(get_hash_table(), &st)) {
+            imprimir_estatisticas_hash(&st);
+        } else {
+            printf("=================================\n");
+            printf("A tabela hash não foi criada ainda.\n");
+        }
+    }
+    
+    if (tipo & ESTRUTURA_TRIE) {
+        TrieStats st;
+        if (trie_stats(get_trie_root(), &st)) {
+            imprimir_estatisticas_trie(&st);
+        } else {
+            printf("=================================\n");
+            printf("A arvore trie não foi criada ainda.\n");
+        }
+    }
+    
+    if (tipo & (ESTRUTURA_HASH | ESTRUTURA_TRIE)) {
+        if (stats_counters_enabled()) {
+            IndexCounters contadores;
+            stats_counters_read(&contadores);
+            imprimir_contadores(&contadores);
+        }
+    } else {
         printf("Opção inválida. Use 'hash', 'trie' ou 'ambas'.\n");
     }
+}
+
+// Imprime o resultado de uma consulta com vários termos em uma das estruturas publicadas
+static void imprimir_consulta_termos(const char* nome, TipoEstrutura estrutura, QueryOperator operador,
+                                     const char* const termos[], int num_termos, int distancia) {
+    int posicoes[64];
+    int total = query_terms(leitor_consulta, estrutura, operador, termos, num_termos, distancia, documentos,
+                            posicoes, 64);
+    if (total < 0) {
+        printf("%s: falha na consulta.\n", nome);
+        return;
+    }
+
+    // Resultado maior que o buffer local: consulta de novo em um buffer do tamanho exato
+    int* todas = posicoes;
+    if (total > 64) {
+        todas = malloc(total * sizeof(int));
+        if (todas) {
+            total = query_terms(leitor_consulta, estrutura, operador, termos, num_termos, distancia, documentos,
+                                todas, total);
+        } else {
+            todas = posicoes;
+            total = 64;
+        }
+    }
+
+    if (total == 0) {
+        printf("%s: nenhuma ocorrência.\n", nome);
+    } else {
+        printf("%s: %d posição(ões)", nome, total);
+        imprimir_posicoes(todas, total);
+    }
+    if (todas != posicoes) free(todas);
+}
+
+/* Consulta com vários termos nas estruturas Hash e Trie criadas: and, or,
+ * frase (termos consecutivos) ou near (termos a até k posições do primeiro) */
+static void consulta_termos_menu(void) {
+    char opcao[16];
+    char linha[QUERY_MAX_TERMS * MAX_WORD_SIZE];
+    
+    printf("Consultar em qual estrutura (hash/trie/ambas): ");
+    fflush(stdout);
+    if (!fgets(opcao, sizeof(opcao), stdin)) return;
+    opcao[strcspn(opcao, "\n")] = '\0';
+    int tipo = converter_estrutura(opcao);
+    if (!(tipo & (ESTRUTURA_HASH | ESTRUTURA_TRIE))) {
+        printf("Opção inválida. Use 'hash', 'trie' ou 'ambas'.\n");
+        return;
+    }
+    
+    printf("Operador (and/or/frase/near): ");
+    fflush(stdout);
+    if (!fgets(opcao, sizeof(opcao), stdin)) return;
+    opcao[strcspn(opcao, "\n")] = '\0';
+    QueryOperator operador;
+    if (strcmp(opcao, "and") == 0) {
+        operador = QUERY_AND;
+    } else if (strcmp(opcao, "or") == 0) {
+        operador = QUERY_OR;
+    } else if (strcmp(opcao, "frase") == 0) {
+        operador = QUERY_PHRASE;
+    } else if (strcmp(opcao, "near") == 0) {
+        operador = QUERY_NEAR;
+    } else {
+        printf("Operador inválido. Use 'and', 'or', 'frase' ou 'near'.\n");
+        return;
+    }
+    
+    int distancia = 0;
+    if (operador == QUERY_NEAR) {
+        printf("Distância máxima: ");
+        fflush(stdout);
+        if (!fgets(opcao, sizeof(opcao), stdin)) return;
+        distancia = atoi(opcao);
+        if (distancia < 0) distancia = 0;
+    }
+    
+    printf("Termos (separados por espaço, até %d): ", QUERY_MAX_TERMS);
+    fflush(stdout);
+    if (!fgets(linha, sizeof(linha), stdin)) return;
+    linha[strcspn(linha, "\n")] = '\0';
+    
+    const char* termos[QUERY_MAX_TERMS];
+    int num_termos = 0;
+    for (char* termo = strtok(linha, " \t"); termo && num_termos < QUERY_MAX_TERMS; termo = strtok(NULL, " \t")) {
+        termos[num_termos++] = termo;
+    }
+    if (num_termos == 0) {
+        printf("Nenhum termo informado.\n");
+        return;
+    }
+    
+    if (tipo & ESTRUTURA_HASH) {
+        if (get_hash_table()) {
+            imprimir_consulta_termos("Hash", ESTRUTURA_HASH, operador, termos, num_termos, distancia);
+        } else {
+            printf("A tabela hash não foi criada ainda.\n");
+        }
+    }
+    if (tipo & ESTRUTURA_TRIE) {
+        if (get_trie_root()) {
+            imprimir_consulta_termos("Trie", ESTRUTURA_TRIE, operador, termos, num_termos, distancia);
+        } else {
+            printf("A arvore trie não foi criada ainda.\n");
+        }
+    }
+}
+
+/* Busca na Trie por prefixo ("casa" ou "casa*"), curingas ("c?s*") ou intervalo ("a..c") */
+static void buscar_padrao_menu(void) {
+    TrieNode* root = get_trie_root();
+    if (!root) {
+        printf("A arvore trie não foi criada ainda.\n");
+        return;
+    }
+    
+    char padrao[MAX_WORD_SIZE * 2 + 3];
+    char resposta[16];
+    printf("Padrão (prefixo*, curingas ? e *, ou intervalo inicio..fim): ");
+    fflush(stdout);
+    if (!fgets(padrao, sizeof(padrao), stdin)) return;
+    padrao[strcspn(padrao, "\n")] = '\0';
+    
+    printf("Máximo de resultados: ");
+    fflush(stdout);
+    if (!fgets(resposta, sizeof(resposta), stdin)) return;
+    int limite = atoi(resposta);
+    if (limite <= 0) limite = 20;
+    
+    printf("Ordenar por número de ocorrências? (s/n): ");
+    fflush(stdout);
+    if (!fgets(resposta, sizeof(resposta), stdin)) return;
+    
+    TrieMatch pedido = {TRIE_MATCH_PREFIX, padrao, NULL, NULL, resposta[0] == 's' || resposta[0] == 'S'};
+    char* intervalo = strstr(padrao, "..");
+    size_t len = strlen(padrao);
+    if (intervalo) {
+        // Lados vazios do intervalo não têm limite
+        *intervalo = '\0';
+        pedido.type = TRIE_MATCH_RANGE;
+        pedido.low = padrao[0] ? padrao : NULL;
+        pedido.high = intervalo[2] ? intervalo + 2 : NULL;
+    } else if (strcspn(padrao, "?*") < (len ? len - 1 : 0) || (len > 0 && padrao[len - 1] == '?')) {
+        pedido.type = TRIE_MATCH_WILDCARD;
+    } else if (len > 0 && padrao[len - 1] == '*') {
+        padrao[len - 1] = '\0';  // Prefixo seguido de '*'
+    }
+    
+    TrieWord* resultados = malloc(limite * sizeof(TrieWord));
+    if (!resultados) {
+        printf("Erro de alocação de memória para os resultados.\n");
+        return;
+    }
+    int total;
+    int n = trie_match(root, &pedido, resultados, limite, &total);
+    if (n < 0) {
+        printf("Padrão inválido (até %d símbolos).\n", MATCH_MAX_PATTERN);
+    } else {
+        for (int i = 0; i < n; i++) {
+            printf("%s (%d ocorrências)\n", resultados[i].word, resultados[i].num_occurrences);
+        }
+        printf("%d de %d palavra(s) encontrada(s).\n", n, total);
+    }
+    free(resultados);
 }
\ No newline at end of file
@@ -0,0 +1,301 @@
+/**
+ * @file match.c
+ * @brief Consultas por prefixo, curinga e intervalo sobre a Trie
+ *
+ * Curingas e intervalos usam a mesma busca em profundidade com pilha explícita:
+ * cada quadro guarda o nó, o próximo filho a examinar, a profundidade e um
+ * estado de 64 bits, que é
+ * - no curinga, o conjunto de posições ativas do padrão (simulação do autômato
+ *   não determinístico do padrão; '*' mantém sua posição e libera a seguinte)
+ * - no intervalo, se o caminho ainda coincide com low e/ou com high
+ *
+ * Um nó é emitido antes dos filhos, e os filhos são visitados em ordem de símbolo,
+ * de modo que os resultados já saem na ordem de trie_compare_words.
+ */
+
+#include "match.h"
+#include "normalize.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define MATCH_SIMBOLO_QUALQUER -2  //'?'
+#define MATCH_SIMBOLO_ESTRELA -3   //'*'
+
+#define MATCH_LOW 1u   //Caminho igual ao início de low
+#define MATCH_HIGH 2u  //Caminho igual ao início de high
+
+//Resultados acumulados de uma consulta
+typedef struct {
+    TrieWord* results;
+    int* ordem;  //Ordem alfabética de cada resultado (desempate do top-k)
+    int max;
+    int count;
+    int total;
+    int top_k;
+    int contar_todos;
+} Coletor;
+
+//Quadro da busca em profundidade
+typedef struct {
+    uint32_t node;
+    int next_child;
+    int depth;
+    uint64_t state;
+} MatchFrame;
+
+//Padrão ou limites de intervalo já convertidos em símbolos da Trie
+typedef struct {
+    TrieMatchType type;
+    signed char simbolos[MAX_WORD_SIZE];
+    int num_simbolos;
+    signed char low[MAX_WORD_SIZE];
+    int low_len;
+    signed char high[MAX_WORD_SIZE];
+    int high_len;
+} MatchPlan;
+
+//No top-k, a é pior que b se tem menos ocorrências ou, no empate, vem depois
+static int pior(const Coletor* c, int a, int b) {
+    int na = c->results[a].num_occurrences, nb = c->results[b].num_occurrences;
+    return na < nb || (na == nb && c->ordem[a] > c->ordem[b]);
+}
+
+static void trocar(Coletor* c, int a, int b) {
+    TrieWord w = c->results[a];
+    c->results[a] = c->results[b];
+    c->results[b] = w;
+    int o = c->ordem[a];
+    c->ordem[a] = c->ordem[b];
+    c->ordem[b] = o;
+}
+
+//Desce o elemento i no heap mínimo results[0..n) (o pior fica no topo)
+static void descer(Coletor* c, int i, int n) {
+    for (;;) {
+        int menor = i, e = 2 * i + 1, d = 2 * i + 2;
+        if (e < n && pior(c, e, menor)) menor = e;
+        if (d < n && pior(c, d, menor)) menor = d;
+        if (menor == i) return;
+        trocar(c, i, menor);
+        i = menor;
+    }
+}
+
+//Registra uma palavra encontrada; retorna 0 quando a busca pode parar
+static int coletar(Coletor* c, const TrieWord* w) {
+    int ordem = c->total++;
+    if (!c->top_k) {
+        if (c->count < c->max) c->results[c->count++] = *w;
+        return c->count < c->max || c->contar_todos;
+    }
+    if (c->max == 0) return 1;
+
+    if (c->count < c->max) {
+        //Sobe o novo elemento no heap
+        int i = c->count++;
+        c->results[i] = *w;
+        c->ordem[i] = ordem;
+        while (i > 0 && pior(c, i, (i - 1) / 2)) {
+            trocar(c, i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    } else if (w->num_occurrences > c->results[0].num_occurrences) {
+        //Substitui o pior (no empate, o mais antigo vem antes e permanece)
+        c->results[0] = *w;
+        c->ordem[0] = ordem;
+        descer(c, 0, c->count);
+    }
+    return 1;
+}
+
+//Ordena o heap do melhor para o pior
+static void ordenar_top_k(Coletor* c) {
+    for (int n = c->count; n > 1; n--) {
+        trocar(c, 0, n - 1);
+        descer(c, 0, n - 1);
+    }
+}
+
+static void preencher(const TrieNode* node, TrieWord* out) {
+    out->word = node->original_word;
+    out->occurrences = node->packed_occurrences ? NULL : node->occurrences;
+    out->num_occurrences = node->num_occurrences;
+    posting_cursor_init(&out->postings, out->occurrences, node->packed_occurrences, node->num_occurrences);
+}
+
+//Converte uma palavra nos símbolos da Trie (0-25 letras, 26 hífen)
+static int converter_limite(const char* palavra, signed char* out) {
+    char key[MAX_WORD_SIZE];
+    int len = trie_normalize_word(palavra, key, MAX_WORD_SIZE);
+    for (int i = 0; i < len; i++) out[i] = (signed char)(key[i] == '-' ? 26 : key[i] - 'a');
+    return len;
+}
+
+//Converte o padrão, juntando '*' consecutivos; retorna 0 se for longo demais
+static int converter_padrao(const char* padrao, MatchPlan* plan) {
+    plan->num_simbolos = 0;
+    const char* ptr = padrao;
+    while (*ptr) {
+        int simbolo, char_len = 1;
+        if (*ptr == '?') {
+            simbolo = MATCH_SIMBOLO_QUALQUER;
+        } else if (*ptr == '*') {
+            simbolo = MATCH_SIMBOLO_ESTRELA;
+        } else {
+            simbolo = normalize_next_index(ptr, &char_len);
+            if (char_len == 0) break;
+        }
+        ptr += char_len;
+        if (simbolo == -1) continue;  //Fora do alfabeto, como nas palavras
+        if (simbolo == MATCH_SIMBOLO_ESTRELA && plan->num_simbolos > 0 &&
+            plan->simbolos[plan->num_simbolos - 1] == MATCH_SIMBOLO_ESTRELA) continue;
+        if (plan->num_simbolos == MATCH_MAX_PATTERN) return 0;
+        plan->simbolos[plan->num_simbolos++] = (signed char)simbolo;
+    }
+    return 1;
+}
+
+//Fecha o conjunto de estados: um '*' ativo também ativa a posição seguinte
+static uint64_t fechar_estados(const MatchPlan* plan, uint64_t estados) {
+    for (int i = 0; i < plan->num_simbolos; i++) {
+        if ((estados >> i & 1u) && plan->simbolos[i] == MATCH_SIMBOLO_ESTRELA) estados |= (uint64_t)1 << (i + 1);
+    }
+    return estados;
+}
+
+//Estados do padrão depois de consumir o símbolo c
+static uint64_t avancar_estados(const MatchPlan* plan, uint64_t estados, int c) {
+    uint64_t novos = 0;
+    for (int i = 0; i < plan->num_simbolos; i++) {
+        if (!(estados >> i & 1u)) continue;
+        int s = plan->simbolos[i];
+        if (s == MATCH_SIMBOLO_ESTRELA) novos |= (uint64_t)1 << i;
+        else if (s == MATCH_SIMBOLO_QUALQUER || s == c) novos |= (uint64_t)1 << (i + 1);
+    }
+    return fechar_estados(plan, novos);
+}
+
+//O nó (caminho de profundidade depth) satisfaz a consulta?
+static int aceita(const MatchPlan* plan, const MatchFrame* f) {
+    if (plan->type == TRIE_MATCH_WILDCARD) return (int)(f->state >> plan->num_simbolos & 1u);
+    //Um prefixo próprio de low vem antes de low
+    return !((f->state & MATCH_LOW) && f->depth < plan->low_len);
+}
+
+//Estado do filho c, ou 0 se o ramo pode ser abandonado
+static int estado_filho(const MatchPlan* plan, const MatchFrame* f, int c, uint64_t* estado) {
+    if (plan->type == TRIE_MATCH_WILDCARD) {
+        *estado = avancar_estados(plan, f->state, c);
+        return *estado != 0;
+    }
+
+    uint64_t s = f->state;
+    if (s & MATCH_LOW) {
+        if (f->depth < plan->low_len && c < plan->low[f->depth]) return 0;
+        if (f->depth >= plan->low_len || c > plan->low[f->depth]) s &= ~(uint64_t)MATCH_LOW;
+    }
+    if (s & MATCH_HIGH) {
+        if (f->depth >= plan->high_len || c > plan->high[f->depth]) return 0;
+        if (c < plan->high[f->depth]) s &= ~(uint64_t)MATCH_HIGH;
+    }
+    *estado = s;
+    return 1;
+}
+
+//Busca em profundidade com pilha explícita para curingas e intervalos
+static int percorrer(const TrieNode* root, const MatchPlan* plan, uint64_t estado_raiz, Coletor* coletor) {
+    int capacidade = 64, topo = 0;
+    MatchFrame* pilha = malloc(capacidade * sizeof(MatchFrame));
+    if (!pilha) {
+        fprintf(stderr, "Erro de alocação de memória para a consulta\n");
+        return 0;
+    }
+    pilha[topo++] = (MatchFrame){0, -1, 0, estado_raiz};
+
+    int continuar = 1;
+    while (topo > 0 && continuar) {
+        MatchFrame* f = &pilha[topo - 1];
+        const TrieNode* node = trie_node_at(root, f->node);
+
+        if (f->next_child < 0) {
+            f->next_child = 0;
+            if (node->is_end_of_word && aceita(plan, f)) {
+                TrieWord w;
+                preencher(node, &w);
+                continuar = coletar(coletor, &w);
+                continue;
+            }
+        }
+
+        //Próximo filho cujo ramo ainda pode conter resultados
+        uint64_t estado = 0;
+        int c = f->next_child;
+        while (c < 27 && (!node->children[c] || !estado_filho(plan, f, c, &estado))) c++;
+        if (c == 27) {
+            topo--;
+            continue;
+        }
+        f->next_child = c + 1;
+
+        if (topo == capacidade) {
+            MatchFrame* nova = realloc(pilha, capacidade * 2 * sizeof(MatchFrame));
+            if (!nova) {
+                fprintf(stderr, "Erro de alocação de memória para a consulta\n");
+                free(pilha);
+                return 0;
+            }
+            pilha = nova;
+            capacidade *= 2;
+            f = &pilha[topo - 1];
+        }
+        pilha[topo++] = (MatchFrame){node->children[c], -1, f->depth + 1, estado};
+    }
+
+    free(pilha);
+    return 1;
+}
+
+int trie_match(const TrieNode* root, const TrieMatch* query, TrieWord* results, int max_results, int* total) {
+    if (total) *total = 0;
+    if (!query || max_results < 0 || (max_results > 0 && !results)) return -1;
+    if (!root) return 0;
+
+    Coletor coletor = {results, NULL, max_results, 0, 0, query->top_k, total != NULL};
+    if (query->top_k && max_results > 0) {
+        coletor.ordem = malloc(max_results * sizeof(int));
+        if (!coletor.ordem) {
+            fprintf(stderr, "Erro de alocação de memória para a consulta\n");
+            return -1;
+        }
+    }
+    //Sem top-k e sem total, nenhum resultado pedido encerra a busca de imediato
+    int ok = 1, continuar = coletor.top_k || coletor.contar_todos || max_results > 0;
+
+    if (query->type == TRIE_MATCH_PREFIX) {
+        TrieCursor cursor;
+        TrieWord w;
+        trie_cursor_begin(&cursor, root, query->pattern);
+        while (continuar && trie_cursor_next(&cursor, &w)) continuar = coletar(&coletor, &w);
+        trie_cursor_end(&cursor);
+    } else if (continuar) {
+        MatchPlan plan;
+        uint64_t estado_raiz;
+        plan.type = query->type;
+        if (query->type == TRIE_MATCH_WILDCARD) {
+            ok = query->pattern && converter_padrao(query->pattern, &plan);
+            estado_raiz = ok ? fechar_estados(&plan, 1) : 0;
+        } else {
+            plan.low_len = query->low ? converter_limite(query->low, plan.low) : 0;
+            plan.high_len = query->high ? converter_limite(query->high, plan.high) : 0;
+            estado_raiz = (query->low ? MATCH_LOW : 0u) | (query->high ? MATCH_HIGH : 0u);
+        }
+        if (ok) ok = percorrer(root, &plan, estado_raiz, &coletor);
+    }
+
+    if (coletor.top_k) ordenar_top_k(&coletor);
+    free(coletor.ordem);
+    if (!ok) return -1;
+    if (total) *total = coletor.total;
+    return coletor.count;
+}
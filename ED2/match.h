@@ -0,0 +1,69 @@
+/**
+ * @file match.h
+ * @brief Consultas por prefixo, curinga e intervalo sobre a Trie
+ *
+ * Todas as consultas comparam as palavras pela chave da Trie (26 letras + hífen,
+ * sem acentos e sem distinção de caixa) e devolvem TrieWord, que aponta para os
+ * dados dos nós sem copiá-los:
+ * - TRIE_MATCH_PREFIX: palavras que começam por pattern (autocompletar); desce
+ *   direto ao nó do prefixo e percorre só a sua subárvore (TrieCursor)
+ * - TRIE_MATCH_WILDCARD: pattern com '?' (um símbolo qualquer) e '*' (zero ou mais
+ *   símbolos); a busca em profundidade carrega o conjunto de estados do padrão
+ *   (um bit por posição), abandona ramos sem estado ativo e visita cada nó uma vez
+ * - TRIE_MATCH_RANGE: palavras entre low e high (inclusive) na ordem da Trie;
+ *   só os ramos de fronteira são comparados com os limites
+ *
+ * Sem top_k, os resultados saem em ordem alfabética e a busca para assim que
+ * max_results palavras foram encontradas (a menos que total seja pedido). Com
+ * top_k, todas as palavras são examinadas e ficam as max_results com mais
+ * ocorrências (heap mínimo), em ordem decrescente de ocorrências e, no empate,
+ * alfabética.
+ *
+ * @struct TrieMatch
+ * @brief Descrição de uma consulta
+ * @var TrieMatch::type
+ *    Tipo da consulta
+ * @var TrieMatch::pattern
+ *    Prefixo ou padrão com curingas (NULL ou "" no prefixo = todas as palavras);
+ *    padrões têm até MATCH_MAX_PATTERN símbolos
+ * @var TrieMatch::low
+ *    Limite inferior do intervalo (NULL = sem limite)
+ * @var TrieMatch::high
+ *    Limite superior do intervalo (NULL = sem limite)
+ * @var TrieMatch::top_k
+ *    1 para selecionar as palavras com mais ocorrências
+ *
+ * @fn int trie_match(const TrieNode* root, const TrieMatch* query, TrieWord* results, int max_results, int* total)
+ * @brief Executa uma consulta
+ * @param results Recebe até max_results palavras
+ * @param total Recebe o número de palavras que satisfazem a consulta (pode ser NULL)
+ * @return Número de resultados gravados, ou -1 se a consulta for inválida ou faltar memória
+ */
+
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "trie.h"
+
+#define MATCH_MAX_PATTERN 63  //Símbolos de um padrão com curingas (um bit por estado)
+
+//Tipo de consulta
+typedef enum {
+    TRIE_MATCH_PREFIX,
+    TRIE_MATCH_WILDCARD,
+    TRIE_MATCH_RANGE
+} TrieMatchType;
+
+//Consulta por padrão
+typedef struct {
+    TrieMatchType type;
+    const char* pattern;
+    const char* low;
+    const char* high;
+    int top_k;
+} TrieMatch;
+
+//Protótipos das consultas por padrão
+int trie_match(const TrieNode* root, const TrieMatch* query, TrieWord* results, int max_results, int* total);
+
+#endif /* MATCH_H */
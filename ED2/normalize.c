@@ -0,0 +1,160 @@
+/**
+ * @file normalize.c
+ * @brief Implementação da normalização de palavras (UTF-8, acentos e caixa)
+ */
+
+#include "normalize.h"
+#include "indice_remissivo.h"
+
+int get_next_utf8_char(const char* str, char* buf, int max_len) {
+    if (!str || !buf || max_len <= 0) return 0;
+    
+    unsigned char first_byte = (unsigned char)str[0];
+    int char_len = 1;
+    
+    // Determina o comprimento do caractere UTF-8
+    if ((first_byte & 0x80) == 0) {
+        // ASCII (0xxxxxxx)
+        char_len = 1;
+    } else if ((first_byte & 0xE0) == 0xC0) {
+        // 2 bytes (110xxxxx 10xxxxxx)
+        char_len = 2;
+    } else if ((first_byte & 0xF0) == 0xE0) {
+        // 3 bytes (1110xxxx 10xxxxxx 10xxxxxx)
+        char_len = 3;
+    } else if ((first_byte & 0xF8) == 0xF0) {
+        // 4 bytes (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx)
+        char_len = 4;
+    }
+    
+    // Verifica se o buffer é grande o suficiente
+    if (char_len > max_len) char_len = max_len;
+
+    // Não ultrapassa o fim da string em caracteres truncados
+    for (int i = 1; i < char_len; i++) {
+        if (str[i] == '\0') {
+            char_len = i;
+            break;
+        }
+    }
+    
+    // Copia o caractere completo
+    memcpy(buf, str, char_len);
+    buf[char_len] = '\0';
+    
+    return char_len;
+}
+
+// Letra base de U+0080 a U+017F (Latin-1 Supplement e Latin Extended-A), 16 por linha.
+// '.' = sem letra base (controles, símbolos, × e ÷); ligaduras e ß ficam com a primeira
+// letra, já que cada caractere ocupa um único nível da Trie
+static const char base_latin[0x100 + 1] =
+    "................"  // U+0080 controles
+    "................"  // U+0090 controles
+    "................"  // U+00A0 símbolos (ª e º são indicadores ordinais)
+    "................"  // U+00B0 símbolos
+    "aaaaaaaceeeeiiii"  // U+00C0 ÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏ
+    "dnooooo.ouuuuyts"  // U+00D0 ÐÑÒÓÔÕÖ×ØÙÚÛÜÝÞß
+    "aaaaaaaceeeeiiii"  // U+00E0 àáâãäåæçèéêëìíîï
+    "dnooooo.ouuuuyty"  // U+00F0 ðñòóôõö÷øùúûüýþÿ
+    "aaaaaaccccccccdd"  // U+0100 ĀāĂăĄąĆćĈĉĊċČčĎď
+    "ddeeeeeeeeeegggg"  // U+0110 ĐđĒēĔĕĖėĘęĚěĜĝĞğ
+    "gggghhhhiiiiiiii"  // U+0120 ĠġĢģĤĥĦħĨĩĪīĬĭĮį
+    "iiiijjkkklllllll"  // U+0130 İıĲĳĴĵĶķĸĹĺĻļĽľĿ
+    "lllnnnnnnnnnoooo"  // U+0140 ŀŁłŃńŅņŇňŉŊŋŌōŎŏ
+    "oooorrrrrrssssss"  // U+0150 ŐőŒœŔŕŖŗŘřŚśŜŝŞş
+    "ssttttttuuuuuuuu"  // U+0160 ŠšŢţŤťŦŧŨũŪūŬŭŮů
+    "uuuuwwyyyzzzzzzs"; // U+0170 ŰűŲųŴŵŶŷŸŹźŻżŽžſ
+
+// Tamanho do caractere pelo nibble alto do primeiro byte (bytes de continuação contam 1)
+static const unsigned char tamanho_utf8[16] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 4};
+
+// Índice na Trie de cada letra base, deslocado de 1 (0 = fora do alfabeto)
+static const unsigned char indice_ascii[128] = {
+    ['-'] = 27,
+    ['A'] = 1, ['B'] = 2, ['C'] = 3, ['D'] = 4, ['E'] = 5, ['F'] = 6, ['G'] = 7,
+    ['H'] = 8, ['I'] = 9, ['J'] = 10, ['K'] = 11, ['L'] = 12, ['M'] = 13, ['N'] = 14,
+    ['O'] = 15, ['P'] = 16, ['Q'] = 17, ['R'] = 18, ['S'] = 19, ['T'] = 20, ['U'] = 21,
+    ['V'] = 22, ['W'] = 23, ['X'] = 24, ['Y'] = 25, ['Z'] = 26,
+    ['a'] = 1, ['b'] = 2, ['c'] = 3, ['d'] = 4, ['e'] = 5, ['f'] = 6, ['g'] = 7,
+    ['h'] = 8, ['i'] = 9, ['j'] = 10, ['k'] = 11, ['l'] = 12, ['m'] = 13, ['n'] = 14,
+    ['o'] = 15, ['p'] = 16, ['q'] = 17, ['r'] = 18, ['s'] = 19, ['t'] = 20, ['u'] = 21,
+    ['v'] = 22, ['w'] = 23, ['x'] = 24, ['y'] = 25, ['z'] = 26,
+};
+
+// Decodifica o caractere em s sem copiá-lo: devolve seu tamanho (mesma regra de
+// get_next_utf8_char, sem ultrapassar o '\0') e, em *base, a letra base de
+// U+0080-U+017F ou 0
+static int decodificar(const unsigned char* s, char* base) {
+    unsigned char b0 = s[0];
+    *base = 0;
+    if (b0 < 0x80) return 1;
+
+    int len = b0 >= 0xF8 ? 1 : tamanho_utf8[b0 >> 4];
+    for (int i = 1; i < len; i++) {
+        if (s[i] == '\0') return i;
+    }
+
+    //Duas sequências de 2 bytes cobrem U+0080-U+017F: C2 80 a C5 BF
+    if (len == 2 && b0 >= 0xC2 && b0 <= 0xC5 && (s[1] & 0xC0) == 0x80) {
+        int codigo = ((b0 & 0x1F) << 6) | (s[1] & 0x3F);
+        char letra = base_latin[codigo - 0x80];
+        if (letra != '.') *base = letra;
+    }
+    return len;
+}
+
+char normalize_next_char(const char* str, int* char_len) {
+    if (!str || !*str) {
+        if (char_len) *char_len = 0;
+        return '\0';
+    }
+
+    char base;
+    int len = decodificar((const unsigned char*)str, &base);
+    if (char_len) *char_len = len;
+    if (base) return base;
+
+    // Caracteres ASCII (e primeiro byte dos não mapeados)
+    return (char)tolower((unsigned char)str[0]);
+}
+
+int normalize_next_index(const char* str, int* char_len) {
+    const unsigned char* s = (const unsigned char*)str;
+    if (s[0] < 0x80) {
+        *char_len = s[0] ? 1 : 0;
+        return indice_ascii[s[0]] - 1;
+    }
+
+    char base;
+    *char_len = decodificar(s, &base);
+    return base ? base - 'a' : -1;
+}
+
+char normalize_utf8_char(const char* utf8_char) {
+    return normalize_next_char(utf8_char, NULL);
+}
+
+int normalize_key(const char* word, char* out, int max_len) {
+    if (!word || !out || max_len <= 0) return 0;
+
+    int len = 0;
+    const char* ptr = word;
+    while (*ptr) {
+        int char_len;
+        char normalized = normalize_next_char(ptr, &char_len);
+
+        //Caracteres ASCII e letras mapeadas viram um byte; os demais são copiados
+        if (char_len == 1 || (normalized >= 'a' && normalized <= 'z')) {
+            if (len + 1 > max_len - 1) break;
+            out[len++] = normalized;
+        } else {
+            if (len + char_len > max_len - 1) break;
+            memcpy(out + len, ptr, char_len);
+            len += char_len;
+        }
+        ptr += char_len;
+    }
+    out[len] = '\0';
+    return len;
+}
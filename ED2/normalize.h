@@ -0,0 +1,52 @@
+/**
+ * @file normalize.h
+ * @brief Normalização de palavras compartilhada pela tabela hash e pela Trie
+ *
+ * Todas as estruturas comparam palavras pela mesma chave normalizada:
+ * - Caracteres UTF-8 são lidos inteiros (1 a 4 bytes)
+ * - Letras de Latin-1 Supplement e Latin Extended-A (U+00C0-U+017F) são
+ *   reduzidas à letra base (ç -> c, ã -> a, ł -> l) por uma tabela, sem cópia
+ * - Letras ASCII são convertidas para minúsculas
+ *
+ * A chave geral (normalize_key) mantém os demais caracteres como estão, e é a
+ * usada pela tabela hash; a Trie restringe a mesma chave ao seu alfabeto de
+ * 26 letras + hífen (trie_normalize_word). Assim "Informação" e "informacao"
+ * são a mesma palavra nas duas estruturas.
+ *
+ * @fn int get_next_utf8_char(const char* str, char* buf, int max_len)
+ * @brief Copia o próximo caractere UTF-8 de str para buf (terminado em '\0')
+ * @return Número de bytes do caractere, ou 0 se str for inválida
+ *
+ * @fn char normalize_next_char(const char* str, int* char_len)
+ * @brief Lê o próximo caractere de str (sem copiá-lo) e o reduz à forma base
+ * @param char_len Recebe o tamanho do caractere em bytes (pode ser NULL)
+ * @return Mesmo retorno de normalize_utf8_char
+ *
+ * @fn int normalize_next_index(const char* str, int* char_len)
+ * @brief Lê o próximo caractere de str e devolve o índice do filho na Trie
+ * @param char_len Recebe o tamanho do caractere em bytes (0 no fim da string)
+ * @return 0-25 para 'a'-'z', 26 para hífen, -1 fora do alfabeto
+ *
+ * @fn char normalize_utf8_char(const char* utf8_char)
+ * @brief Reduz um caractere UTF-8 à sua forma base em minúscula
+ * @return Letra base para letras mapeadas; caso contrário, o primeiro byte
+ *         (em minúscula se for ASCII)
+ *
+ * @fn int normalize_key(const char* word, char* out, int max_len)
+ * @brief Gera a chave normalizada de uma palavra
+ * @param word Palavra original
+ * @param out Buffer de saída (terminado em '\0')
+ * @param max_len Tamanho do buffer de saída
+ * @return Tamanho da chave em bytes
+ */
+
+#ifndef NORMALIZE_H
+#define NORMALIZE_H
+
+int get_next_utf8_char(const char* str, char* buf, int max_len);
+char normalize_next_char(const char* str, int* char_len);
+int normalize_next_index(const char* str, int* char_len);
+char normalize_utf8_char(const char* utf8_char);
+int normalize_key(const char* word, char* out, int max_len);
+
+#endif /* NORMALIZE_H */
@@ -0,0 +1,282 @@
+/**
+ * @file output.c
+ * @brief Escrita do índice com buffer grande, em texto, CSV ou JSON
+ */
+
+#include "output.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+
+//Pares de dígitos "00" a "99", para converter dois dígitos por vez
+static const char pares_digitos[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int output_open(OutputWriter* out, int fd, OutputFormat format) {
+    memset(out, 0, sizeof(*out));
+    out->fd = fd;
+    out->format = format;
+    out->buffer = malloc(OUTPUT_BUFFER_SIZE);
+    if (!out->buffer) {
+        fprintf(stderr, "Erro de alocação de memória para a saída\n");
+        out->error = 1;
+        return 0;
+    }
+    out->capacity = OUTPUT_BUFFER_SIZE;
+    return 1;
+}
+
+void output_set_documents(OutputWriter* out, const DocumentSet* docs) {
+    out->docs = docs;
+}
+
+int output_parse_format(const char* name) {
+    if (!name) return -1;
+    if (strcasecmp(name, "texto") == 0 || strcasecmp(name, "plain") == 0) return OUTPUT_PLAIN;
+    if (strcasecmp(name, "csv") == 0) return OUTPUT_CSV;
+    if (strcasecmp(name, "json") == 0) return OUTPUT_JSON;
+    return -1;
+}
+
+int output_flush(OutputWriter* out) {
+    if (out->error) return 0;
+    if (out->used == 0) return 1;
+
+    //O texto do menu ainda no buffer de stdout precisa sair antes
+    if (out->fd == STDOUT_FILENO) fflush(stdout);
+
+    size_t enviado = 0;
+    while (enviado < out->used) {
+        ssize_t n = write(out->fd, out->buffer + enviado, out->used - enviado);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            fprintf(stderr, "Erro ao escrever a saída\n");
+            out->error = 1;
+            break;
+        }
+        enviado += (size_t)n;
+    }
+    out->used = 0;
+    return !out->error;
+}
+
+void output_write(OutputWriter* out, const char* data, size_t len) {
+    if (out->error) return;
+    while (len > 0) {
+        if (out->used == out->capacity && !output_flush(out)) return;
+        size_t livre = out->capacity - out->used;
+        size_t n = len < livre ? len : livre;
+        memcpy(out->buffer + out->used, data, n);
+        out->used += n;
+        data += n;
+        len -= n;
+    }
+}
+
+void output_str(OutputWriter* out, const char* s) {
+    output_write(out, s, strlen(s));
+}
+
+void output_int(OutputWriter* out, long long value) {
+    char tmp[24];
+    char* fim = tmp + sizeof(tmp);
+    char* p = fim;
+    unsigned long long v = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    while (v >= 100) {
+        unsigned int d = (unsigned int)(v % 100) * 2;
+        v /= 100;
+        *--p = pares_digitos[d + 1];
+        *--p = pares_digitos[d];
+    }
+    if (v >= 10) {
+        unsigned int d = (unsigned int)v * 2;
+        *--p = pares_digitos[d + 1];
+        *--p = pares_digitos[d];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    if (value < 0) *--p = '-';
+    output_write(out, p, (size_t)(fim - p));
+}
+
+//Nome em minúsculas (coluna e campo "indice")
+static void output_lower(OutputWriter* out, const char* s) {
+    for (; *s; s++) {
+        char c = (*s >= 'A' && *s <= 'Z') ? (char)(*s - 'A' + 'a') : *s;
+        output_write(out, &c, 1);
+    }
+}
+
+//Campo CSV: entre aspas (com aspas dobradas) só se tiver vírgula, aspas ou quebra de linha
+static void output_csv_field(OutputWriter* out, const char* s) {
+    if (!strpbrk(s, ",\"\r\n")) {
+        output_str(out, s);
+        return;
+    }
+    output_write(out, "\"", 1);
+    for (const char* p = s; *p; p++) {
+        if (*p == '"') output_write(out, "\"", 1);
+        output_write(out, p, 1);
+    }
+    output_write(out, "\"", 1);
+}
+
+//String JSON entre aspas; bytes UTF-8 passam como estão
+static void output_json_string(OutputWriter* out, const char* s) {
+    output_write(out, "\"", 1);
+    const char* inicio = s;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        output_write(out, inicio, (size_t)(s - inicio));
+        if (c == '"' || c == '\\') {
+            char esc[2] = {'\\', (char)c};
+            output_write(out, esc, 2);
+        } else {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            output_write(out, esc, 6);
+        }
+        inicio = s + 1;
+    }
+    output_write(out, inicio, (size_t)(s - inicio));
+    output_write(out, "\"", 1);
+}
+
+void output_index_begin(OutputWriter* out, const char* name) {
+    out->section = name;
+    out->words = 0;
+    out->missing = 0;
+    switch (out->format) {
+    case OUTPUT_PLAIN:
+        output_str(out, "\n=== Índice ");
+        output_str(out, name);
+        output_str(out, " ===\n");
+        break;
+    case OUTPUT_CSV:
+        if (out->sections == 0) {
+            output_str(out, out->docs ? "indice,palavra,documento,posicao\n" : "indice,palavra,posicao\n");
+        }
+        break;
+    case OUTPUT_JSON:
+        output_str(out, "{\"indice\":\"");
+        output_lower(out, name);
+        output_str(out, "\",\"palavras\":[");
+        break;
+    }
+    out->sections++;
+}
+
+void output_word_begin(OutputWriter* out, const char* word) {
+    out->word = word;
+    out->positions = 0;
+    out->doc = -1;
+    if (out->format == OUTPUT_PLAIN) {
+        output_str(out, word);
+        output_write(out, ": ", 2);
+    } else if (out->format == OUTPUT_JSON) {
+        if (out->words > 0) output_write(out, ",", 1);
+        output_str(out, "{\"palavra\":");
+        output_json_string(out, word);
+        output_str(out, out->docs ? ",\"documentos\":[" : ",\"posicoes\":[");
+    }
+    out->words++;
+}
+
+//Converte a posição global na posição local ao seu documento; ao mudar de
+//documento, fecha o anterior e abre o novo (texto e JSON)
+static int output_document(OutputWriter* out, int position) {
+    const DocumentSet* ds = out->docs;
+    int d = out->doc;
+    if (d < 0 || position < ds->partes[d]->base || position >= ds->partes[d]->base + ds->partes[d]->num_palavras) {
+        d = docs_find(ds, position);
+    }
+    if (d < 0) return position;  //Fora dos documentos: fica a posição global
+
+    if (d != out->doc) {
+        if (out->format == OUTPUT_PLAIN) {
+            if (out->doc >= 0) output_write(out, "; ", 2);
+            output_str(out, ds->nomes[d]);
+            output_write(out, ": ", 2);
+        } else if (out->format == OUTPUT_JSON) {
+            if (out->doc >= 0) output_write(out, "]},", 3);
+            output_str(out, "{\"documento\":");
+            output_json_string(out, ds->nomes[d]);
+            output_str(out, ",\"posicoes\":[");
+        }
+        out->doc = d;
+        out->positions = 0;
+    }
+    return position - ds->partes[d]->base;
+}
+
+void output_position(OutputWriter* out, int position) {
+    if (out->docs) position = output_document(out, position);
+    switch (out->format) {
+    case OUTPUT_PLAIN:
+        if (out->positions > 0) output_write(out, ", ", 2);
+        output_int(out, position);
+        break;
+    case OUTPUT_CSV:
+        output_lower(out, out->section);
+        output_write(out, ",", 1);
+        output_csv_field(out, out->word);
+        output_write(out, ",", 1);
+        if (out->docs) {
+            if (out->doc >= 0) output_csv_field(out, out->docs->nomes[out->doc]);
+            output_write(out, ",", 1);
+        }
+        output_int(out, position);
+        output_write(out, "\n", 1);
+        break;
+    case OUTPUT_JSON:
+        if (out->positions > 0) output_write(out, ",", 1);
+        output_int(out, position);
+        break;
+    }
+    out->positions++;
+}
+
+void output_word_end(OutputWriter* out) {
+    if (out->format == OUTPUT_PLAIN) output_write(out, "\n", 1);
+    else if (out->format == OUTPUT_JSON) output_str(out, out->docs && out->doc >= 0 ? "]}]}" : "]}");
+}
+
+void output_missing(OutputWriter* out, const char* word) {
+    switch (out->format) {
+    case OUTPUT_PLAIN:
+        output_str(out, word);
+        output_str(out, ": Não foi encontrada no texto.\n");
+        break;
+    case OUTPUT_CSV:
+        output_lower(out, out->section);
+        output_write(out, ",", 1);
+        output_csv_field(out, word);
+        output_str(out, out->docs ? ",,\n" : ",\n");
+        break;
+    case OUTPUT_JSON:
+        output_str(out, out->missing == 0 ? "],\"ausentes\":[" : ",");
+        output_json_string(out, word);
+        break;
+    }
+    out->missing++;
+}
+
+void output_index_end(OutputWriter* out) {
+    if (out->format == OUTPUT_JSON) output_str(out, out->missing == 0 ? "],\"ausentes\":[]}\n" : "]}\n");
+}
+
+int output_close(OutputWriter* out) {
+    int ok = output_flush(out);
+    free(out->buffer);
+    out->buffer = NULL;
+    out->used = out->capacity = 0;
+    return ok;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file output.h
+ * @brief Escrita do índice com buffer grande, em texto, CSV ou JSON
+ *
+ * A saída é acumulada em um buffer de OUTPUT_BUFFER_SIZE bytes e enviada ao
+ * descritor com write() só quando ele enche ou no fechamento, de modo que um
+ * índice comum sai em uma única chamada de sistema. Os números são convertidos
+ * sem printf, dois dígitos por vez com uma tabela.
+ *
+ * Cada índice é uma seção (output_index_begin ... output_index_end) com as
+ * palavras, suas posições e as palavras-chave ausentes:
+ * - OUTPUT_PLAIN: o formato do menu ("palavra: p1, p2" e "palavra: Não foi
+ *   encontrada no texto.")
+ * - OUTPUT_CSV: uma linha "indice,palavra,posicao" por ocorrência (cabeçalho só
+ *   na primeira seção); palavras ausentes têm a posição vazia
+ * - OUTPUT_JSON: um objeto por linha e por seção,
+ *   {"indice":"hash","palavras":[{"palavra":"casa","posicoes":[1,5]}],"ausentes":["x"]}
+ *
+ * Com uma coleção de documentos (output_set_documents), cada posição global é
+ * escrita como o par (documento, posição local ao documento):
+ * - OUTPUT_PLAIN: "palavra: a.txt: p1, p2; b.txt: p3"
+ * - OUTPUT_CSV: "indice,palavra,documento,posicao"
+ * - OUTPUT_JSON: {"palavra":"casa","documentos":[{"documento":"a.txt","posicoes":[1,5]}]}
+ *
+ * Antes de escrever no descritor da saída padrão, o buffer de stdout é
+ * esvaziado, para que o texto do menu (printf) e o índice saiam na ordem certa.
+ *
+ * @struct OutputWriter
+ * @brief Estado de uma saída
+ * @var OutputWriter::fd
+ *    Descritor de destino (não é fechado por output_close)
+ * @var OutputWriter::buffer
+ *    Bytes pendentes (used de capacity)
+ * @var OutputWriter::error
+ *    1 depois de uma falha de escrita; as escritas seguintes são descartadas
+ * @var OutputWriter::section
+ *    Nome da seção atual (coluna indice do CSV) e word a palavra atual
+ * @var OutputWriter::sections
+ *    Seções já iniciadas (o cabeçalho CSV vai só na primeira)
+ * @var OutputWriter::words
+ *    Palavras da seção atual, positions as posições da palavra atual e missing
+ *    as palavras ausentes da seção (separadores do JSON)
+ * @var OutputWriter::docs
+ *    Documentos das posições (NULL: posições globais) e doc o documento da
+ *    posição anterior da palavra atual (-1 antes da primeira)
+ *
+ * @fn int output_open(OutputWriter* out, int fd, OutputFormat format)
+ * @brief Prepara uma saída para o descritor fd
+ * @return 1 se sucesso, 0 em falha de alocação
+ *
+ * @fn void output_set_documents(OutputWriter* out, const DocumentSet* docs)
+ * @brief Escreve as posições seguintes por documento (antes da primeira seção)
+ *
+ * @fn int output_parse_format(const char* name)
+ * @brief Converte "texto" (ou "plain"), "csv" ou "json" no formato
+ * @return Formato, ou -1 se o nome não for reconhecido
+ *
+ * @fn void output_write(OutputWriter* out, const char* data, size_t len)
+ * @brief Acrescenta bytes à saída, sem formatação
+ *
+ * @fn void output_str(OutputWriter* out, const char* s)
+ * @brief Acrescenta uma string terminada em '\0'
+ *
+ * @fn void output_int(OutputWriter* out, long long value)
+ * @brief Acrescenta um inteiro em decimal
+ *
+ * @fn void output_index_begin(OutputWriter* out, const char* name)
+ * @brief Inicia a seção de um índice ("Hash", "Trie"; em minúsculas no CSV e no JSON)
+ *
+ * @fn void output_word_begin(OutputWriter* out, const char* word)
+ * @brief Inicia uma palavra; as posições vêm em seguida por output_position
+ *
+ * @fn void output_missing(OutputWriter* out, const char* word)
+ * @brief Registra uma palavra-chave ausente (depois de todas as palavras da seção)
+ *
+ * @fn int output_flush(OutputWriter* out)
+ * @brief Envia o conteúdo do buffer ao descritor
+ * @return 1 se nenhuma escrita falhou até aqui
+ *
+ * @fn int output_close(OutputWriter* out)
+ * @brief Esvazia o buffer e libera a saída
+ * @return 1 se nenhuma escrita falhou
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+#include "docs.h"
+
+#define OUTPUT_BUFFER_SIZE (1 << 20)  //Bytes acumulados antes de cada write()
+
+//Formatos de saída do índice
+typedef enum {
+    OUTPUT_PLAIN,
+    OUTPUT_CSV,
+    OUTPUT_JSON
+} OutputFormat;
+
+//Saída com buffer
+typedef struct {
+    int fd;
+    OutputFormat format;
+    char* buffer;
+    size_t used;
+    size_t capacity;
+    int error;
+    const char* section;
+    const char* word;
+    int sections;
+    int words;
+    int positions;
+    int missing;
+    const DocumentSet* docs;
+    int doc;
+} OutputWriter;
+
+//Protótipos da saída com buffer
+int output_open(OutputWriter* out, int fd, OutputFormat format);
+void output_set_documents(OutputWriter* out, const DocumentSet* docs);
+int output_parse_format(const char* name);
+void output_write(OutputWriter* out, const char* data, size_t len);
+void output_str(OutputWriter* out, const char* s);
+void output_int(OutputWriter* out, long long value);
+int output_flush(OutputWriter* out);
+int output_close(OutputWriter* out);
+
+//Protótipos das seções de índice
+void output_index_begin(OutputWriter* out, const char* name);
+void output_word_begin(OutputWriter* out, const char* word);
+void output_position(OutputWriter* out, int position);
+void output_word_end(OutputWriter* out);
+void output_missing(OutputWriter* out, const char* word);
+void output_index_end(OutputWriter* out);
+
+#endif /* OUTPUT_H */
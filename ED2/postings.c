@@ -0,0 +1,322 @@
+/*
+ * @file postings.c
+ * @brief Implementação do repositório compacto de listas de posições
+ *
+ * Todas as listas de posições ficam em uma única arena de inteiros. Cada lista
+ * ocupa exatamente (tamanho + 1) inteiros: o slot 0 guarda o contador e os
+ * slots seguintes as posições, na ordem em que foram acrescentadas.
+ *
+ * Características principais:
+ * - Uma única alocação para todas as listas (em vez de uma por palavra)
+ * - Listas de tamanho exato, reservadas após a contagem das ocorrências
+ * - Descritor (deslocamento, tamanho) por palavra distinta
+ * - Crescimento da arena por duplicação
+ *
+ * Também contém o codec de listas compactadas (delta + zigzag + varint), o
+ * cursor que permite ler listas brutas e compactadas pela mesma interface e os
+ * kernels de interseção usados pelas consultas com vários termos.
+ *
+ * @note Como a arena pode ser realocada, as visões retornadas por
+ * postings_view() só devem ser guardadas depois que todas as listas
+ * tiverem sido reservadas.
+ */
+
+#include "postings.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <limits.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Cria um novo repositório de posições
+PostingStore* postings_create(int num_lists_hint) {
+    PostingStore* ps = (PostingStore*)malloc(sizeof(PostingStore));
+    if (ps == NULL) {
+        fprintf(stderr, "Erro de alocação de memória para PostingStore\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ps->max_descs = num_lists_hint > 0 ? num_lists_hint : 16;
+    ps->num_descs = 0;
+    ps->descs = (PostingDesc*)malloc(ps->max_descs * sizeof(PostingDesc));
+    ps->arena_capacity = (size_t)ps->max_descs * 2;
+    ps->arena_size = 0;
+    ps->arena = (int*)malloc(ps->arena_capacity * sizeof(int));
+    if (ps->descs == NULL || ps->arena == NULL) {
+        free(ps->descs);
+        free(ps->arena);
+        free(ps);
+        fprintf(stderr, "Erro de alocação de memória para arena de posições\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return ps;
+}
+
+//Reserva uma lista de tamanho exato na arena
+int postings_reserve(PostingStore* ps, int length) {
+    if (!ps || length < 0) return -1;
+
+    //Expande o array de descritores se necessário
+    if (ps->num_descs >= ps->max_descs) {
+        int new_max = ps->max_descs * 2;
+        PostingDesc* new_descs = (PostingDesc*)realloc(ps->descs, new_max * sizeof(PostingDesc));
+        if (new_descs == NULL) {
+            fprintf(stderr, "Erro ao realocar descritores de posições\n");
+            return -1;
+        }
+        ps->descs = new_descs;
+        ps->max_descs = new_max;
+    }
+
+    //Expande a arena se necessário (slot extra para o contador)
+    size_t needed = ps->arena_size + (size_t)length + 1;
+    if (needed > ps->arena_capacity) {
+        size_t new_capacity = ps->arena_capacity * 2;
+        while (new_capacity < needed) new_capacity *= 2;
+        int* new_arena = (int*)realloc(ps->arena, new_capacity * sizeof(int));
+        if (new_arena == NULL) {
+            fprintf(stderr, "Erro ao realocar arena de posições\n");
+            return -1;
+        }
+        ps->arena = new_arena;
+        ps->arena_capacity = new_capacity;
+    }
+
+    int id = ps->num_descs++;
+    ps->descs[id].offset = ps->arena_size;
+    ps->descs[id].length = length;
+    ps->arena[ps->arena_size] = 0;  //Contador inicial
+    ps->arena_size = needed;
+
+    return id;
+}
+
+//Acrescenta uma posição ao final da lista
+int postings_append(PostingStore* ps, int id, int position) {
+    if (!ps || id < 0 || id >= ps->num_descs) return 0;
+
+    int* list = ps->arena + ps->descs[id].offset;
+    if (list[0] >= ps->descs[id].length) return 0;
+
+    list[++list[0]] = position;
+    return 1;
+}
+
+//Retorna a visão da lista (slot 0 = contador)
+int* postings_view(const PostingStore* ps, int id) {
+    if (!ps || id < 0 || id >= ps->num_descs) return NULL;
+    return ps->arena + ps->descs[id].offset;
+}
+
+//Destrói o repositório
+void postings_destroy(PostingStore* ps) {
+    if (ps == NULL) return;
+
+    free(ps->arena);
+    free(ps->descs);
+    free(ps);
+}
+
+//Codifica um delta com zigzag (números negativos viram ímpares pequenos)
+static unsigned int zigzag_encode(int delta) {
+    return ((unsigned int)delta << 1) ^ (unsigned int)(delta >> 31);
+}
+
+static int zigzag_decode(unsigned int value) {
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+//Compacta uma lista de posições em deltas varint
+int postings_pack(const int* positions, int count, unsigned char** packed) {
+    if (!packed || count < 0 || (count > 0 && !positions)) return -1;
+
+    //Pior caso: 5 bytes por valor de 32 bits
+    unsigned char* buffer = (unsigned char*)malloc((size_t)count * 5 + 1);
+    if (buffer == NULL) {
+        fprintf(stderr, "Erro de alocação de memória para lista compactada\n");
+        return -1;
+    }
+
+    int size = 0;
+    int last = 0;
+    for (int i = 0; i < count; i++) {
+        unsigned int value = zigzag_encode(positions[i] - last);
+        last = positions[i];
+        while (value >= 0x80) {
+            buffer[size++] = (unsigned char)(value | 0x80);
+            value >>= 7;
+        }
+        buffer[size++] = (unsigned char)value;
+    }
+
+    //Reduz o buffer para o tamanho exato
+    unsigned char* exact = (unsigned char*)realloc(buffer, size > 0 ? size : 1);
+    *packed = exact ? exact : buffer;
+    return size;
+}
+
+//Descompacta uma lista inteira
+int postings_unpack(const unsigned char* packed, int count, int* positions) {
+    PostingCursor cur;
+    posting_cursor_init(&cur, NULL, packed, count);
+
+    int n = 0;
+    while (posting_cursor_next(&cur, &positions[n])) n++;
+    return n;
+}
+
+//Inicializa o cursor de leitura
+void posting_cursor_init(PostingCursor* cur, const int* raw, const unsigned char* packed, int count) {
+    cur->raw = raw;
+    cur->packed = packed;
+    cur->remaining = (raw || packed) ? count : 0;
+    cur->last = 0;
+}
+
+//Lê a próxima posição da lista
+int posting_cursor_next(PostingCursor* cur, int* position) {
+    if (cur->remaining <= 0) return 0;
+    cur->remaining--;
+
+    if (cur->raw) {
+        *position = *cur->raw++;
+        return 1;
+    }
+
+    unsigned int value = 0;
+    int shift = 0;
+    unsigned char byte;
+    do {
+        byte = *cur->packed++;
+        value |= (unsigned int)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    cur->last += zigzag_decode(value);
+    *position = cur->last;
+    return 1;
+}
+
+//Intercala k listas ordenadas. k é pequeno (uma lista por thread), então a menor
+//cabeça é escolhida por varredura linear em vez de um heap
+int postings_merge(const int* const lists[], const int counts[], int k, int* out) {
+    int heads[k > 0 ? k : 1];
+    for (int i = 0; i < k; i++) heads[i] = 0;
+
+    int n = 0;
+    for (;;) {
+        int best = -1;
+        for (int i = 0; i < k; i++) {
+            if (heads[i] < counts[i] &&
+                (best < 0 || lists[i][heads[i]] < lists[best][heads[best]])) {
+                best = i;
+            }
+        }
+        if (best < 0) break;
+
+        int position = lists[best][heads[best]++];
+        if (n == 0 || out[n - 1] != position) out[n++] = position;
+    }
+    return n;
+}
+
+//Primeiro índice i >= from com list[i] >= target: passos dobrando a partir de
+//from e busca binária no último passo
+static int gallop(const int* list, int n, int from, int target) {
+    int step = 1, lo = from, hi = from;
+    while (hi < n && list[hi] < target) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    if (hi > n) hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (list[mid] < target) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+//Interseção por galloping: small é percorrida, large é saltada. shift é somado
+//às posições de small para compará-las com large; out recebe as de a (base)
+static int intersect_gallop(const int* small, int ns, const int* large, int nl,
+                            int shift, int base_is_small, int* out) {
+    int n = 0, j = 0;
+    for (int i = 0; i < ns && j < nl; i++) {
+        j = gallop(large, nl, j, small[i] + shift);
+        if (j < nl && large[j] == small[i] + shift) {
+            out[n++] = base_is_small ? small[i] : large[j];
+        }
+    }
+    return n;
+}
+
+//Intercalação escalar de a com (b - offset), a partir de i e j
+static int intersect_merge(const int* a, int na, const int* b, int nb, int offset,
+                           int i, int j, int* out, int n) {
+    while (i < na && j < nb) {
+        int x = a[i], y = b[j] - offset;
+        if (x < y) i++;
+        else if (x > y) j++;
+        else {
+            out[n++] = x;
+            i++;
+            j++;
+        }
+    }
+    return n;
+}
+
+int postings_intersect(const int* a, int na, const int* b, int nb, int offset, int* out) {
+    if (na <= 0 || nb <= 0) return 0;
+
+    //Tamanhos desproporcionais: galloping na lista maior
+    if ((long long)nb >= (long long)na * POSTINGS_GALLOP_RATIO) {
+        return intersect_gallop(a, na, b, nb, offset, 1, out);
+    }
+    if ((long long)na >= (long long)nb * POSTINGS_GALLOP_RATIO) {
+        return intersect_gallop(b, nb, a, na, -offset, 0, out);
+    }
+
+    int i = 0, j = 0, n = 0;
+#if defined(__SSE2__)
+    //Blocos de 4 x 4: compara o bloco de a com as quatro rotações do bloco de b.
+    //Como as listas não têm repetições, cada posição de a casa no máximo uma vez
+    const __m128i deslocamento = _mm_set1_epi32(offset);
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(b + j)), deslocamento);
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        for (int k = 0; k < 4; k++) {
+            if (mask >> k & 1) out[n++] = a[i + k];
+        }
+
+        int max_a = a[i + 3], max_b = b[j + 3] - offset;
+        if (max_a <= max_b) i += 4;
+        if (max_b <= max_a) j += 4;
+    }
+#endif
+    return intersect_merge(a, na, b, nb, offset, i, j, out, n);
+}
+
+int postings_near(const int* a, int na, const int* b, int nb, int distance, int* out) {
+    if (na <= 0 || nb <= 0 || distance < 0) return 0;
+
+    //A janela [p - distance, p + distance] só avança: cada limite inferior é
+    //procurado por galloping a partir do anterior
+    int n = 0, j = 0;
+    for (int i = 0; i < na; i++) {
+        long long inicio = (long long)a[i] - distance;
+        j = gallop(b, nb, j, inicio < INT_MIN ? INT_MIN : (int)inicio);
+        if (j == nb) break;
+        if ((long long)b[j] <= (long long)a[i] + distance) out[n++] = a[i];
+    }
+    return n;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file postings.h
+ * @brief Armazenamento compacto de listas de posições (posting lists)
+ *
+ * Este arquivo contém as definições e protótipos de funções para um repositório
+ * de listas de posições que guarda todas as listas em uma única arena contígua.
+ * Cada palavra distinta possui um descritor (deslocamento, tamanho) que aponta
+ * para uma lista de tamanho exato dentro da arena.
+ *
+ * O primeiro elemento de cada lista é o contador de posições, mantendo a mesma
+ * visão "contador no slot 0" utilizada por processar_texto e pelos índices.
+ *
+ * @struct PostingDesc
+ * @brief Descritor de uma lista de posições dentro da arena
+ * @var PostingDesc::offset
+ * Deslocamento do slot do contador na arena
+ * @var PostingDesc::length
+ * Capacidade da lista (número máximo de posições)
+ *
+ * @struct PostingStore
+ * @brief Arena compartilhada com todas as listas de posições
+ * @var PostingStore::arena
+ * Array contíguo com todas as listas
+ * @var PostingStore::arena_size
+ * Número de inteiros utilizados na arena
+ * @var PostingStore::arena_capacity
+ * Capacidade atual da arena
+ * @var PostingStore::descs
+ * Array de descritores, indexado pelo identificador da lista
+ * @var PostingStore::num_descs
+ * Número de listas reservadas
+ * @var PostingStore::max_descs
+ * Capacidade do array de descritores
+ *
+ * @fn PostingStore* postings_create(int num_lists_hint)
+ * @brief Cria um repositório vazio
+ * @param num_lists_hint Estimativa do número de listas (pode ser 0)
+ * @return Ponteiro para o repositório criado
+ *
+ * @fn int postings_reserve(PostingStore* ps, int length)
+ * @brief Reserva uma lista com capacidade exata na arena
+ * @param ps Ponteiro para o repositório
+ * @param length Número de posições que a lista vai conter
+ * @return Identificador da lista ou -1 em caso de falha
+ *
+ * @fn int postings_append(PostingStore* ps, int id, int position)
+ * @brief Acrescenta uma posição ao final de uma lista reservada
+ * @return 1 se sucesso, 0 se a lista já está cheia
+ *
+ * @fn int* postings_view(const PostingStore* ps, int id)
+ * @brief Retorna a visão da lista com o contador no slot 0
+ * @note O ponteiro é invalidado por novas reservas (a arena pode ser realocada)
+ *
+ * @fn void postings_destroy(PostingStore* ps)
+ * @brief Libera toda a memória do repositório
+ *
+ * @section compactacao Listas compactadas
+ * Listas de ocorrências podem ser guardadas no formato compacto: cada posição é
+ * codificada como a diferença (delta) para a anterior, em varint de 7 bits por
+ * byte. Os deltas passam por zigzag, de modo que listas fora de ordem continuam
+ * válidas (apenas ocupam mais bytes).
+ *
+ * @struct PostingCursor
+ * @brief Cursor de leitura sobre uma lista bruta (int*) ou compactada
+ *
+ * @fn int postings_pack(const int* positions, int count, unsigned char** packed)
+ * @brief Compacta uma lista de posições
+ * @param positions Array com as posições
+ * @param count Número de posições
+ * @param packed Recebe o buffer compactado (tamanho exato, liberar com free)
+ * @return Número de bytes do buffer compactado ou -1 em caso de falha
+ *
+ * @fn int postings_unpack(const unsigned char* packed, int count, int* positions)
+ * @brief Descompacta uma lista em um array com espaço para count posições
+ * @return Número de posições decodificadas
+ *
+ * @fn void posting_cursor_init(PostingCursor* cur, const int* raw, const unsigned char* packed, int count)
+ * @brief Inicializa um cursor; usa raw se não for NULL, senão packed
+ *
+ * @fn int posting_cursor_next(PostingCursor* cur, int* position)
+ * @brief Avança o cursor
+ * @return 1 se uma posição foi lida, 0 no fim da lista
+ *
+ * @fn int postings_merge(const int* const lists[], const int counts[], int k, int* out)
+ * @brief Intercala k listas ordenadas (k-way merge), descartando posições repetidas
+ * @param out Array com espaço para a soma de counts
+ * @return Número de posições escritas em out
+ *
+ * @section intersecao Interseção de listas
+ * As listas de ocorrências estão ordenadas e sem repetições, então consultas com
+ * vários termos são interseções de listas. O kernel é escolhido pelos tamanhos:
+ * - Listas desproporcionais (razão >= POSTINGS_GALLOP_RATIO): cada posição da
+ *   menor é procurada na maior por busca exponencial (galloping) a partir da
+ *   última posição encontrada, em O(m log(n/m))
+ * - Listas densas e parecidas: blocos de 4 x 4 posições comparados com SSE2
+ *   (todas as rotações do bloco de b), avançando o bloco de menor máximo
+ * - Sem SSE2: intercalação escalar
+ *
+ * @fn int postings_intersect(const int* a, int na, const int* b, int nb, int offset, int* out)
+ * @brief Posições p de a tais que p + offset está em b (offset = 0: interseção comum)
+ * @param out Array com espaço para min(na, nb) posições (pode ser a própria a)
+ * @return Número de posições escritas em out, em ordem crescente
+ *
+ * @fn int postings_near(const int* a, int na, const int* b, int nb, int distance, int* out)
+ * @brief Posições p de a com alguma posição q de b tal que |p - q| <= distance
+ * @param out Array com espaço para na posições (pode ser a própria a)
+ * @return Número de posições escritas em out, em ordem crescente
+ */
+
+#ifndef POSTINGS_H
+#define POSTINGS_H
+
+#include <stddef.h>
+
+#define POSTINGS_GALLOP_RATIO 32  //Razão de tamanhos a partir da qual a interseção usa galloping
+
+//Definição do descritor de uma lista de posições
+typedef struct {
+    size_t offset;
+    int length;
+} PostingDesc;
+
+//Definição do repositório de listas de posições
+typedef struct {
+    int* arena;
+    size_t arena_size;
+    size_t arena_capacity;
+    PostingDesc* descs;
+    int num_descs;
+    int max_descs;
+} PostingStore;
+
+//Definição do cursor de leitura de listas de ocorrências
+typedef struct {
+    const int* raw;
+    const unsigned char* packed;
+    int remaining;
+    int last;
+} PostingCursor;
+
+//Protótipos das funções do repositório de posições
+PostingStore* postings_create(int num_lists_hint);
+int postings_reserve(PostingStore* ps, int length);
+int postings_append(PostingStore* ps, int id, int position);
+int* postings_view(const PostingStore* ps, int id);
+void postings_destroy(PostingStore* ps);
+
+//Protótipos das funções de compactação e leitura
+int postings_pack(const int* positions, int count, unsigned char** packed);
+int postings_unpack(const unsigned char* packed, int count, int* positions);
+void posting_cursor_init(PostingCursor* cur, const int* raw, const unsigned char* packed, int count);
+int posting_cursor_next(PostingCursor* cur, int* position);
+int postings_merge(const int* const lists[], const int counts[], int k, int* out);
+
+//Protótipos das funções de interseção
+int postings_intersect(const int* a, int na, const int* b, int nb, int offset, int* out);
+int postings_near(const int* a, int na, const int* b, int nb, int distance, int* out);
+
+#endif /* POSTINGS_H */
@@ -0,0 +1,296 @@
+/**
+ * @file query.c
+ * @brief Consultas concorrentes com troca de índice por épocas
+ *
+ * Protocolo:
+ * - query_begin(): slot = época corrente; depois lê o instantâneo corrente
+ * - query_end(): slot = 0 (inativo)
+ * - query_index_publish(): troca o instantâneo, avança a época para E e espera
+ *   até que todo slot esteja inativo ou anunciado em época >= E
+ *
+ * Todas as operações atômicas usam ordem sequencialmente consistente: se um
+ * leitor obteve o instantâneo antigo, sua época anunciada (menor que E) é vista
+ * por quem publica, que então espera o query_end() correspondente.
+ *
+ * As consultas com vários termos (query_terms) leem as listas de ocorrências
+ * dentro da seção de leitura: listas brutas são usadas diretamente e só as
+ * compactadas são decodificadas. A combinação usa os kernels de postings.h
+ * (interseção com galloping/SSE2, vizinhança e intercalação).
+ */
+
+#include "query.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+//Slot de um leitor, em uma linha de cache própria para evitar falso compartilhamento
+struct QueryReader {
+    _Alignas(64) _Atomic uint64_t epoch;  //0 = fora de seção de leitura
+    atomic_int in_use;
+    QueryIndex* index;
+};
+
+struct QueryIndex {
+    QueryReader readers[QUERY_MAX_READERS];
+    _Atomic(QuerySnapshot*) current;
+    _Atomic uint64_t epoch;
+    pthread_mutex_t writer;  //Serializa as publicações (nunca tomado pelos leitores)
+};
+
+QueryIndex* query_index_create(void) {
+    size_t size = (sizeof(QueryIndex) + 63) & ~(size_t)63;
+    QueryIndex* idx = aligned_alloc(64, size);
+    QuerySnapshot* snapshot = calloc(1, sizeof(QuerySnapshot));
+    if (!idx || !snapshot || pthread_mutex_init(&idx->writer, NULL) != 0) {
+        fprintf(stderr, "Erro de alocação de memória para índice de consulta\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < QUERY_MAX_READERS; i++) {
+        atomic_init(&idx->readers[i].epoch, 0);
+        atomic_init(&idx->readers[i].in_use, 0);
+        idx->readers[i].index = idx;
+    }
+    atomic_init(&idx->current, snapshot);
+    atomic_init(&idx->epoch, 1);
+    return idx;
+}
+
+void query_index_destroy(QueryIndex* idx) {
+    if (!idx) return;
+    free(atomic_load(&idx->current));
+    pthread_mutex_destroy(&idx->writer);
+    free(idx);
+}
+
+//Espera até que nenhum leitor anunciado antes da época 'target' continue ativo
+static void query_wait_readers(QueryIndex* idx, uint64_t target) {
+    for (int i = 0; i < QUERY_MAX_READERS; i++) {
+        for (;;) {
+            uint64_t e = atomic_load(&idx->readers[i].epoch);
+            if (e == 0 || e >= target) break;
+            sched_yield();
+        }
+    }
+}
+
+int query_index_publish(QueryIndex* idx, HashTable* hash, TrieNode* trie) {
+    if (!idx) return 0;
+
+    QuerySnapshot* snapshot = malloc(sizeof(QuerySnapshot));
+    if (!snapshot) {
+        fprintf(stderr, "Erro de alocação de memória para instantâneo de consulta\n");
+        return 0;
+    }
+    snapshot->hash = hash;
+    snapshot->trie = trie;
+
+    pthread_mutex_lock(&idx->writer);
+    QuerySnapshot* old = atomic_exchange(&idx->current, snapshot);
+    uint64_t target = atomic_fetch_add(&idx->epoch, 1) + 1;
+    query_wait_readers(idx, target);
+    pthread_mutex_unlock(&idx->writer);
+
+    free(old);
+    return 1;
+}
+
+QueryReader* query_reader_register(QueryIndex* idx) {
+    if (!idx) return NULL;
+
+    for (int i = 0; i < QUERY_MAX_READERS; i++) {
+        int livre = 0;
+        if (atomic_compare_exchange_strong(&idx->readers[i].in_use, &livre, 1)) {
+            return &idx->readers[i];
+        }
+    }
+    return NULL;
+}
+
+void query_reader_unregister(QueryReader* reader) {
+    if (!reader) return;
+    atomic_store(&reader->epoch, 0);
+    atomic_store(&reader->in_use, 0);
+}
+
+const QuerySnapshot* query_begin(QueryReader* reader) {
+    atomic_store(&reader->epoch, atomic_load(&reader->index->epoch));
+    return atomic_load(&reader->index->current);
+}
+
+void query_end(QueryReader* reader) {
+    atomic_store(&reader->epoch, 0);
+}
+
+int query_search(QueryReader* reader, TipoEstrutura estrutura, const char* word,
+                 int* positions, int max_positions) {
+    if (!reader || !word) return 0;
+
+    const QuerySnapshot* snapshot = query_begin(reader);
+    PostingCursor cursor;
+    int found = 0;
+    if (estrutura == ESTRUTURA_HASH) {
+        found = hash_search_cursor(snapshot->hash, word, &cursor);
+    } else if (estrutura == ESTRUTURA_TRIE) {
+        found = trie_search_cursor(snapshot->trie, word, &cursor);
+    }
+
+    int total = 0;
+    if (found) {
+        int position;
+        while (posting_cursor_next(&cursor, &position)) {
+            if (positions && total < max_positions) positions[total] = position;
+            total++;
+        }
+    }
+    query_end(reader);
+    return total;
+}
+
+//Lista de ocorrências de um termo: a lista bruta da estrutura ou uma cópia
+//decodificada (copia != NULL, liberada pelo chamador)
+static int carregar_termo(const QuerySnapshot* snapshot, TipoEstrutura estrutura, const char* word,
+                          const int** lista, int** copia, int* count) {
+    PostingCursor cursor;
+    int found = estrutura == ESTRUTURA_HASH ? hash_search_cursor(snapshot->hash, word, &cursor)
+                                            : trie_search_cursor(snapshot->trie, word, &cursor);
+    *lista = NULL;
+    *copia = NULL;
+    *count = found ? cursor.remaining : 0;
+    if (!found || cursor.raw) {
+        *lista = found ? cursor.raw : NULL;
+        return 1;
+    }
+
+    *copia = malloc((*count > 0 ? *count : 1) * sizeof(int));
+    if (!*copia) return 0;
+    int n = 0;
+    while (posting_cursor_next(&cursor, &(*copia)[n])) n++;
+    *lista = *copia;
+    return 1;
+}
+
+//Trecho de uma lista ordenada com as posições em [inicio, fim)
+static const int* trecho_lista(const int* lista, int count, int inicio, int fim, int* n) {
+    int esq = 0, dir = count;
+    while (esq < dir) {
+        int meio = esq + (dir - esq) / 2;
+        if (lista[meio] < inicio) esq = meio + 1;
+        else dir = meio;
+    }
+    int ultimo = esq;
+    while (ultimo < count && lista[ultimo] < fim) ultimo++;
+    *n = ultimo - esq;
+    return lista + esq;
+}
+
+//Com vários documentos, AND e NEAR valem dentro de cada documento: o resultado
+//(ordenado) é agrupado por documento e cada grupo é filtrado só com as posições
+//dos termos naquele documento. Retorna o novo total
+static int filtrar_por_documento(const DocumentSet* docs, QueryOperator op, const int* listas[],
+                                 const int counts[], const int ordem[], int num_terms, int distance,
+                                 int* resultado, int total) {
+    int mantidas = 0, doc;
+    for (int inicio = 0, fim; inicio < total; inicio = fim) {
+        fim = docs_group(docs, resultado, total, inicio, &doc);
+        if (doc < 0) continue;
+        int base = docs->partes[doc]->base;
+        int limite = base + docs->partes[doc]->num_palavras;
+
+        int n = fim - inicio;
+        for (int k = 0; k < num_terms && n > 0; k++) {
+            int t = ordem[k], no_doc;
+            const int* trecho = trecho_lista(listas[t], counts[t], base, limite, &no_doc);
+            if (op == QUERY_AND) {
+                if (no_doc == 0) n = 0;  //Falta um termo neste documento
+            } else if (t != 0) {
+                n = postings_near(resultado + inicio, n, trecho, no_doc, distance, resultado + inicio);
+            }
+        }
+        memmove(resultado + mantidas, resultado + inicio, n * sizeof(int));
+        mantidas += n;
+    }
+    return mantidas;
+}
+
+int query_terms(QueryReader* reader, TipoEstrutura estrutura, QueryOperator op,
+                const char* const terms[], int num_terms, int distance,
+                const DocumentSet* docs, int* positions, int max_positions) {
+    if (!reader || !terms || num_terms < 1 || num_terms > QUERY_MAX_TERMS) return -1;
+    if (estrutura != ESTRUTURA_HASH && estrutura != ESTRUTURA_TRIE) return -1;
+    for (int t = 0; t < num_terms; t++) {
+        if (!terms[t]) return -1;
+    }
+
+    const QuerySnapshot* snapshot = query_begin(reader);
+    const int* listas[QUERY_MAX_TERMS];
+    int* copias[QUERY_MAX_TERMS];
+    int counts[QUERY_MAX_TERMS];
+    int ordem[QUERY_MAX_TERMS];  //Termos em ordem crescente de tamanho da lista
+    int ok = 1, carregados = 0;
+    long long soma = 0;
+    for (; carregados < num_terms && ok; carregados++) {
+        int t = carregados;
+        ok = carregar_termo(snapshot, estrutura, terms[t], &listas[t], &copias[t], &counts[t]);
+        soma += counts[t];
+
+        int i = t;
+        while (i > 0 && counts[ordem[i - 1]] > counts[t]) {
+            ordem[i] = ordem[i - 1];
+            i--;
+        }
+        ordem[i] = t;
+    }
+
+    int total = 0;
+    int* resultado = NULL;
+    int mais_rara = ordem[0];
+    if (ok && (op == QUERY_OR || op == QUERY_AND) && soma > 0 && (op == QUERY_OR || counts[mais_rara] > 0)) {
+        //OR e AND juntam as listas; AND exige que todos os termos ocorram
+        resultado = malloc(soma * sizeof(int));
+        ok = resultado != NULL;
+        if (ok) total = postings_merge(listas, counts, num_terms, resultado);
+        if (ok && op == QUERY_AND && docs) {
+            total = filtrar_por_documento(docs, op, listas, counts, ordem, num_terms, distance, resultado, total);
+        }
+    } else if (ok && op == QUERY_PHRASE && counts[mais_rara] > 0) {
+        //Candidatos p = q - i a partir do termo mais raro; cada outro termo j
+        //precisa ocorrer em p + j
+        resultado = malloc(counts[mais_rara] * sizeof(int));
+        ok = resultado != NULL;
+        if (ok) {
+            total = counts[mais_rara];
+            for (int i = 0; i < total; i++) resultado[i] = listas[mais_rara][i] - mais_rara;
+            for (int k = 1; k < num_terms && total > 0; k++) {
+                int t = ordem[k];
+                total = postings_intersect(resultado, total, listas[t], counts[t], t, resultado);
+            }
+        }
+    } else if (ok && op == QUERY_NEAR && counts[mais_rara] > 0) {
+        //Posições do primeiro termo, filtradas pelos demais (os mais raros primeiro)
+        resultado = malloc(counts[0] * sizeof(int));
+        ok = resultado != NULL && distance >= 0;
+        if (ok && docs) {
+            total = counts[0];
+            memcpy(resultado, listas[0], total * sizeof(int));
+            total = filtrar_por_documento(docs, op, listas, counts, ordem, num_terms, distance, resultado, total);
+        } else if (ok) {
+            total = counts[0];
+            memcpy(resultado, listas[0], total * sizeof(int));
+            for (int k = 0; k < num_terms && total > 0; k++) {
+                int t = ordem[k];
+                if (t != 0) total = postings_near(resultado, total, listas[t], counts[t], distance, resultado);
+            }
+        }
+    }
+    query_end(reader);
+
+    for (int i = 0; positions && i < total && i < max_positions; i++) positions[i] = resultado[i];
+    free(resultado);
+    for (int t = 0; t < carregados; t++) free(copias[t]);
+    return ok ? total : -1;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file query.h
+ * @brief API de consulta reentrante e concorrente sobre índices já construídos
+ *
+ * Um QueryIndex publica um instantâneo (QuerySnapshot) com a tabela hash e a
+ * Trie que devem atender às consultas. Várias threads podem consultar ao mesmo
+ * tempo, cada uma com o seu QueryReader, sem nenhuma variável global e sem
+ * travas no caminho de leitura.
+ *
+ * A troca de índice segue o esquema de épocas (estilo RCU):
+ * - O leitor anuncia a época corrente no seu slot antes de ler o instantâneo
+ *   (query_begin) e zera o slot ao terminar (query_end)
+ * - query_index_publish() troca o instantâneo atomicamente, avança a época e
+ *   espera até que nenhum leitor anunciado em época anterior continue ativo
+ * - Os leitores nunca esperam; só quem publica aguarda o período de graça
+ *
+ * As estruturas publicadas continuam pertencendo a quem as criou: quando
+ * query_index_publish() retorna, nenhum leitor pode mais ver as estruturas do
+ * instantâneo anterior, e elas podem ser destruídas com segurança.
+ *
+ * @struct QuerySnapshot
+ * @brief Estruturas visíveis aos leitores (qualquer uma pode ser NULL)
+ * @var QuerySnapshot::hash
+ * Tabela hash publicada
+ * @var QuerySnapshot::trie
+ * Raiz da Trie publicada
+ *
+ * @fn QueryIndex* query_index_create(void)
+ * @brief Cria um índice de consulta vazio
+ * @return Ponteiro para o índice criado
+ *
+ * @fn void query_index_destroy(QueryIndex* idx)
+ * @brief Libera o índice de consulta (não pode haver leitores ativos)
+ *
+ * @fn int query_index_publish(QueryIndex* idx, HashTable* hash, TrieNode* trie)
+ * @brief Publica novas estruturas e espera o fim dos leitores do instantâneo anterior
+ * @return 1 em caso de sucesso, 0 em caso de falha (o instantâneo anterior é mantido)
+ *
+ * @fn QueryReader* query_reader_register(QueryIndex* idx)
+ * @brief Reserva um slot de leitor (um por thread)
+ * @return Leitor registrado, ou NULL se todos os QUERY_MAX_READERS slots estão em uso
+ *
+ * @fn void query_reader_unregister(QueryReader* reader)
+ * @brief Devolve o slot do leitor
+ *
+ * @fn const QuerySnapshot* query_begin(QueryReader* reader)
+ * @brief Inicia uma seção de leitura e retorna o instantâneo corrente
+ * @note As estruturas só podem ser usadas até query_end(); seções não se aninham
+ *
+ * @fn void query_end(QueryReader* reader)
+ * @brief Encerra a seção de leitura
+ *
+ * @fn int query_search(QueryReader* reader, TipoEstrutura estrutura, const char* word, int* positions, int max_positions)
+ * @brief Busca uma palavra na estrutura indicada (ESTRUTURA_HASH ou ESTRUTURA_TRIE)
+ * @param positions Recebe até max_positions posições (pode ser NULL)
+ * @return Número total de ocorrências (0 se ausente ou se a estrutura não foi publicada)
+ *
+ * @fn int query_terms(QueryReader* reader, TipoEstrutura estrutura, QueryOperator op, const char* const terms[], int num_terms, int distance, const DocumentSet* docs, int* positions, int max_positions)
+ * @brief Consulta com vários termos, respondida pelas listas de ocorrências da estrutura
+ *        indicada (sem reler o texto):
+ *        - QUERY_AND: todos os termos ocorrem no mesmo documento; devolve as posições
+ *          de todos nos documentos que têm todos os termos
+ *        - QUERY_OR: posições de qualquer um dos termos
+ *        - QUERY_PHRASE: posições p em que terms[i] ocorre em p + i para todo i
+ *          (começa pela lista mais rara e intersecta as demais com deslocamento)
+ *        - QUERY_NEAR: posições p de terms[0] com cada um dos demais termos a no
+ *          máximo distance posições de p, no mesmo documento
+ * @param num_terms Número de termos (1 a QUERY_MAX_TERMS)
+ * @param docs Documentos do texto indexado (docs.h), ou NULL se o texto é um
+ *        único documento
+ * @param positions Recebe até max_positions posições em ordem crescente (pode ser NULL)
+ * @return Número total de posições do resultado, ou -1 se os parâmetros forem
+ *         inválidos ou faltar memória
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include "indice_remissivo.h"
+#include "hash.h"
+#include "trie.h"
+#include "docs.h"
+
+#define QUERY_MAX_READERS 64
+#define QUERY_MAX_TERMS 16
+
+//Operadores das consultas com vários termos
+typedef enum {
+    QUERY_AND,
+    QUERY_OR,
+    QUERY_PHRASE,
+    QUERY_NEAR
+} QueryOperator;
+
+//Instantâneo publicado para os leitores
+typedef struct {
+    HashTable* hash;
+    TrieNode* trie;
+} QuerySnapshot;
+
+typedef struct QueryIndex QueryIndex;
+typedef struct QueryReader QueryReader;
+
+//Protótipos das funções de consulta
+QueryIndex* query_index_create(void);
+void query_index_destroy(QueryIndex* idx);
+int query_index_publish(QueryIndex* idx, HashTable* hash, TrieNode* trie);
+QueryReader* query_reader_register(QueryIndex* idx);
+void query_reader_unregister(QueryReader* reader);
+const QuerySnapshot* query_begin(QueryReader* reader);
+void query_end(QueryReader* reader);
+int query_search(QueryReader* reader, TipoEstrutura estrutura, const char* word,
+                 int* positions, int max_positions);
+int query_terms(QueryReader* reader, TipoEstrutura estrutura, QueryOperator op,
+                const char* const terms[], int num_terms, int distance,
+                const DocumentSet* docs, int* positions, int max_positions);
+
+#endif /* QUERY_H */
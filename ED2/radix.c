@@ -0,0 +1,352 @@
+/**
+ * @file radix.c
+ * @brief Implementação da árvore Radix (Trie compactada por caminhos)
+ *
+ * Cada aresta guarda um rótulo com um ou mais símbolos normalizados, de modo que
+ * palavras longas não geram uma cadeia de nós com um único filho. As chaves são
+ * normalizadas com trie_normalize_word(), garantindo o mesmo comportamento da
+ * Trie para acentos, caixa e hífen.
+ *
+ * Funções principais:
+ * - radix_insert(): Insere uma palavra, dividindo arestas quando necessário
+ * - radix_search(): Busca uma palavra comparando rótulos inteiros
+ * - radix_get_all_words(): Recupera todas as palavras armazenadas
+ * - criar_indice_radix(): Cria o índice a partir do texto e das palavras-chave
+ * - imprimir_indice_radix(): Imprime o índice em ordem alfabética
+ * - imprimir_radix_arvore(): Visualiza a árvore com os rótulos das arestas
+ *
+ * Características de desempenho:
+ * - Busca e inserção: O(m), com no máximo um nó por ramificação da palavra
+ * - Espaço: O(n) nós, onde n é o número de palavras (cada inserção cria no
+ *   máximo dois nós)
+ */
+
+#include "radix.h"
+#include "trie.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+//Índice de ordenação de um símbolo normalizado (mesma ordem dos filhos da Trie)
+static int radix_symbol_index(char c) {
+    return c == '-' ? 26 : c - 'a';
+}
+
+//Cria um nó com o rótulo informado
+static RadixNode* radix_new_node(const char* label, int label_len) {
+    RadixNode* node = malloc(sizeof(RadixNode));
+    if (!node) exit(EXIT_FAILURE);
+
+    node->label = malloc(label_len + 1);
+    if (!node->label) {
+        free(node);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(node->label, label, label_len);
+    node->label[label_len] = '\0';
+    node->label_len = label_len;
+    node->children = NULL;
+    node->num_children = 0;
+    node->max_children = 0;
+    node->is_end_of_word = 0;
+    node->occurrences = NULL;
+    node->num_occurrences = 0;
+    node->max_occurrences = 0;
+    node->original_word = NULL;
+    return node;
+}
+
+RadixNode* radix_create_node(void) {
+    return radix_new_node("", 0);
+}
+
+//Procura o filho cujo rótulo começa com o símbolo c.
+//Se não existir, *slot recebe a posição de inserção que mantém a ordem
+static RadixNode* radix_find_child(RadixNode* node, char c, int* slot) {
+    int target = radix_symbol_index(c);
+    int i = 0;
+    while (i < node->num_children && radix_symbol_index(node->children[i]->label[0]) < target) {
+        i++;
+    }
+    *slot = i;
+    if (i < node->num_children && node->children[i]->label[0] == c) {
+        return node->children[i];
+    }
+    return NULL;
+}
+
+//Insere um filho na posição slot
+static int radix_add_child(RadixNode* node, RadixNode* child, int slot) {
+    if (node->num_children >= node->max_children) {
+        int new_max = node->max_children ? node->max_children * 2 : 2;
+        if (new_max > 27) new_max = 27;
+        RadixNode** new_children = realloc(node->children, new_max * sizeof(RadixNode*));
+        if (!new_children) return 0;
+        node->children = new_children;
+        node->max_children = new_max;
+    }
+
+    memmove(&node->children[slot + 1], &node->children[slot],
+            (node->num_children - slot) * sizeof(RadixNode*));
+    node->children[slot] = child;
+    node->num_children++;
+    return 1;
+}
+
+void radix_insert(RadixNode* root, const char* word, int position) {
+    if (!root || !word || position < 0) return;
+
+    char key[MAX_WORD_SIZE];
+    int len = trie_normalize_word(word, key, MAX_WORD_SIZE);
+    if (len == 0) return;
+
+    RadixNode* current = root;
+    int i = 0;
+    while (i < len) {
+        int slot;
+        RadixNode* child = radix_find_child(current, key[i], &slot);
+
+        //Nenhuma aresta começa com o símbolo: o restante da chave vira uma folha
+        if (!child) {
+            child = radix_new_node(key + i, len - i);
+            if (!radix_add_child(current, child, slot)) {
+                fprintf(stderr, "Falha ao alocar memória para nó Radix\n");
+                free(child->label);
+                free(child);
+                return;
+            }
+            current = child;
+            break;
+        }
+
+        //Tamanho do prefixo comum entre o rótulo e o restante da chave
+        int common = 0;
+        while (common < child->label_len && i + common < len &&
+               child->label[common] == key[i + common]) {
+            common++;
+        }
+
+        //Divergência no meio do rótulo: divide a aresta em duas
+        if (common < child->label_len) {
+            RadixNode* middle = radix_new_node(child->label, common);
+            memmove(child->label, child->label + common, child->label_len - common + 1);
+            child->label_len -= common;
+            if (!radix_add_child(middle, child, 0)) {
+                fprintf(stderr, "Falha ao alocar memória para nó Radix\n");
+                exit(EXIT_FAILURE);
+            }
+            current->children[slot] = middle;
+            child = middle;
+        }
+
+        current = child;
+        i += common;
+    }
+
+    current->is_end_of_word = 1;
+
+    //Armazena palavra original se necessário
+    if (!current->original_word) {
+        current->original_word = strdup(word);
+        if (!current->original_word) {
+            fprintf(stderr, "Erro ao copiar palavra original\n");
+            return;
+        }
+    }
+
+    //Expande array de ocorrências se necessário
+    if (current->num_occurrences >= current->max_occurrences) {
+        int new_max = current->max_occurrences ? current->max_occurrences * 2 : 10;
+        int* new_occurrences = realloc(current->occurrences, new_max * sizeof(int));
+        if (!new_occurrences) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            return;
+        }
+        current->occurrences = new_occurrences;
+        current->max_occurrences = new_max;
+    }
+
+    current->occurrences[current->num_occurrences++] = position;
+}
+
+int* radix_search(RadixNode* root, const char* word, int* num_occurrences) {
+    if (!num_occurrences) return NULL;
+    *num_occurrences = 0;
+    if (!root || !word) return NULL;
+
+    char key[MAX_WORD_SIZE];
+    int len = trie_normalize_word(word, key, MAX_WORD_SIZE);
+    if (len == 0) return NULL;
+
+    RadixNode* current = root;
+    int i = 0;
+    while (i < len) {
+        int slot;
+        RadixNode* child = radix_find_child(current, key[i], &slot);
+        if (!child || child->label_len > len - i ||
+            memcmp(child->label, key + i, child->label_len) != 0) {
+            return NULL;
+        }
+        current = child;
+        i += child->label_len;
+    }
+
+    if (!current->is_end_of_word) return NULL;
+
+    *num_occurrences = current->num_occurrences;
+    return current->occurrences;
+}
+
+static void radix_traverse(RadixNode* node, char*** words, int*** positions,
+                           int** num_positions, int* num_words, int* max_words) {
+    if (node->is_end_of_word) {
+        if (*num_words >= *max_words) {
+            *max_words *= 2;
+            *words = (char**)realloc(*words, *max_words * sizeof(char*));
+            *positions = (int**)realloc(*positions, *max_words * sizeof(int*));
+            *num_positions = (int*)realloc(*num_positions, *max_words * sizeof(int));
+        }
+
+        (*words)[*num_words] = strdup(node->original_word);
+        (*positions)[*num_words] = (int*)malloc((node->num_occurrences > 0 ? node->num_occurrences : 1) * sizeof(int));
+        memcpy((*positions)[*num_words], node->occurrences, node->num_occurrences * sizeof(int));
+        (*num_positions)[*num_words] = node->num_occurrences;
+        (*num_words)++;
+    }
+
+    for (int i = 0; i < node->num_children; i++) {
+        radix_traverse(node->children[i], words, positions, num_positions, num_words, max_words);
+    }
+}
+
+void radix_get_all_words(RadixNode* root, char*** words, int*** positions,
+                         int** num_positions, int* num_words, int* max_words) {
+    *num_words = 0;
+    if (root) radix_traverse(root, words, positions, num_positions, num_words, max_words);
+}
+
+void radix_destroy(RadixNode* root) {
+    if (root == NULL) return;
+
+    for (int i = 0; i < root->num_children; i++) {
+        radix_destroy(root->children[i]);
+    }
+
+    free(root->children);
+    free(root->label);
+    free(root->occurrences);
+    free(root->original_word);
+    free(root);
+}
+
+static void radix_insert_visitor(void* ctx, const char* keyword, const int* positions, int count) {
+    for (int k = 0; k < count; k++) radix_insert((RadixNode*)ctx, keyword, positions[k]);
+}
+
+//Cria o índice remissivo usando a árvore Radix: as posições de cada palavra-chave
+//(de todas as grafias com a mesma chave) são reunidas como na Trie
+int criar_indice_radix(RadixNode** root, char* const palavras[], int* const posicoes[], int num_palavras,
+                       char keywords[][MAX_WORD_SIZE], int num_keywords) {
+    if (*root != NULL) radix_destroy(*root);
+    *root = radix_create_node();
+
+    return trie_collect_keywords(palavras, posicoes, num_palavras, keywords, num_keywords,
+                                 radix_insert_visitor, *root);
+}
+
+//Estrutura auxiliar para ordenação
+typedef struct {
+    char* word;
+    int* positions;
+    int num_positions;
+} RadixWordEntry;
+
+static int compare_radix_entries(const void* a, const void* b) {
+    return trie_compare_words(((const RadixWordEntry*)a)->word, ((const RadixWordEntry*)b)->word);
+}
+
+void imprimir_indice_radix(RadixNode* root) {
+    if (root == NULL) {
+        printf("Índice radix não foi criado.\n");
+        return;
+    }
+
+    printf("\n=== Índice Radix ===\n");
+
+    int max_words = 10;
+    int num_words = 0;
+    char** words = (char**)malloc(max_words * sizeof(char*));
+    int** positions = (int**)malloc(max_words * sizeof(int*));
+    int* num_positions = (int*)malloc(max_words * sizeof(int));
+    radix_get_all_words(root, &words, &positions, &num_positions, &num_words, &max_words);
+
+    RadixWordEntry* entries = (RadixWordEntry*)malloc((num_words > 0 ? num_words : 1) * sizeof(RadixWordEntry));
+    char** sorted_words = (char**)malloc((num_words > 0 ? num_words : 1) * sizeof(char*));
+    if (!entries || !sorted_words) {
+        printf("Erro ao alocar memória para ordenação.\n");
+    } else {
+        for (int i = 0; i < num_words; i++) {
+            entries[i].word = words[i];
+            entries[i].positions = positions[i];
+            entries[i].num_positions = num_positions[i];
+        }
+        qsort(entries, num_words, sizeof(RadixWordEntry), compare_radix_entries);
+
+        //Imprime as palavras em ordem alfabética
+        for (int i = 0; i < num_words; i++) {
+            sorted_words[i] = entries[i].word;
+            printf("%s: ", entries[i].word);
+            for (int j = 0; j < entries[i].num_positions; j++) {
+                printf("%d", entries[i].positions[j]);
+                if (j < entries[i].num_positions - 1) printf(", ");
+            }
+            printf("\n");
+        }
+
+        //Palavras-chave não encontradas (busca binária nas palavras ordenadas)
+        char (*keywords)[MAX_WORD_SIZE] = get_keywords_radix();
+        int num_keywords = get_num_keywords_radix();
+        for (int i = 0; i < num_keywords; i++) {
+            if (binary_search_word(sorted_words, num_words, keywords[i]) == -1) {
+                printf("%s: Não foi encontrada no texto.\n", keywords[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_words; i++) {
+        free(words[i]);
+        free(positions[i]);
+    }
+    free(sorted_words);
+    free(entries);
+    free(words);
+    free(positions);
+    free(num_positions);
+}
+
+static void imprimir_radix_arvore_recursivo(RadixNode* node, const char* prefix, int is_last) {
+    printf("%s%s%s", prefix, is_last ? "└── " : "├── ", node->label);
+
+    if (node->is_end_of_word) {
+        printf(" -> %s", node->original_word);
+        printf(" (%d ocorrências)", node->num_occurrences);
+    }
+    printf("\n");
+
+    char new_prefix[256];
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s", prefix, is_last ? "    " : "│   ");
+    for (int i = 0; i < node->num_children; i++) {
+        imprimir_radix_arvore_recursivo(node->children[i], new_prefix, i == node->num_children - 1);
+    }
+}
+
+void imprimir_radix_arvore(RadixNode* root) {
+    if (!root) {
+        printf("Árvore Radix vazia!\n");
+        return;
+    }
+
+    printf("\n=== Estrutura da Árvore Radix ===\n");
+    imprimir_radix_arvore_recursivo(root, "", 1);
+    printf("=================================\n\n");
+}
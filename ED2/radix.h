@@ -0,0 +1,89 @@
+/**
+* @file radix.h
+* @brief Árvore Radix (Patricia) para indexação de palavras
+*
+* Variante compactada da Trie: cadeias de nós com um único filho são fundidas
+* em uma aresta rotulada com vários símbolos. As chaves usam o mesmo alfabeto
+* normalizado da Trie (26 letras + hífen, sem acentos e sem distinção de caixa),
+* de modo que os dois índices respondem igualmente às mesmas palavras-chave.
+*
+* @struct RadixNode
+* @brief Estrutura do nó da árvore Radix
+* @var RadixNode::label
+*    Rótulo da aresta que chega ao nó (símbolos normalizados)
+* @var RadixNode::label_len
+*    Tamanho do rótulo
+* @var RadixNode::children
+*    Filhos ordenados pelo índice do primeiro símbolo do rótulo (a-z, depois hífen)
+* @var RadixNode::num_children
+*    Número de filhos
+* @var RadixNode::max_children
+*    Capacidade do array de filhos
+* @var RadixNode::is_end_of_word
+*    Flag que indica se o nó representa o fim de uma palavra
+* @var RadixNode::occurrences
+*    Array com as posições onde a palavra ocorre
+* @var RadixNode::num_occurrences
+*    Número atual de ocorrências armazenadas
+* @var RadixNode::max_occurrences
+*    Capacidade máxima do array de ocorrências
+* @var RadixNode::original_word
+*    Armazena a palavra original sem modificações
+*
+* @fn RadixNode* radix_create_node(void)
+* @brief Cria a raiz de uma nova árvore Radix
+*
+* @fn void radix_insert(RadixNode* root, const char* word, int position)
+* @brief Insere uma palavra e sua posição na árvore
+*
+* @fn int* radix_search(RadixNode* root, const char* word, int* num_occurrences)
+* @brief Busca uma palavra e retorna suas ocorrências
+*
+* @fn void radix_get_all_words(RadixNode* root, char*** words, int*** positions, int** num_positions, int* num_words, int* max_words)
+* @brief Recupera todas as palavras armazenadas (mesmo contrato de trie_get_all_words)
+*
+* @fn void radix_destroy(RadixNode* root)
+* @brief Libera a memória alocada para a árvore
+*
+* @fn int criar_indice_radix(RadixNode** root, char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords)
+* @brief Cria um índice remissivo utilizando a árvore Radix (não altera palavras/posicoes)
+*
+* @fn void imprimir_indice_radix(RadixNode* root)
+* @brief Imprime o índice remissivo armazenado na árvore Radix
+*
+* @fn void imprimir_radix_arvore(RadixNode* root)
+* @brief Imprime a estrutura da árvore Radix com os rótulos das arestas
+*/
+
+#ifndef RADIX_H
+#define RADIX_H
+
+#include "indice_remissivo.h"
+
+//Definição da estrutura do nó da árvore Radix
+typedef struct RadixNode {
+    char* label;
+    int label_len;
+    struct RadixNode** children;
+    int num_children;
+    int max_children;
+    int is_end_of_word;
+    int* occurrences;
+    int num_occurrences;
+    int max_occurrences;
+    char* original_word;
+} RadixNode;
+
+//Protótipos das funções da árvore Radix
+RadixNode* radix_create_node(void);
+void radix_insert(RadixNode* root, const char* word, int position);
+int* radix_search(RadixNode* root, const char* word, int* num_occurrences);
+void radix_get_all_words(RadixNode* root, char*** words, int*** positions,
+                         int** num_positions, int* num_words, int* max_words);
+void radix_destroy(RadixNode* root);
+int criar_indice_radix(RadixNode** root, char* const palavras[], int* const posicoes[], int num_palavras,
+                       char keywords[][MAX_WORD_SIZE], int num_keywords);
+void imprimir_indice_radix(RadixNode* root);
+void imprimir_radix_arvore(RadixNode* root);
+
+#endif /* RADIX_H */
@@ -0,0 +1,145 @@
+/**
+ * @file scan.c
+ * @brief Implementação da varredura de fronteiras (AVX2, SSSE3 e escalar)
+ *
+ * As versões vetoriais são compiladas com o atributo target do GCC/Clang, de modo
+ * que o programa continua sendo compilado para x86-64 básico e só usa AVX2 ou
+ * SSSE3 quando o processador os suporta (__builtin_cpu_supports).
+ */
+
+#include "scan.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+void scan_preparar(ClasseBytes* classe, const unsigned char delimitador[256]) {
+    memcpy(classe->delimitador, delimitador, 256);
+    memset(classe->nibble_baixo, 0, sizeof(classe->nibble_baixo));
+    memset(classe->nibble_alto, 0, sizeof(classe->nibble_alto));
+
+    //Conjunto de nibbles baixos de cada nibble alto; conjuntos iguais dividem o bit
+    unsigned int conjuntos[16];
+    int num_conjuntos = 0;
+    int exata = 1;
+    for (int alto = 0; alto < 16; alto++) {
+        unsigned int conjunto = 0;
+        for (int baixo = 0; baixo < 16; baixo++) {
+            if (delimitador[alto << 4 | baixo]) conjunto |= 1u << baixo;
+        }
+        if (conjunto == 0) continue;
+
+        int bit = 0;
+        while (bit < num_conjuntos && conjuntos[bit] != conjunto) bit++;
+        if (bit == num_conjuntos) {
+            if (num_conjuntos == 8) {
+                exata = 0;  //Mais de 8 conjuntos: a versão vetorial não seria exata
+                break;
+            }
+            conjuntos[num_conjuntos++] = conjunto;
+        }
+        classe->nibble_alto[alto] = (unsigned char)(1u << bit);
+        for (int baixo = 0; baixo < 16; baixo++) {
+            if (conjunto & (1u << baixo)) classe->nibble_baixo[baixo] |= (unsigned char)(1u << bit);
+        }
+    }
+
+    classe->nivel = SCAN_ESCALAR;
+#ifdef SCAN_X86
+    if (exata) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            classe->nivel = SCAN_AVX2;
+        } else if (__builtin_cpu_supports("ssse3")) {
+            classe->nivel = SCAN_SSSE3;
+        }
+    }
+#else
+    (void)exata;
+#endif
+}
+
+#ifdef SCAN_X86
+//Procura, a partir de i, o primeiro byte cuja classe é 'alvo' (1 = delimitador), 32 bytes por vez
+__attribute__((target("avx2")))
+static size_t scan_avx2(const ClasseBytes* classe, const unsigned char* p, size_t i, size_t n, int alvo) {
+    const __m256i tabela_baixo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)classe->nibble_baixo));
+    const __m256i tabela_alto = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)classe->nibble_alto));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i baixo = _mm256_shuffle_epi8(tabela_baixo, _mm256_and_si256(v, nibble));
+        __m256i alto = _mm256_shuffle_epi8(tabela_alto, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i fora = _mm256_cmpeq_epi8(_mm256_and_si256(baixo, alto), _mm256_setzero_si256());
+        unsigned int delimitadores = ~(unsigned int)_mm256_movemask_epi8(fora);
+        unsigned int mascara = alvo ? delimitadores : ~delimitadores;
+        if (mascara) return i + (size_t)__builtin_ctz(mascara);
+    }
+    return i;
+}
+
+//Mesmo que scan_avx2, com blocos de 16 bytes
+__attribute__((target("ssse3")))
+static size_t scan_ssse3(const ClasseBytes* classe, const unsigned char* p, size_t i, size_t n, int alvo) {
+    const __m128i tabela_baixo = _mm_loadu_si128((const __m128i*)classe->nibble_baixo);
+    const __m128i tabela_alto = _mm_loadu_si128((const __m128i*)classe->nibble_alto);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i baixo = _mm_shuffle_epi8(tabela_baixo, _mm_and_si128(v, nibble));
+        __m128i alto = _mm_shuffle_epi8(tabela_alto, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i fora = _mm_cmpeq_epi8(_mm_and_si128(baixo, alto), _mm_setzero_si128());
+        unsigned int delimitadores = ~(unsigned int)_mm_movemask_epi8(fora) & 0xFFFFu;
+        unsigned int mascara = alvo ? delimitadores : ~delimitadores & 0xFFFFu;
+        if (mascara) return i + (size_t)__builtin_ctz(mascara);
+    }
+    return i;
+}
+#endif
+
+//Procura o primeiro byte da classe 'alvo'; o final (menos de um bloco) é lido pela tabela
+static size_t scan_ate(const ClasseBytes* classe, const char* dados, size_t i, size_t n, int alvo) {
+    const unsigned char* p = (const unsigned char*)dados;
+#ifdef SCAN_X86
+    if (classe->nivel == SCAN_AVX2) {
+        i = scan_avx2(classe, p, i, n, alvo);
+    } else if (classe->nivel == SCAN_SSSE3) {
+        i = scan_ssse3(classe, p, i, n, alvo);
+    }
+#endif
+    while (i < n && classe->delimitador[p[i]] != alvo) i++;
+    return i;
+}
+
+size_t scan_pular(const ClasseBytes* classe, const char* dados, size_t i, size_t n) {
+    return scan_ate(classe, dados, i, n, 0);
+}
+
+size_t scan_palavra(const ClasseBytes* classe, const char* dados, size_t i, size_t n) {
+    return scan_ate(classe, dados, i, n, 1);
+}
+
+void scan_minusculas(char* dados, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    //Comparações com sinal: bytes >= 0x80 (UTF-8) são negativos e nunca ficam entre 'A' e 'Z'.
+    //Blocos sem maiúsculas (o caso comum) não são regravados
+    const __m128i antes_a = _mm_set1_epi8('A' - 1);
+    const __m128i depois_z = _mm_set1_epi8('Z' + 1);
+    const __m128i bit_caixa = _mm_set1_epi8(0x20);
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(dados + i));
+        __m128i maiuscula = _mm_and_si128(_mm_cmpgt_epi8(v, antes_a), _mm_cmplt_epi8(v, depois_z));
+        if (_mm_movemask_epi8(maiuscula)) {
+            _mm_storeu_si128((__m128i*)(dados + i), _mm_or_si128(v, _mm_and_si128(maiuscula, bit_caixa)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if ((unsigned char)(dados[i] - 'A') < 26) dados[i] |= 0x20;
+    }
+}
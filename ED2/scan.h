@@ -0,0 +1,64 @@
+/**
+ * @file scan.h
+ * @brief Varredura vetorizada de fronteiras de palavras e conversão para minúsculas
+ *
+ * Uma ClasseBytes descreve quais bytes separam palavras (tabela de 256 posições).
+ * A partir dela, scan_preparar() monta as tabelas de nibbles usadas pela
+ * classificação vetorial: um byte b é delimitador quando
+ * nibble_baixo[b & 0xF] & nibble_alto[b >> 4] != 0. Cada conjunto distinto de
+ * nibbles baixos recebe um bit; com até 8 conjuntos a classificação é exata.
+ *
+ * Os blocos de 32 (AVX2) ou 16 (SSSE3) bytes viram uma máscara de delimitadores,
+ * e a próxima fronteira é o bit menos significativo da máscara. O conjunto de
+ * instruções é escolhido em tempo de execução; sem suporte (ou fora de x86), é
+ * usada a própria tabela, byte a byte.
+ *
+ * @struct ClasseBytes
+ * @brief Classificação dos bytes e tabelas da versão vetorial
+ * @var ClasseBytes::delimitador
+ * 1 para bytes que separam palavras
+ * @var ClasseBytes::nibble_baixo
+ * Bits dos conjuntos que contêm cada nibble baixo
+ * @var ClasseBytes::nibble_alto
+ * Bit do conjunto de nibbles baixos de cada nibble alto
+ * @var ClasseBytes::nivel
+ * Versão em uso (SCAN_ESCALAR, SCAN_SSSE3 ou SCAN_AVX2)
+ *
+ * @fn void scan_preparar(ClasseBytes* classe, const unsigned char delimitador[256])
+ * @brief Monta a classificação e escolhe a versão suportada pelo processador
+ *
+ * @fn size_t scan_pular(const ClasseBytes* classe, const char* dados, size_t i, size_t n)
+ * @brief Retorna o primeiro índice >= i que não é delimitador (ou n)
+ *
+ * @fn size_t scan_palavra(const ClasseBytes* classe, const char* dados, size_t i, size_t n)
+ * @brief Retorna o primeiro índice >= i que é delimitador (ou n)
+ *
+ * @fn void scan_minusculas(char* dados, size_t n)
+ * @brief Converte 'A'-'Z' para minúsculas no próprio buffer; bytes UTF-8
+ *        (>= 0x80) não são alterados
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stddef.h>
+
+#define SCAN_ESCALAR 0
+#define SCAN_SSSE3 1
+#define SCAN_AVX2 2
+
+//Classificação dos bytes de um texto
+typedef struct {
+    unsigned char delimitador[256];
+    unsigned char nibble_baixo[16];
+    unsigned char nibble_alto[16];
+    int nivel;
+} ClasseBytes;
+
+//Protótipos das funções de varredura
+void scan_preparar(ClasseBytes* classe, const unsigned char delimitador[256]);
+size_t scan_pular(const ClasseBytes* classe, const char* dados, size_t i, size_t n);
+size_t scan_palavra(const ClasseBytes* classe, const char* dados, size_t i, size_t n);
+void scan_minusculas(char* dados, size_t n);
+
+#endif /* SCAN_H */
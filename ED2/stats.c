@@ -0,0 +1,259 @@
+/**
+ * @file stats.c
+ * @brief Estatísticas estruturais dos índices Hash e Trie e contadores de execução
+ *
+ * Hash:
+ * - O deslocamento de cada entrada é a distância (circular) entre o slot ocupado e
+ *   a posição ideal hash & (size - 1), a mesma medida de imprimir_estrutura_hash
+ * - O custo de uma busca sem sucesso é calculado para cada slot inicial em uma
+ *   única varredura de trás para frente (distância até o próximo slot vazio)
+ *
+ * Trie:
+ * - Percurso em largura com uma fila de índices do pool (sem recursão), que dá a
+ *   profundidade de cada nó; o número de filhos vem direto do vetor children
+ */
+
+#include "stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef INDICE_STATS
+StatsAtomicCounters stats_contadores;
+#endif
+
+int hash_stats(const HashTable* ht, HashStats* out) {
+    if (!ht || !out) return 0;
+
+    memset(out, 0, sizeof(*out));
+    out->size = ht->size;
+    out->entries = ht->entries;
+    out->load_factor = ht->size ? (double)ht->entries / ht->size : 0.0;
+    out->resizes = ht->resizes;
+    out->resize_ns = ht->resize_ns;
+    out->table_bytes = sizeof(HashTable) + (size_t)ht->size * sizeof(HashEntry) +
+                       (size_t)ht->size + HASH_GROUP_WIDTH;
+
+    unsigned int mask = (unsigned int)ht->size - 1;
+    long long soma_deslocamentos = 0, soma_grupos = 0;
+    for (int i = 0; i < ht->size; i++) {
+        const HashEntry* entry = &ht->table[i];
+        if (entry->word == NULL) continue;
+
+        int dist = (int)(((unsigned int)i - (entry->hash & mask)) & mask);
+        out->probe_histogram[dist < STATS_HIST_SIZE ? dist : STATS_HIST_SIZE - 1]++;
+        if (dist > out->max_probe) out->max_probe = dist;
+        soma_deslocamentos += dist;
+        soma_grupos += dist / HASH_GROUP_WIDTH + 1;
+
+        out->occurrences += entry->num_occurrences;
+        out->word_bytes += (size_t)entry->key_len + 1 + strlen(entry->word) + 1;
+        if (entry->packed_occurrences) {
+            out->postings_bytes += (size_t)entry->packed_size;
+            out->postings_used_bytes += (size_t)entry->packed_size;
+        } else {
+            out->postings_bytes += (size_t)entry->max_occurrences * sizeof(int);
+            out->postings_used_bytes += (size_t)entry->num_occurrences * sizeof(int);
+        }
+    }
+    if (ht->entries > 0) {
+        out->mean_probe = (double)soma_deslocamentos / ht->entries;
+        out->mean_probe_groups = (double)soma_grupos / ht->entries;
+    }
+
+    //Busca sem sucesso: da posição inicial até o primeiro slot vazio (inclusive).
+    //Varre de trás para frente, com a distância do último slot vinda do início da tabela
+    if (ht->entries < ht->size) {
+        int primeiro_vazio = 0;
+        while (ht->ctrl[primeiro_vazio] != HASH_CTRL_EMPTY) primeiro_vazio++;
+
+        long long soma_falhas = 0;
+        int distancia = primeiro_vazio + 1;  //Do slot size - 1 (antes de voltar ao início)
+        for (int i = ht->size - 1; i >= 0; i--) {
+            distancia = ht->ctrl[i] == HASH_CTRL_EMPTY ? 1 : distancia + 1;
+            soma_falhas += distancia;
+        }
+        out->mean_miss_probe = (double)soma_falhas / ht->size;
+    }
+    return 1;
+}
+
+int trie_stats(const TrieNode* root, TrieStats* out) {
+    if (!root || !out) return 0;
+
+    memset(out, 0, sizeof(*out));
+    uint32_t total = trie_node_count(root);
+    uint32_t* fila = malloc(total * sizeof(uint32_t));
+    unsigned char* profundidade = malloc(total);
+    if (!fila || !profundidade) {
+        fprintf(stderr, "Erro de alocação de memória para estatísticas da Trie\n");
+        free(fila);
+        free(profundidade);
+        return 0;
+    }
+
+    //Percurso em largura: profundidades limitadas a 255 (palavras têm menos de MAX_WORD_SIZE símbolos)
+    uint32_t inicio = 0, fim = 0;
+    long long soma_filhos = 0;
+    int internos = 0;
+    fila[fim] = 0;
+    profundidade[fim++] = 0;
+    while (inicio < fim) {
+        uint32_t index = fila[inicio];
+        int nivel = profundidade[inicio++];
+        const TrieNode* node = trie_node_at(root, index);
+
+        out->nodes++;
+        out->depth_histogram[nivel < STATS_HIST_SIZE ? nivel : STATS_HIST_SIZE - 1]++;
+        if (nivel > out->max_depth) out->max_depth = nivel;
+
+        int filhos = 0;
+        for (int c = 0; c < 27; c++) {
+            if (!node->children[c] || fim >= total) continue;
+            fila[fim] = node->children[c];
+            profundidade[fim++] = (unsigned char)(nivel < 255 ? nivel + 1 : 255);
+            filhos++;
+        }
+        out->fanout_histogram[filhos]++;
+        if (filhos) {
+            soma_filhos += filhos;
+            internos++;
+        }
+
+        if (node->is_end_of_word) {
+            out->words++;
+            out->occurrences += node->num_occurrences;
+            if (node->original_word) out->word_bytes += strlen(node->original_word) + 1;
+            out->postings_bytes += node->packed_occurrences
+                ? (size_t)node->packed_size
+                : (size_t)node->max_occurrences * sizeof(int);
+        }
+    }
+    free(fila);
+    free(profundidade);
+
+    out->mean_fanout = internos ? (double)soma_filhos / internos : 0.0;
+    out->node_bytes = trie_pool_bytes(root);
+    out->bytes_per_node = (double)(out->node_bytes + out->word_bytes + out->postings_bytes) / out->nodes;
+    return 1;
+}
+
+int stats_counters_enabled(void) {
+#ifdef INDICE_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void stats_counters_read(IndexCounters* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+#ifdef INDICE_STATS
+    out->hash_inserts = atomic_load(&stats_contadores.hash_inserts);
+    out->hash_searches = atomic_load(&stats_contadores.hash_searches);
+    out->hash_hits = atomic_load(&stats_contadores.hash_hits);
+    out->hash_probe_groups = atomic_load(&stats_contadores.hash_probe_groups);
+    out->hash_key_compares = atomic_load(&stats_contadores.hash_key_compares);
+    out->hash_filter_rejects = atomic_load(&stats_contadores.hash_filter_rejects);
+    out->hash_resizes = atomic_load(&stats_contadores.hash_resizes);
+    out->trie_inserts = atomic_load(&stats_contadores.trie_inserts);
+    out->trie_searches = atomic_load(&stats_contadores.trie_searches);
+    out->trie_hits = atomic_load(&stats_contadores.trie_hits);
+    out->trie_nodes_visited = atomic_load(&stats_contadores.trie_nodes_visited);
+    out->trie_nodes_created = atomic_load(&stats_contadores.trie_nodes_created);
+#endif
+}
+
+void stats_counters_reset(void) {
+#ifdef INDICE_STATS
+    atomic_store(&stats_contadores.hash_inserts, 0);
+    atomic_store(&stats_contadores.hash_searches, 0);
+    atomic_store(&stats_contadores.hash_hits, 0);
+    atomic_store(&stats_contadores.hash_probe_groups, 0);
+    atomic_store(&stats_contadores.hash_key_compares, 0);
+    atomic_store(&stats_contadores.hash_filter_rejects, 0);
+    atomic_store(&stats_contadores.hash_resizes, 0);
+    atomic_store(&stats_contadores.trie_inserts, 0);
+    atomic_store(&stats_contadores.trie_searches, 0);
+    atomic_store(&stats_contadores.trie_hits, 0);
+    atomic_store(&stats_contadores.trie_nodes_visited, 0);
+    atomic_store(&stats_contadores.trie_nodes_created, 0);
+#endif
+}
+
+//Divisão que devolve 0 para denominador nulo
+static double razao(double a, double b) {
+    return b ? a / b : 0.0;
+}
+
+void imprimir_estatisticas_hash(const HashStats* st) {
+    if (!st) return;
+
+    printf("\n=== Estatísticas da Tabela Hash ===\n");
+    printf("Slots: %d | Entradas: %d | Fator de carga: %.3f\n", st->size, st->entries, st->load_factor);
+    printf("Ocorrências: %lld\n", st->occurrences);
+    printf("Deslocamento médio: %.3f | máximo: %d\n", st->mean_probe, st->max_probe);
+    printf("Grupos lidos por busca com sucesso: %.3f\n", st->mean_probe_groups);
+    printf("Slots examinados por busca sem sucesso: %.3f\n", st->mean_miss_probe);
+    printf("Redimensionamentos: %d (%.3f ms)\n", st->resizes, st->resize_ns / 1e6);
+
+    printf("Histograma de deslocamentos:\n");
+    for (int i = 0; i < STATS_HIST_SIZE; i++) {
+        if (st->probe_histogram[i] == 0) continue;
+        printf("  %s%2d: %d (%.1f%%)\n", i == STATS_HIST_SIZE - 1 ? ">=" : "  ", i,
+               st->probe_histogram[i], 100.0 * razao(st->probe_histogram[i], st->entries));
+    }
+
+    printf("Memória: tabela %zu B | palavras %zu B | ocorrências %zu B (%zu B ocupados)\n",
+           st->table_bytes, st->word_bytes, st->postings_bytes, st->postings_used_bytes);
+    printf("Bytes por entrada: %.1f\n",
+           razao((double)(st->table_bytes + st->word_bytes + st->postings_bytes), st->entries));
+}
+
+void imprimir_estatisticas_trie(const TrieStats* st) {
+    if (!st) return;
+
+    printf("\n=== Estatísticas da Trie ===\n");
+    printf("Nós: %u | Palavras: %d | Ocorrências: %lld\n", st->nodes, st->words, st->occurrences);
+    printf("Profundidade máxima: %d | Filhos por nó interno: %.3f\n", st->max_depth, st->mean_fanout);
+
+    printf("Nós por profundidade:\n");
+    for (int i = 0; i < STATS_HIST_SIZE; i++) {
+        if (st->depth_histogram[i] == 0) continue;
+        printf("  %s%2d: %d\n", i == STATS_HIST_SIZE - 1 ? ">=" : "  ", i, st->depth_histogram[i]);
+    }
+
+    printf("Nós por número de filhos:\n");
+    for (int i = 0; i < 28; i++) {
+        if (st->fanout_histogram[i] == 0) continue;
+        printf("  %2d: %d (%.1f%%)\n", i, st->fanout_histogram[i],
+               100.0 * razao(st->fanout_histogram[i], st->nodes));
+    }
+
+    printf("Memória: nós %zu B | palavras %zu B | ocorrências %zu B\n",
+           st->node_bytes, st->word_bytes, st->postings_bytes);
+    printf("Bytes por nó: %.1f (nó: %zu B)\n", st->bytes_per_node, sizeof(TrieNode));
+}
+
+void imprimir_contadores(const IndexCounters* c) {
+    if (!c) return;
+
+    printf("\n=== Contadores de Execução ===\n");
+    printf("Hash: %llu inserções, %llu buscas (%llu encontradas), %llu redimensionamentos\n",
+           (unsigned long long)c->hash_inserts, (unsigned long long)c->hash_searches,
+           (unsigned long long)c->hash_hits, (unsigned long long)c->hash_resizes);
+    printf("      %llu grupos sondados (%.3f por operação), %llu candidatos comparados\n",
+           (unsigned long long)c->hash_probe_groups,
+           razao((double)c->hash_probe_groups, (double)(c->hash_inserts + c->hash_searches)),
+           (unsigned long long)c->hash_key_compares);
+    printf("      %llu buscas descartadas pelo filtro de Bloom (%.1f%%)\n",
+           (unsigned long long)c->hash_filter_rejects,
+           100.0 * razao((double)c->hash_filter_rejects, (double)c->hash_searches));
+    printf("Trie: %llu inserções, %llu buscas (%llu encontradas), %llu nós criados\n",
+           (unsigned long long)c->trie_inserts, (unsigned long long)c->trie_searches,
+           (unsigned long long)c->trie_hits, (unsigned long long)c->trie_nodes_created);
+    printf("      %llu nós visitados nas buscas (%.3f por busca)\n",
+           (unsigned long long)c->trie_nodes_visited,
+           razao((double)c->trie_nodes_visited, (double)c->trie_searches));
+}
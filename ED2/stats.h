@@ -0,0 +1,183 @@
+/**
+ * @file stats.h
+ * @brief Estatísticas estruturais dos índices Hash e Trie e contadores opcionais
+ *        dos caminhos de inserção e busca
+ *
+ * hash_stats() e trie_stats() percorrem uma estrutura já criada e preenchem um
+ * registro com números (nada é impresso), para ajustar capacidade e layout. As
+ * funções imprimir_estatisticas_* apenas formatam esses registros.
+ *
+ * Os contadores de execução (IndexCounters) só existem quando o programa é compilado
+ * com -DINDICE_STATS (make STATS=1); sem a macro, STATS_ADD não gera código. Os
+ * incrementos são leitura e escrita relaxadas, sem instrução atômica de
+ * leitura-modificação-escrita: custam uma soma comum, e com várias threads
+ * inserindo ao mesmo tempo alguns incrementos podem se perder (os totais são
+ * aproximados, nunca inválidos).
+ *
+ * @struct HashStats
+ * @brief Ocupação, sondagem e memória de uma tabela hash
+ * @var HashStats::probe_histogram
+ *    Entradas por deslocamento em slots a partir da posição ideal (a última
+ *    faixa acumula os deslocamentos maiores ou iguais a STATS_HIST_SIZE - 1)
+ * @var HashStats::mean_probe
+ *    Deslocamento médio das entradas (custo de uma busca com sucesso)
+ * @var HashStats::mean_probe_groups
+ *    Média de grupos de HASH_GROUP_WIDTH bytes de controle lidos por busca com sucesso
+ * @var HashStats::mean_miss_probe
+ *    Slots examinados, em média, por uma busca sem sucesso (até o primeiro slot vazio)
+ * @var HashStats::resizes
+ *    Redimensionamentos feitos desde hash_create, e resize_ns o tempo total gasto neles
+ * @var HashStats::table_bytes
+ *    Estrutura, slots e bytes de controle
+ * @var HashStats::word_bytes
+ *    Blocos com a chave normalizada e a palavra original
+ * @var HashStats::postings_bytes
+ *    Memória reservada para as ocorrências (listas brutas e compactadas);
+ *    postings_used_bytes é a parte efetivamente ocupada
+ *
+ * @struct TrieStats
+ * @brief Forma e memória de uma Trie
+ * @var TrieStats::depth_histogram
+ *    Nós por profundidade (raiz = 0; a última faixa acumula as maiores)
+ * @var TrieStats::fanout_histogram
+ *    Nós por número de filhos (0 a 27)
+ * @var TrieStats::mean_fanout
+ *    Média de filhos dos nós internos
+ * @var TrieStats::node_bytes
+ *    Pool de nós (slabs reservados e vetor de slabs); bytes_per_node divide o
+ *    total (nós, palavras e ocorrências) pelo número de nós
+ *
+ * @struct IndexCounters
+ * @brief Contadores acumulados nos caminhos de inserção e busca
+ *
+ * @fn int hash_stats(const HashTable* ht, HashStats* out)
+ * @brief Calcula as estatísticas de uma tabela hash
+ * @return 1 se sucesso, 0 se ht ou out for NULL
+ *
+ * @fn int trie_stats(const TrieNode* root, TrieStats* out)
+ * @brief Calcula as estatísticas de uma Trie (percurso em largura, sem recursão)
+ * @return 1 se sucesso, 0 se root ou out for NULL ou em falha de alocação
+ *
+ * @fn int stats_counters_enabled(void)
+ * @brief Indica se os contadores foram compilados (INDICE_STATS)
+ *
+ * @fn void stats_counters_read(IndexCounters* out)
+ * @brief Copia os valores atuais dos contadores (zeros sem INDICE_STATS)
+ *
+ * @fn void stats_counters_reset(void)
+ * @brief Zera os contadores
+ *
+ * @fn void imprimir_estatisticas_hash(const HashStats* st)
+ * @brief Imprime as estatísticas de uma tabela hash
+ *
+ * @fn void imprimir_estatisticas_trie(const TrieStats* st)
+ * @brief Imprime as estatísticas de uma Trie
+ *
+ * @fn void imprimir_contadores(const IndexCounters* c)
+ * @brief Imprime os contadores de execução
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hash.h"
+#include "trie.h"
+
+#define STATS_HIST_SIZE 32  //Faixas dos histogramas de deslocamento e profundidade
+
+//Estatísticas de uma tabela hash
+typedef struct {
+    int size;
+    int entries;
+    double load_factor;
+    int max_probe;
+    double mean_probe;
+    double mean_probe_groups;
+    double mean_miss_probe;
+    int probe_histogram[STATS_HIST_SIZE];
+    int resizes;
+    uint64_t resize_ns;
+    long long occurrences;
+    size_t table_bytes;
+    size_t word_bytes;
+    size_t postings_bytes;
+    size_t postings_used_bytes;
+} HashStats;
+
+//Estatísticas de uma Trie
+typedef struct {
+    uint32_t nodes;
+    int words;
+    int max_depth;
+    int depth_histogram[STATS_HIST_SIZE];
+    int fanout_histogram[28];
+    double mean_fanout;
+    long long occurrences;
+    size_t node_bytes;
+    size_t word_bytes;
+    size_t postings_bytes;
+    double bytes_per_node;
+} TrieStats;
+
+//Contadores dos caminhos de inserção e busca
+typedef struct {
+    uint64_t hash_inserts;        //Localizações de entrada para inserir (hash_insert*)
+    uint64_t hash_searches;
+    uint64_t hash_hits;
+    uint64_t hash_probe_groups;   //Grupos de bytes de controle lidos
+    uint64_t hash_key_compares;   //Candidatos cujo fragmento coincidiu
+    uint64_t hash_filter_rejects; //Buscas em lote descartadas pelo filtro de Bloom
+    uint64_t hash_resizes;
+    uint64_t trie_inserts;
+    uint64_t trie_searches;
+    uint64_t trie_hits;
+    uint64_t trie_nodes_visited;  //Descidas de nível nas buscas
+    uint64_t trie_nodes_created;
+} IndexCounters;
+
+#ifdef INDICE_STATS
+#include <stdatomic.h>
+
+//Contadores globais (stats.c), com os mesmos campos de IndexCounters
+typedef struct {
+    _Atomic uint64_t hash_inserts;
+    _Atomic uint64_t hash_searches;
+    _Atomic uint64_t hash_hits;
+    _Atomic uint64_t hash_probe_groups;
+    _Atomic uint64_t hash_key_compares;
+    _Atomic uint64_t hash_filter_rejects;
+    _Atomic uint64_t hash_resizes;
+    _Atomic uint64_t trie_inserts;
+    _Atomic uint64_t trie_searches;
+    _Atomic uint64_t trie_hits;
+    _Atomic uint64_t trie_nodes_visited;
+    _Atomic uint64_t trie_nodes_created;
+} StatsAtomicCounters;
+
+extern StatsAtomicCounters stats_contadores;
+
+#define STATS_ADD(campo, n) \
+    atomic_store_explicit(&stats_contadores.campo, \
+        atomic_load_explicit(&stats_contadores.campo, memory_order_relaxed) + (uint64_t)(n), \
+        memory_order_relaxed)
+#else
+#define STATS_ADD(campo, n) ((void)(n))
+#endif
+
+//Protótipos das estatísticas estruturais
+int hash_stats(const HashTable* ht, HashStats* out);
+int trie_stats(const TrieNode* root, TrieStats* out);
+
+//Protótipos dos contadores de execução
+int stats_counters_enabled(void);
+void stats_counters_read(IndexCounters* out);
+void stats_counters_reset(void);
+
+//Protótipos de impressão
+void imprimir_estatisticas_hash(const HashStats* st);
+void imprimir_estatisticas_trie(const TrieStats* st);
+void imprimir_contadores(const IndexCounters* c);
+
+#endif /* STATS_H */
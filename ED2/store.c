@@ -0,0 +1,529 @@
+/**
+ * @file store.c
+ * @brief Tabela hash congelada e arquivo binário com os índices Hash e Trie
+ *
+ * Congelamento (hash_freeze):
+ * - Os bytes de controle e os slots ficam na mesma posição da tabela em memória,
+ *   então a busca repete a sondagem linear a partir de hash & (size - 1) e para no
+ *   primeiro slot vazio, sem recalcular posições ao gravar
+ * - Chaves normalizadas, palavras originais e posições vão para pools contíguos
+ * - order[] guarda os slots em ordem das chaves, para imprimir sem ordenar
+ *
+ * Carga (store_load):
+ * - O arquivo é mapeado com mmap (ou lido para a memória, se o mapeamento falhar)
+ * - As seções são validadas uma vez (limites, alinhamento e cada deslocamento
+ *   interno) e depois usadas diretamente no mapa, sem cópia
+ *
+ * @note A gravação usa um arquivo temporário renomeado no final, de modo que um
+ * arquivo existente (inclusive o que estiver carregado) nunca fica pela metade.
+ */
+
+#include "store.h"
+#include "normalize.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define STORE_ALIGN(x) (((x) + 7u) & ~(uint64_t)7u)
+
+//Chave de um slot ocupado, para ordenar os slots
+typedef struct {
+    const char* key;
+    uint32_t slot;
+} HashImageOrder;
+
+static int compare_order(const void* a, const void* b) {
+    return strcmp(((const HashImageOrder*)a)->key, ((const HashImageOrder*)b)->key);
+}
+
+HashImage* hash_freeze(HashTable* ht) {
+    if (!ht) return NULL;
+
+    uint32_t size = (uint32_t)ht->size;
+    uint32_t entries = 0;
+    uint64_t postings_size = 0, strings_size = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        const HashEntry* entry = &ht->table[i];
+        if (entry->word == NULL) continue;
+        entries++;
+        postings_size += entry->num_occurrences;
+        strings_size += (uint64_t)entry->key_len + 1 + strlen(entry->word) + 1;
+    }
+    if (postings_size > UINT32_MAX || strings_size > UINT32_MAX) {
+        fprintf(stderr, "Tabela hash grande demais para ser congelada\n");
+        return NULL;
+    }
+
+    //Monta o bloco contíguo
+    uint64_t offset = STORE_ALIGN(sizeof(HashImage));
+    uint64_t ctrl_off = offset;      offset = STORE_ALIGN(offset + size);
+    uint64_t slots_off = offset;     offset = STORE_ALIGN(offset + (uint64_t)size * sizeof(HashImageSlot));
+    uint64_t order_off = offset;     offset = STORE_ALIGN(offset + (uint64_t)entries * sizeof(uint32_t));
+    uint64_t postings_off = offset;  offset = STORE_ALIGN(offset + postings_size * sizeof(int32_t));
+    uint64_t strings_off = offset;   offset = STORE_ALIGN(offset + strings_size);
+
+    unsigned char* block = calloc(1, offset);
+    HashImageOrder* order = malloc((entries ? entries : 1) * sizeof(HashImageOrder));
+    if (!block || !order) {
+        fprintf(stderr, "Erro de alocação de memória para tabela hash congelada\n");
+        free(block);
+        free(order);
+        return NULL;
+    }
+
+    HashImage* img = (HashImage*)block;
+    img->magic = HASH_IMAGE_MAGIC;
+    img->version = HASH_IMAGE_VERSION;
+    img->size = size;
+    img->entries = entries;
+    img->total_size = offset;
+    img->ctrl_off = ctrl_off;
+    img->slots_off = slots_off;
+    img->order_off = order_off;
+    img->postings_off = postings_off;
+    img->strings_off = strings_off;
+
+    memcpy(block + ctrl_off, ht->ctrl, size);
+    HashImageSlot* slots = (HashImageSlot*)(block + slots_off);
+    int32_t* postings = (int32_t*)(block + postings_off);
+    char* strings = (char*)(block + strings_off);
+    uint32_t next_posting = 0, next_string = 0, num_order = 0;
+
+    for (uint32_t i = 0; i < size; i++) {
+        const HashEntry* entry = &ht->table[i];
+        if (entry->word == NULL) continue;
+
+        HashImageSlot* s = &slots[i];
+        s->hash = entry->hash;
+        s->key_len = (uint32_t)entry->key_len;
+        s->key_off = next_string;
+        memcpy(strings + next_string, entry->key, entry->key_len + 1);
+        next_string += (uint32_t)entry->key_len + 1;
+
+        size_t word_len = strlen(entry->word) + 1;
+        s->word_off = next_string;
+        memcpy(strings + next_string, entry->word, word_len);
+        next_string += (uint32_t)word_len;
+
+        //Posições brutas, decodificadas pelo cursor se a entrada estiver compactada
+        PostingCursor cur;
+        posting_cursor_init(&cur, entry->packed_occurrences ? NULL : entry->occurrences,
+                            entry->packed_occurrences, entry->num_occurrences);
+        s->postings_off = next_posting;
+        int position;
+        while (posting_cursor_next(&cur, &position)) postings[next_posting++] = position;
+        s->count = next_posting - s->postings_off;
+
+        order[num_order].key = entry->key;
+        order[num_order].slot = i;
+        num_order++;
+    }
+    img->entries = num_order;
+    img->postings_size = next_posting;
+    img->strings_size = next_string;
+
+    qsort(order, num_order, sizeof(HashImageOrder), compare_order);
+    uint32_t* sorted = (uint32_t*)(block + order_off);
+    for (uint32_t i = 0; i < num_order; i++) sorted[i] = order[i].slot;
+
+    free(order);
+    return img;
+}
+
+//Localiza o slot da palavra, ou NULL
+static const HashImageSlot* hash_image_find(const HashImage* img, const char* word) {
+    if (!img || !word || img->size == 0) return NULL;
+
+    char key[MAX_WORD_SIZE];
+    uint32_t key_len = (uint32_t)normalize_key(word, key, MAX_WORD_SIZE);
+    uint32_t hash = hash_full(word);
+
+    const unsigned char* block = (const unsigned char*)img;
+    const unsigned char* ctrl = block + img->ctrl_off;
+    const HashImageSlot* slots = (const HashImageSlot*)(block + img->slots_off);
+    const char* strings = (const char*)(block + img->strings_off);
+    uint32_t mask = img->size - 1;
+
+    //Sondagem linear até o primeiro slot vazio, como na tabela original
+    for (uint32_t i = 0, pos = hash & mask; i < img->size; i++, pos = (pos + 1) & mask) {
+        if (ctrl[pos] == HASH_CTRL_EMPTY) return NULL;
+        const HashImageSlot* s = &slots[pos];
+        if (s->hash == hash && s->key_len == key_len &&
+            (uint64_t)s->key_off + key_len < img->strings_size &&
+            memcmp(strings + s->key_off, key, key_len) == 0) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+const int* hash_image_search(const HashImage* img, const char* word, int* num_occurrences) {
+    const HashImageSlot* s = hash_image_find(img, word);
+    if (!s || (uint64_t)s->postings_off + s->count > img->postings_size) {
+        if (num_occurrences) *num_occurrences = 0;
+        return NULL;
+    }
+
+    if (num_occurrences) *num_occurrences = (int)s->count;
+    return (const int*)((const unsigned char*)img + img->postings_off) + s->postings_off;
+}
+
+size_t hash_image_size(const HashImage* img) {
+    return img ? (size_t)img->total_size : 0;
+}
+
+//Verifica se uma seção está dentro do arquivo e alinhada
+static int store_section_ok(uint64_t off, uint64_t len, size_t size) {
+    return (off & 7u) == 0 && off <= size && len <= size - off;
+}
+
+//Valida um bloco vindo de arquivo ou de mmap: além do cabeçalho, cada slot
+//ocupado e cada entrada de order[], para que as buscas e a impressão não
+//precisem conferir deslocamentos
+const HashImage* hash_image_from_buffer(const void* buffer, size_t size) {
+    if (!buffer || ((uintptr_t)buffer & 7u) != 0 || size < sizeof(HashImage)) return NULL;
+
+    const HashImage* img = (const HashImage*)buffer;
+    if (img->magic != HASH_IMAGE_MAGIC || img->version != HASH_IMAGE_VERSION ||
+        img->total_size > size) {
+        return NULL;
+    }
+
+    if (img->size == 0 || (img->size & (img->size - 1)) != 0 || img->entries > img->size ||
+        !store_section_ok(img->ctrl_off, img->size, size) ||
+        !store_section_ok(img->slots_off, (uint64_t)img->size * sizeof(HashImageSlot), size) ||
+        !store_section_ok(img->order_off, (uint64_t)img->entries * sizeof(uint32_t), size) ||
+        !store_section_ok(img->postings_off, (uint64_t)img->postings_size * sizeof(int32_t), size) ||
+        !store_section_ok(img->strings_off, img->strings_size, size)) {
+        return NULL;
+    }
+
+    const unsigned char* block = (const unsigned char*)buffer;
+    const unsigned char* ctrl = block + img->ctrl_off;
+    const HashImageSlot* slots = (const HashImageSlot*)(block + img->slots_off);
+    const uint32_t* order = (const uint32_t*)(block + img->order_off);
+    const char* strings = (const char*)(block + img->strings_off);
+
+    //Chaves e palavras terminam dentro do pool, que acaba em '\0'
+    if (img->strings_size > 0 && strings[img->strings_size - 1] != '\0') return NULL;
+
+    for (uint32_t i = 0; i < img->size; i++) {
+        if (ctrl[i] == HASH_CTRL_EMPTY) continue;
+        const HashImageSlot* s = &slots[i];
+        if ((uint64_t)s->key_off + s->key_len >= img->strings_size ||
+            strings[s->key_off + s->key_len] != '\0' || s->word_off >= img->strings_size ||
+            s->count > INT32_MAX || (uint64_t)s->postings_off + s->count > img->postings_size) {
+            return NULL;
+        }
+    }
+    for (uint32_t i = 0; i < img->entries; i++) {
+        if (order[i] >= img->size || ctrl[order[i]] == HASH_CTRL_EMPTY) return NULL;
+    }
+
+    return img;
+}
+
+void hash_image_destroy(HashImage* img) {
+    free(img);
+}
+
+//Grava len bytes e avança a posição corrente do arquivo
+static int store_write(FILE* file, const void* data, size_t len, uint64_t* pos) {
+    if (len && fwrite(data, 1, len, file) != len) return 0;
+    *pos += len;
+    return 1;
+}
+
+//Completa com zeros até a posição target
+static int store_pad(FILE* file, uint64_t target, uint64_t* pos) {
+    static const unsigned char zeros[8] = {0};
+    while (*pos < target) {
+        size_t n = target - *pos < sizeof(zeros) ? (size_t)(target - *pos) : sizeof(zeros);
+        if (!store_write(file, zeros, n, pos)) return 0;
+    }
+    return 1;
+}
+
+int store_save(const char* filename, const HashImage* hash, char keywords_hash[][MAX_WORD_SIZE],
+               int num_keywords_hash, const DoubleArrayTrie* trie,
+               char keywords_trie[][MAX_WORD_SIZE], int num_keywords_trie) {
+    if (!filename || (!hash && !trie)) return 0;
+    if (!hash) num_keywords_hash = 0;
+    if (!trie) num_keywords_trie = 0;
+
+    StoreHeader header = {0};
+    header.magic = STORE_MAGIC;
+    header.version = STORE_VERSION;
+    header.num_keywords_hash = (uint32_t)num_keywords_hash;
+    header.num_keywords_trie = (uint32_t)num_keywords_trie;
+
+    uint64_t offset = STORE_ALIGN(sizeof(StoreHeader));
+    header.keywords_hash_off = offset;
+    offset = STORE_ALIGN(offset + (uint64_t)num_keywords_hash * MAX_WORD_SIZE);
+    header.keywords_trie_off = offset;
+    offset = STORE_ALIGN(offset + (uint64_t)num_keywords_trie * MAX_WORD_SIZE);
+    if (hash) {
+        header.hash_off = offset;
+        header.hash_size = hash_image_size(hash);
+        offset = STORE_ALIGN(offset + header.hash_size);
+    }
+    if (trie) {
+        header.trie_off = offset;
+        header.trie_size = dat_size(trie);
+        offset = STORE_ALIGN(offset + header.trie_size);
+    }
+    header.file_size = offset;
+
+    //Grava em um temporário e só o renomeia depois de completo
+    size_t name_len = strlen(filename);
+    char* temp = malloc(name_len + 5);
+    if (!temp) {
+        fprintf(stderr, "Erro de alocação de memória para gravação\n");
+        return 0;
+    }
+    memcpy(temp, filename, name_len);
+    memcpy(temp + name_len, ".tmp", 5);
+
+    FILE* file = fopen(temp, "wb");
+    if (!file) {
+        fprintf(stderr, "Erro ao criar o arquivo: %s\n", temp);
+        free(temp);
+        return 0;
+    }
+
+    uint64_t pos = 0;
+    int ok = store_write(file, &header, sizeof(header), &pos) &&
+             store_pad(file, header.keywords_hash_off, &pos) &&
+             store_write(file, keywords_hash, (size_t)num_keywords_hash * MAX_WORD_SIZE, &pos) &&
+             store_pad(file, header.keywords_trie_off, &pos) &&
+             store_write(file, keywords_trie, (size_t)num_keywords_trie * MAX_WORD_SIZE, &pos);
+    if (ok && hash) {
+        ok = store_pad(file, header.hash_off, &pos) &&
+             store_write(file, hash, (size_t)header.hash_size, &pos);
+    }
+    if (ok && trie) {
+        ok = store_pad(file, header.trie_off, &pos) &&
+             store_write(file, trie, (size_t)header.trie_size, &pos);
+    }
+    ok = ok && store_pad(file, header.file_size, &pos);
+
+    if (fclose(file) != 0) ok = 0;
+    if (ok && rename(temp, filename) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Erro ao gravar o arquivo: %s\n", filename);
+        remove(temp);
+    }
+    free(temp);
+    return ok;
+}
+
+//Lê o arquivo inteiro para um bloco alocado (quando mmap não é possível)
+static void* store_read_all(int fd, size_t size) {
+    unsigned char* data = malloc(size);
+    if (!data) return NULL;
+
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = read(fd, data + done, size - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            free(data);
+            return NULL;
+        }
+        done += (size_t)n;
+    }
+    return data;
+}
+
+//Palavras-chave de uma seção: todas precisam terminar em '\0'
+static int store_keywords_ok(const unsigned char* base, uint64_t off, uint32_t count, size_t size) {
+    if (count > MAX_KEYWORDS || !store_section_ok(off, (uint64_t)count * MAX_WORD_SIZE, size)) return 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!memchr(base + off + (uint64_t)i * MAX_WORD_SIZE, '\0', MAX_WORD_SIZE)) return 0;
+    }
+    return 1;
+}
+
+IndexStore* store_load(const char* filename) {
+    if (!filename) return NULL;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erro ao abrir o arquivo: %s\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (size_t)st.st_size < sizeof(StoreHeader)) {
+        fprintf(stderr, "Arquivo de índices inválido: %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    IndexStore* store = calloc(1, sizeof(IndexStore));
+    if (!store) {
+        fprintf(stderr, "Erro de alocação de memória para arquivo de índices\n");
+        close(fd);
+        return NULL;
+    }
+    store->size = (size_t)st.st_size;
+
+    void* map = mmap(NULL, store->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+        posix_madvise(map, store->size, POSIX_MADV_RANDOM);
+        store->base = map;
+        store->mapped = 1;
+    } else {
+        store->base = store_read_all(fd, store->size);
+    }
+    close(fd);
+    if (!store->base) {
+        fprintf(stderr, "Erro ao ler o arquivo: %s\n", filename);
+        free(store);
+        return NULL;
+    }
+
+    const unsigned char* base = (const unsigned char*)store->base;
+    const StoreHeader* header = (const StoreHeader*)base;
+    int ok = header->magic == STORE_MAGIC && header->version == STORE_VERSION &&
+             header->file_size == store->size &&
+             store_keywords_ok(base, header->keywords_hash_off, header->num_keywords_hash, store->size) &&
+             store_keywords_ok(base, header->keywords_trie_off, header->num_keywords_trie, store->size);
+
+    if (ok && header->hash_off) {
+        ok = store_section_ok(header->hash_off, header->hash_size, store->size) &&
+             (store->hash = hash_image_from_buffer(base + header->hash_off, header->hash_size)) != NULL;
+    }
+    if (ok && header->trie_off) {
+        ok = store_section_ok(header->trie_off, header->trie_size, store->size) &&
+             (store->trie = dat_from_buffer(base + header->trie_off, header->trie_size)) != NULL;
+    }
+    if (!ok || (!store->hash && !store->trie)) {
+        fprintf(stderr, "Arquivo de índices inválido ou de outra versão: %s\n", filename);
+        store_close(store);
+        return NULL;
+    }
+
+    //Somente leitura: as palavras-chave apontam para o próprio mapa
+    store->keywords_hash = (char (*)[MAX_WORD_SIZE])(base + header->keywords_hash_off);
+    store->num_keywords_hash = (int)header->num_keywords_hash;
+    store->keywords_trie = (char (*)[MAX_WORD_SIZE])(base + header->keywords_trie_off);
+    store->num_keywords_trie = (int)header->num_keywords_trie;
+    return store;
+}
+
+void store_close(IndexStore* store) {
+    if (!store) return;
+    if (store->mapped) {
+        munmap(store->base, store->size);
+    } else {
+        free(store->base);
+    }
+    free(store);
+}
+
+//Escreve uma palavra e suas posições a partir dos pools de um bloco
+static void escrever_entrada(OutputWriter* out, const char* word, const int32_t* positions, uint32_t count) {
+    output_word_begin(out, word);
+    for (uint32_t j = 0; j < count; j++) output_position(out, positions[j]);
+    output_word_end(out);
+}
+
+int hash_image_write_index(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out) {
+    if (img == NULL || out == NULL) return 0;
+
+    const unsigned char* block = (const unsigned char*)img;
+    const HashImageSlot* slots = (const HashImageSlot*)(block + img->slots_off);
+    const uint32_t* order = (const uint32_t*)(block + img->order_off);
+    const int32_t* postings = (const int32_t*)(block + img->postings_off);
+    const char* strings = (const char*)(block + img->strings_off);
+
+    //Os slots já estão em ordem das chaves
+    output_index_begin(out, "Hash");
+    for (uint32_t i = 0; i < img->entries; i++) {
+        if (order[i] >= img->size) continue;
+        const HashImageSlot* s = &slots[order[i]];
+        if (s->word_off >= img->strings_size ||
+            (uint64_t)s->postings_off + s->count > img->postings_size) {
+            continue;
+        }
+        escrever_entrada(out, strings + s->word_off, postings + s->postings_off, s->count);
+    }
+
+    //Palavras-chave que não foram encontradas
+    for (int i = 0; i < num_keywords; i++) {
+        int n;
+        if (keywords[i][0] != '\0' && !hash_image_search(img, keywords[i], &n)) {
+            output_missing(out, keywords[i]);
+        }
+    }
+    output_index_end(out);
+    return !out->error;
+}
+
+void imprimir_indice_hash_imagem(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords) {
+    if (img == NULL) {
+        printf("Índice hash não criado.\n");
+        return;
+    }
+    OutputWriter out;
+    if (!output_open(&out, STDOUT_FILENO, OUTPUT_PLAIN)) return;
+    hash_image_write_index(img, keywords, num_keywords, &out);
+    output_close(&out);
+}
+
+//Visita os estados em profundidade, filhos em ordem de código: a mesma ordem
+//das chaves de trie_compare_words, então as palavras saem ordenadas
+static void escrever_estado_dat(OutputWriter* out, const DoubleArrayTrie* dat, uint32_t s, int depth) {
+    const unsigned char* block = (const unsigned char*)dat;
+    const int32_t* base = (const int32_t*)(block + dat->base_off);
+    const int32_t* check = (const int32_t*)(block + dat->check_off);
+    const int32_t* term = (const int32_t*)(block + dat->term_off);
+
+    if (term[s] >= 0 && (uint32_t)term[s] < dat->num_words) {
+        const DatWord* w = (const DatWord*)(block + dat->words_off) + term[s];
+        if (w->string_off < dat->strings_size &&
+            (uint64_t)w->postings_off + w->count <= dat->postings_size) {
+            escrever_entrada(out, (const char*)block + dat->strings_off + w->string_off,
+                             (const int32_t*)(block + dat->postings_off) + w->postings_off, w->count);
+        }
+    }
+    if (depth >= MAX_WORD_SIZE) return;
+
+    for (uint32_t code = 1; code <= 27; code++) {
+        uint32_t t = (uint32_t)base[s] + code;
+        if (t < dat->num_states && t != s && check[t] == (int32_t)s) {
+            escrever_estado_dat(out, dat, t, depth + 1);
+        }
+    }
+}
+
+int dat_write_index(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out) {
+    if (dat == NULL || out == NULL) return 0;
+
+    output_index_begin(out, "Trie");
+    escrever_estado_dat(out, dat, 0, 0);
+
+    for (int i = 0; i < num_keywords; i++) {
+        int n;
+        if (!dat_search(dat, keywords[i], &n)) output_missing(out, keywords[i]);
+    }
+    output_index_end(out);
+    return !out->error;
+}
+
+void imprimir_indice_dat(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords) {
+    if (dat == NULL) {
+        printf("Índice trie não foi criado.\n");
+        return;
+    }
+    OutputWriter out;
+    if (!output_open(&out, STDOUT_FILENO, OUTPUT_PLAIN)) return;
+    dat_write_index(dat, keywords, num_keywords, &out);
+    output_close(&out);
+}
@@ -0,0 +1,177 @@
+/**
+* @file store.h
+* @brief Gravação e carga dos índices Hash e Trie em um arquivo binário versionado
+*
+* Os índices são gravados já "congelados", em blocos contíguos sem ponteiros
+* (todas as referências são deslocamentos), de modo que carregar o arquivo é só
+* mapeá-lo com mmap e validar as seções: nenhuma estrutura é reconstruída.
+*
+* - Hash: HashImage, com os bytes de controle e os slots da tabela na mesma posição
+*   da tabela em memória, o pool de chaves/palavras e as listas de posições
+* - Trie: a double-array trie de dat.h (trie_freeze)
+*
+* Layout do arquivo (inteiros na ordem da máquina, seções alinhadas em 8 bytes):
+* - StoreHeader
+* - palavras-chave da Hash e da Trie (MAX_WORD_SIZE bytes cada)
+* - HashImage (opcional)
+* - DoubleArrayTrie (opcional)
+*
+* @struct HashImage
+* @brief Cabeçalho do bloco da tabela hash congelada; os campos *_off são
+*        deslocamentos em bytes a partir do início do bloco
+*
+* @struct HashImageSlot
+* @brief Slot da tabela: hash completo, chave normalizada, palavra original e posições
+*        (deslocamentos nos pools do bloco)
+*
+* @struct StoreHeader
+* @brief Cabeçalho do arquivo: versão e deslocamentos de cada seção
+*
+* @struct IndexStore
+* @brief Arquivo carregado (mapeado ou lido) e ponteiros para suas seções
+* @var IndexStore::base
+*    Início do arquivo em memória
+* @var IndexStore::size
+*    Tamanho do arquivo
+* @var IndexStore::mapped
+*    1 se base veio de mmap, 0 se foi lido para um bloco alocado
+* @var IndexStore::hash
+*    Tabela hash congelada, ou NULL
+* @var IndexStore::trie
+*    Double-array trie, ou NULL
+* @var IndexStore::keywords_hash
+*    Palavras-chave usadas para criar a Hash
+* @var IndexStore::keywords_trie
+*    Palavras-chave usadas para criar a Trie
+*
+* @fn HashImage* hash_freeze(HashTable* ht)
+* @brief Converte uma tabela hash construída em um bloco contíguo
+* @return Bloco alocado com malloc (liberar com hash_image_destroy) ou NULL em caso de falha
+*
+* @fn const int* hash_image_search(const HashImage* img, const char* word, int* num_occurrences)
+* @brief Busca uma palavra (mesmo contrato de hash_search)
+*
+* @fn size_t hash_image_size(const HashImage* img)
+* @brief Tamanho total do bloco em bytes
+*
+* @fn const HashImage* hash_image_from_buffer(const void* buffer, size_t size)
+* @brief Valida um bloco lido ou mapeado da memória e o retorna, ou NULL se inválido
+*
+* Confere o alinhamento e os limites das seções, os slots ocupados e order[]
+* (deslocamentos dentro dos pools); as buscas confiam no bloco validado
+*
+* @fn void hash_image_destroy(HashImage* img)
+* @brief Libera um bloco criado por hash_freeze
+*
+* @fn int store_save(const char* filename, const HashImage* hash, char keywords_hash[][MAX_WORD_SIZE], int num_keywords_hash, const DoubleArrayTrie* trie, char keywords_trie[][MAX_WORD_SIZE], int num_keywords_trie)
+* @brief Grava os índices congelados (hash e/ou trie podem ser NULL)
+* @return 1 se sucesso, 0 em falha
+*
+* @fn IndexStore* store_load(const char* filename)
+* @brief Mapeia um arquivo de índices e valida suas seções
+* @return Arquivo carregado (liberar com store_close) ou NULL se inválido
+*
+* @fn void store_close(IndexStore* store)
+* @brief Desfaz o mapeamento e libera o arquivo carregado
+*
+* @fn int hash_image_write_index(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out)
+* @brief Escreve o índice da tabela congelada em uma saída com buffer (mesma saída de hash_write_index)
+* @return 1 se sucesso, 0 se img ou out for NULL ou em falha de escrita
+*
+* @fn int dat_write_index(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out)
+* @brief Escreve o índice da double-array trie em uma saída com buffer (mesma saída de trie_write_index)
+* @return 1 se sucesso, 0 se dat ou out for NULL ou em falha de escrita
+*
+* @fn void imprimir_indice_hash_imagem(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords)
+* @brief Imprime o índice da tabela congelada (mesma saída de imprimir_indice_hash)
+*
+* @fn void imprimir_indice_dat(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords)
+* @brief Imprime o índice da double-array trie (mesma saída de imprimir_indice_trie)
+*/
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hash.h"
+#include "dat.h"
+
+#define HASH_IMAGE_MAGIC 0x314D4948u  /* "HIM1" */
+#define HASH_IMAGE_VERSION 1u
+#define STORE_MAGIC 0x31584449u       /* "IDX1" */
+#define STORE_VERSION 1u
+
+//Cabeçalho do bloco da tabela hash congelada
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;           //Número de slots (potência de dois)
+    uint32_t entries;
+    uint32_t postings_size;
+    uint32_t strings_size;
+    uint64_t total_size;
+    uint64_t ctrl_off;       //size bytes de controle (HASH_CTRL_EMPTY = vazio)
+    uint64_t slots_off;      //size HashImageSlot
+    uint64_t order_off;      //entries índices de slot, em ordem das chaves
+    uint64_t postings_off;
+    uint64_t strings_off;
+} HashImage;
+
+//Slot da tabela congelada
+typedef struct {
+    uint32_t hash;
+    uint32_t key_off;
+    uint32_t key_len;
+    uint32_t word_off;
+    uint32_t postings_off;
+    uint32_t count;
+} HashImageSlot;
+
+//Cabeçalho do arquivo de índices
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_keywords_hash;
+    uint32_t num_keywords_trie;
+    uint64_t file_size;
+    uint64_t keywords_hash_off;
+    uint64_t keywords_trie_off;
+    uint64_t hash_off;       //0 = sem índice hash
+    uint64_t hash_size;
+    uint64_t trie_off;       //0 = sem índice trie
+    uint64_t trie_size;
+} StoreHeader;
+
+//Arquivo de índices carregado
+typedef struct {
+    void* base;
+    size_t size;
+    int mapped;
+    const HashImage* hash;
+    const DoubleArrayTrie* trie;
+    char (*keywords_hash)[MAX_WORD_SIZE];
+    int num_keywords_hash;
+    char (*keywords_trie)[MAX_WORD_SIZE];
+    int num_keywords_trie;
+} IndexStore;
+
+//Protótipos da tabela hash congelada
+HashImage* hash_freeze(HashTable* ht);
+const int* hash_image_search(const HashImage* img, const char* word, int* num_occurrences);
+size_t hash_image_size(const HashImage* img);
+const HashImage* hash_image_from_buffer(const void* buffer, size_t size);
+void hash_image_destroy(HashImage* img);
+
+//Protótipos do arquivo de índices
+int store_save(const char* filename, const HashImage* hash, char keywords_hash[][MAX_WORD_SIZE],
+               int num_keywords_hash, const DoubleArrayTrie* trie,
+               char keywords_trie[][MAX_WORD_SIZE], int num_keywords_trie);
+IndexStore* store_load(const char* filename);
+void store_close(IndexStore* store);
+int hash_image_write_index(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out);
+int dat_write_index(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out);
+void imprimir_indice_hash_imagem(const HashImage* img, char keywords[][MAX_WORD_SIZE], int num_keywords);
+void imprimir_indice_dat(const DoubleArrayTrie* dat, char keywords[][MAX_WORD_SIZE], int num_keywords);
+
+#endif /* STORE_H */
@@ -10,7 +10,8 @@
  * - Preserves original word forms while using normalized forms for searching
  *
  * Key Features:
- * - Character normalization for accent-insensitive searching
+ * - Character normalization for accent-insensitive searching (shared with
+ *   the hash table through normalize.h)
  * - UTF-8 character handling
  * - Position tracking for word occurrences
  * - Tree visualization capabilities
@@ -18,17 +19,33 @@
  * - Support for special characters (like hyphens)
  *
  * Main Functions:
- * - trie_create_node(): Creates a new Trie node
+ * - trie_create_node(): Creates a new Trie (root node plus its node pool)
  * - trie_insert(): Inserts a word with its position
  * - trie_search(): Searches for a word and returns its positions
- * - criar_indice_trie(): Creates an index from text and keywords
+ * - trie_search_batch(): Searches a batch of words level by level, prefetching
+ *   the next node of every lookup in the group
+ * - criar_indice_trie(): Creates an index from text and keywords in one pass over
+ *   the tokens; a Bloom filter of the keyword keys (bloom.h) rejects most tokens
+ *   before the keyword table is probed
+ * - criar_indice_trie_paralelo(): Same, with per-thread sub-tries over token
+ *   ranges merged by a k-way merge of their sorted position lists
+ * - trie_append_indice(): Adds a new text chunk, or new keywords, to an existing
+ *   index without rebuilding it
+ * - trie_cursor_begin()/trie_cursor_next(): Lazy in-order walk (optionally from a
+ *   prefix) with an explicit stack, yielding words without copying them
  * - imprimir_trie_arvore(): Visualizes the Trie structure
- * - imprimir_indice_trie(): Displays the index contents
+ * - trie_write_index(): Writes the index to a buffered output (output.h: plain,
+ *   CSV or JSON); imprimir_indice_trie() displays it on stdout
  *
  * Memory Management:
- * - Dynamic allocation for nodes and position arrays
+ * - Nodes live in fixed-size slabs owned by a per-trie pool; children are
+ *   32-bit pool indices (0 = no child, since the root is never a child)
+ * - Position arrays are allocated only for end-of-word nodes
  * - Automatic expansion of position arrays when needed
- * - Proper memory cleanup in trie_destroy()
+ * - Optional delta + varint compaction of position arrays (trie_compact()),
+ *   read back through PostingCursor
+ * - trie_destroy() walks the slabs linearly and frees them one slab at a time
+ * - Optional search/insert counters (stats.h, compiled with INDICE_STATS)
  *
  * Performance Characteristics:
  * - Search: O(m) where m is the length of the word
@@ -39,273 +56,561 @@
  * @note The maximum word size is defined by MAX_WORD_SIZE
  */
 #include "trie.h"
+#include "normalize.h"
+#include "hash.h"
+#include "scan.h"
+#include "stats.h"
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <unistd.h>
 
-static char normalize_utf8_char(const char* utf8_char) {
-    if (!utf8_char || !*utf8_char) return '\0';
-
-    // Verifica caracteres multi-byte (UTF-8)
-    unsigned char c0 = (unsigned char)utf8_char[0];
-    unsigned char c1 = (unsigned char)utf8_char[1];
-
-    // Tabela de mapeamento para caracteres especiais
-    if (c0 == 0xC3) { // Caracteres latinos com diacríticos (2 bytes)
-        switch (c1) {
-            case 0x87: return 'c'; // Ç
-            case 0xA7: return 'c'; // ç
-            case 0x83: return 'a'; // Ã
-            case 0xA3: return 'a'; // ã
-            case 0x95: return 'o'; // Õ
-            case 0xB5: return 'o'; // õ
-            case 0x81: return 'a'; // Á
-            case 0xA1: return 'a'; // á
-            case 0x89: return 'e'; // É
-            case 0xA9: return 'e'; // é
-            case 0x8D: return 'i'; // Í
-            case 0xAD: return 'i'; // í
-            case 0x93: return 'o'; // Ó
-            case 0xB3: return 'o'; // ó
-            case 0x9A: return 'u'; // Ú
-            case 0xBA: return 'u'; // ú
-            case 0x9C: return 'u'; // Ü
-            case 0xBC: return 'u'; // ü
-        }
-    }
-
-    // Caracteres especiais (hífen mantido)
-    if (c0 == '-') return '-';
-
-    // Caracteres ASCII
-    return tolower(c0);
-}
-
-int get_next_utf8_char(const char* str, char* buf, int max_len) {
-    if (!str || !buf || max_len <= 0) return 0;
-    
-    unsigned char first_byte = (unsigned char)str[0];
-    int char_len = 1;
-    
-    // Determina o comprimento do caractere UTF-8
-    if ((first_byte & 0x80) == 0) {
-        // ASCII (0xxxxxxx)
-        char_len = 1;
-    } else if ((first_byte & 0xE0) == 0xC0) {
-        // 2 bytes (110xxxxx 10xxxxxx)
-        char_len = 2;
-    } else if ((first_byte & 0xF0) == 0xE0) {
-        // 3 bytes (1110xxxx 10xxxxxx 10xxxxxx)
-        char_len = 3;
-    } else if ((first_byte & 0xF8) == 0xF0) {
-        // 4 bytes (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx)
-        char_len = 4;
+// Pré-carrega uma linha de cache que será lida em breve
+#if defined(__GNUC__)
+#define TRIE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define TRIE_PREFETCH(addr) ((void)(addr))
+#endif
+
+// Converte uma palavra em sua chave normalizada (o caminho na Trie: 'a'-'z' e '-'),
+// ignorando caracteres fora do alfabeto. Retorna o tamanho da chave
+int trie_normalize_word(const char* word, char* out, int max_len) {
+    if (!word || !out || max_len <= 0) return 0;
+
+    int len = 0;
+    const char* ptr = word;
+    while (*ptr && len < max_len - 1) {
+        int char_len;
+        int index = normalize_next_index(ptr, &char_len);
+        if (char_len == 0) break;
+
+        if (index >= 0) {
+            out[len++] = index == 26 ? '-' : (char)('a' + index);
+        }
+        ptr += char_len;
     }
-    
-    // Verifica se o buffer é grande o suficiente
-    if (char_len > max_len) char_len = max_len;
-    
-    // Copia o caractere completo
-    memcpy(buf, str, char_len);
-    buf[char_len] = '\0';
-    
-    return char_len;
+    out[len] = '\0';
+    return len;
 }
 
-TrieNode* trie_create_node() {
-    TrieNode* node = malloc(sizeof(TrieNode));
-    if (!node) exit(EXIT_FAILURE);    
-    
-    for (int i = 0; i < 27; i++) node->children[i] = NULL;
+// Pool de nós: a raiz é o primeiro membro, então um TrieNode* raiz também é o pool
+#define TRIE_SLAB_SHIFT 10
+#define TRIE_SLAB_SIZE (1u << TRIE_SLAB_SHIFT)
+#define TRIE_SLAB_MASK (TRIE_SLAB_SIZE - 1)
+
+typedef struct {
+    TrieNode root;       // Índice 0 (precisa continuar como primeiro membro)
+    TrieNode** slabs;    // Blocos de TRIE_SLAB_SIZE nós (índices 1..num_nodes)
+    int num_slabs;
+    int max_slabs;
+    uint32_t num_nodes;  // Nós alocados nos blocos
+} TriePool;
+
+static void trie_init_node(TrieNode* node) {
+    memset(node->children, 0, sizeof(node->children));
     node->is_end_of_word = 0;
-    node->occurrences = malloc(10 * sizeof(int));
-    if (!node->occurrences) {
-        free(node);
-        exit(EXIT_FAILURE);
-    }
+    node->occurrences = NULL; // Alocado só quando o nó termina uma palavra
     node->num_occurrences = 0;
-    node->max_occurrences = 10;
+    node->max_occurrences = 0;
+    node->packed_occurrences = NULL;
+    node->packed_size = 0;
     node->original_word = NULL;
-    node->stored_utf8 = NULL;  // Inicializa como NULL
-    return node;
+    node->stored_utf8[0] = '\0';
 }
 
-// Modificar a verificação de índice na inserção para incluir hífen
-void trie_insert(TrieNode* root, const char* word, int position) {
-    if (!root || !word || position < 0) return;
+TrieNode* trie_create_node() {
+    TriePool* pool = malloc(sizeof(TriePool));
+    if (!pool) exit(EXIT_FAILURE);
+
+    trie_init_node(&pool->root);
+    pool->slabs = NULL;
+    pool->num_slabs = 0;
+    pool->max_slabs = 0;
+    pool->num_nodes = 0;
+    return &pool->root;
+}
+
+TrieNode* trie_node_at(const TrieNode* root, uint32_t index) {
+    const TriePool* pool = (const TriePool*)root;
+    if (index == 0) return (TrieNode*)&pool->root;
+    if (index > pool->num_nodes) return NULL;
+    index--;
+    return &pool->slabs[index >> TRIE_SLAB_SHIFT][index & TRIE_SLAB_MASK];
+}
 
+TrieNode* trie_node_child(const TrieNode* root, const TrieNode* node, int index) {
+    uint32_t child = node->children[index];
+    return child ? trie_node_at(root, child) : NULL;
+}
+
+uint32_t trie_node_count(const TrieNode* root) {
+    return ((const TriePool*)root)->num_nodes + 1;
+}
+
+size_t trie_pool_bytes(const TrieNode* root) {
+    const TriePool* pool = (const TriePool*)root;
+    return sizeof(TriePool) + (size_t)pool->num_slabs * TRIE_SLAB_SIZE * sizeof(TrieNode) +
+           (size_t)pool->max_slabs * sizeof(TrieNode*);
+}
+
+// Aloca um nó do pool e retorna seu índice (0 em caso de falha)
+static uint32_t trie_alloc_node(TrieNode* root) {
+    TriePool* pool = (TriePool*)root;
+    uint32_t slot = pool->num_nodes;
+
+    if ((slot >> TRIE_SLAB_SHIFT) >= (uint32_t)pool->num_slabs) {
+        if (pool->num_slabs >= pool->max_slabs) {
+            int new_max = pool->max_slabs ? pool->max_slabs * 2 : 8;
+            TrieNode** new_slabs = realloc(pool->slabs, new_max * sizeof(TrieNode*));
+            if (!new_slabs) return 0;
+            pool->slabs = new_slabs;
+            pool->max_slabs = new_max;
+        }
+        TrieNode* slab = malloc(TRIE_SLAB_SIZE * sizeof(TrieNode));
+        if (!slab) return 0;
+        pool->slabs[pool->num_slabs++] = slab;
+    }
+
+    pool->num_nodes++;
+    STATS_ADD(trie_nodes_created, 1);
+    TrieNode* node = &pool->slabs[slot >> TRIE_SLAB_SHIFT][slot & TRIE_SLAB_MASK];
+    trie_init_node(node);
+    return slot + 1;
+}
+
+// Percorre (criando se necessário) o caminho de uma palavra e marca seu nó de fim
+// de palavra. Retorna o nó pronto para receber posições no formato bruto, ou NULL
+// se a palavra não tem símbolos do alfabeto ou se uma alocação falhou
+static TrieNode* trie_word_node(TrieNode* root, const char* word) {
     TrieNode* current = root;
     char original_word[MAX_WORD_SIZE];
     strncpy(original_word, word, MAX_WORD_SIZE - 1);
     original_word[MAX_WORD_SIZE - 1] = '\0';
+    STATS_ADD(trie_inserts, 1);
 
     const char* ptr = word;
     
     while (*ptr) {
-        char utf8_char[5] = {0};
-        int char_len = get_next_utf8_char(ptr, utf8_char, 4);
+        // Índice do filho (26 = hífen) direto dos bytes, pela tabela de normalização
+        int char_len;
+        int index = normalize_next_index(ptr, &char_len);
         
         if (char_len == 0) break;
 
-        // Normalização mantendo mapeamento para indexação
-        char normalized = normalize_utf8_char(utf8_char);
-        int index;
-
-        // Lógica de indexação corrigida
-        if (normalized == '-') {
-            index = 26; // Slot especial para hífen
-        } else if (normalized >= 'a' && normalized <= 'z') {
-            index = normalized - 'a';
-        } else {
+        if (index < 0) {
             ptr += char_len; // Ignora caracteres inválidos
             continue;
         }
 
         // Cria nó se necessário
         if (!current->children[index]) {
-            current->children[index] = trie_create_node();
-            
-            // Armazena UTF-8 original com cast explícito
-            current->children[index]->stored_utf8 = (unsigned char*)strdup(utf8_char);
-            
-            if (!current->children[index]->stored_utf8) {
-                fprintf(stderr, "Falha ao alocar memória para caractere UTF-8\n");
-                return;
+            uint32_t child = trie_alloc_node(root);
+            if (!child) {
+                fprintf(stderr, "Falha ao alocar memória para nó da Trie\n");
+                return NULL;
             }
+            current->children[index] = child;
+            
+            // Armazena UTF-8 original dentro do próprio nó
+            char* stored = trie_node_at(root, child)->stored_utf8;
+            memcpy(stored, ptr, char_len);
+            stored[char_len] = '\0';
         }
 
-        current = current->children[index];
+        current = trie_node_at(root, current->children[index]);
         ptr += char_len; // Avança pelo tamanho real do caractere UTF-8
     }
 
     // Atualiza final de palavra
-    if (current != root) {
-        current->is_end_of_word = 1;
+    if (current == root) return NULL;
+    current->is_end_of_word = 1;
 
-        // Armazena palavra original se necessário
+    // Armazena palavra original se necessário
+    if (!current->original_word) {
+        current->original_word = strdup(original_word);
         if (!current->original_word) {
-            current->original_word = strdup(original_word);
-            if (!current->original_word) {
-                fprintf(stderr, "Erro ao copiar palavra original\n");
-                return;
-            }
+            fprintf(stderr, "Erro ao copiar palavra original\n");
+            return NULL;
         }
+    }
 
-        // Expande array de ocorrências se necessário
-        if (current->num_occurrences >= current->max_occurrences) {
-            current->max_occurrences *= 2;
-            int* new_occurrences = realloc(current->occurrences, 
-                                        current->max_occurrences * sizeof(int));
-            if (!new_occurrences) {
-                fprintf(stderr, "Erro ao expandir ocorrências\n");
-                return;
-            }
-            current->occurrences = new_occurrences;
+    // Nós compactados voltam ao formato bruto antes de receber posições
+    if (current->packed_occurrences) {
+        int capacity = current->num_occurrences > 10 ? current->num_occurrences : 10;
+        int* raw = malloc(capacity * sizeof(int));
+        if (!raw) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            return NULL;
         }
+        postings_unpack(current->packed_occurrences, current->num_occurrences, raw);
+        free(current->packed_occurrences);
+        current->packed_occurrences = NULL;
+        current->packed_size = 0;
+        free(current->occurrences);
+        current->occurrences = raw;
+        current->max_occurrences = capacity;
+    }
 
-        current->occurrences[current->num_occurrences++] = position;
+    return current;
+}
+
+// Modificar a verificação de índice na inserção para incluir hífen
+void trie_insert(TrieNode* root, const char* word, int position) {
+    if (!root || !word || position < 0) return;
+
+    TrieNode* current = trie_word_node(root, word);
+    if (!current) return;
+
+    // Expande array de ocorrências se necessário
+    if (current->num_occurrences >= current->max_occurrences) {
+        int new_max = current->max_occurrences ? current->max_occurrences * 2 : 10;
+        int* new_occurrences = realloc(current->occurrences, new_max * sizeof(int));
+        if (!new_occurrences) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            return;
+        }
+        current->occurrences = new_occurrences;
+        current->max_occurrences = new_max;
     }
+
+    current->occurrences[current->num_occurrences++] = position;
 }
 
-int* trie_search(TrieNode* root, const char* word, int* num_occurrences) {
-    if (!root || !word || !num_occurrences) {
-        *num_occurrences = 0;
-        return NULL;
+// Acrescenta uma lista inteira de posições a uma palavra, percorrendo seu caminho uma única vez
+void trie_insert_positions(TrieNode* root, const char* word, const int* positions, int count) {
+    if (!root || !word || !positions || count <= 0) return;
+
+    TrieNode* current = trie_word_node(root, word);
+    if (!current) return;
+
+    // Uma lista que não começa depois das posições existentes (outra grafia da
+    // mesma chave) é intercalada com elas
+    int n = current->num_occurrences;
+    if (n > 0 && positions[0] <= current->occurrences[n - 1]) {
+        int* merged = malloc((n + count) * sizeof(int));
+        if (!merged) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            return;
+        }
+        const int* lists[2] = {current->occurrences, positions};
+        int counts[2] = {n, count};
+        current->num_occurrences = postings_merge(lists, counts, 2, merged);
+        free(current->occurrences);
+        current->occurrences = merged;
+        current->max_occurrences = n + count;
+        return;
     }
 
-    TrieNode* current = root;
+    int needed = current->num_occurrences + count;
+    if (needed > current->max_occurrences) {
+        int* new_occurrences = realloc(current->occurrences, needed * sizeof(int));
+        if (!new_occurrences) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            return;
+        }
+        current->occurrences = new_occurrences;
+        current->max_occurrences = needed;
+    }
+
+    memcpy(current->occurrences + current->num_occurrences, positions, count * sizeof(int));
+    current->num_occurrences = needed;
+}
+
+// Percorre o caminho normalizado de uma palavra; retorna o nó em que ele termina
+// (e seu índice no pool em node_index, se informado) ou NULL
+static TrieNode* trie_walk(const TrieNode* root, const char* word, uint32_t* node_index) {
+    TrieNode* current = (TrieNode*)root;
+    uint32_t current_index = 0;
     const char* ptr = word;
 
     while (*ptr) {
-        char utf8_char[5] = {0};
-        int char_len = get_next_utf8_char(ptr, utf8_char, 4);
+        int char_len;
+        int index = normalize_next_index(ptr, &char_len);
         
         if (char_len == 0) break;
 
-        // Normalização correta usando o caractere UTF-8 completo
-        char normalized = normalize_utf8_char(utf8_char);
-        int index;
-
-        if (normalized == '-') {
-            index = 26;
-        } else if (normalized >= 'a' && normalized <= 'z') {
-            index = normalized - 'a';
-        } else {
+        if (index < 0) {
             ptr += char_len; // Ignora caracteres inválidos
             continue;
         }
 
-        if (index < 0 || index >= 27 || !current->children[index]) {
-            *num_occurrences = 0;
+        if (!current->children[index]) {
             return NULL;
         }
 
-        current = current->children[index];
+        current_index = current->children[index];
+        current = trie_node_at(root, current_index);
+        STATS_ADD(trie_nodes_visited, 1);
         ptr += char_len; // Avança pelo tamanho do caractere UTF-8
     }
 
+    if (node_index) *node_index = current_index;
+    return current;
+}
+
+// Percorre o caminho normalizado de uma palavra; retorna o nó de fim de palavra ou NULL
+static TrieNode* trie_find_node(TrieNode* root, const char* word) {
+    STATS_ADD(trie_searches, 1);
+    TrieNode* current = trie_walk(root, word, NULL);
+
     if (current && current->is_end_of_word) {
-        *num_occurrences = current->num_occurrences;
-        return current->occurrences;
+        STATS_ADD(trie_hits, 1);
+        return current;
+    }
+
+    return NULL;
+}
+
+int* trie_search(TrieNode* root, const char* word, int* num_occurrences) {
+    if (!root || !word || !num_occurrences) {
+        if (num_occurrences) *num_occurrences = 0;
+        return NULL;
+    }
+
+    TrieNode* node = trie_find_node(root, word);
+    if (node) {
+        *num_occurrences = node->num_occurrences;
+        return node->packed_occurrences ? NULL : node->occurrences;
     }
 
     *num_occurrences = 0;
     return NULL;
 }
 
-void _trie_traverse(TrieNode* node, char* prefix, int level,
-                  char*** words, int*** positions, int** num_positions, 
-                  int* num_words, int* max_words) {
-    if (node == NULL) return;
-    
-    if (node->is_end_of_word) {
-        if (*num_words >= *max_words) {
-            *max_words *= 2;
-            *words = (char**)realloc(*words, *max_words * sizeof(char*));
-            *positions = (int**)realloc(*positions, *max_words * sizeof(int*));
-            *num_positions = (int*)realloc(*num_positions, *max_words * sizeof(int));
+// Busca um lote de palavras. As buscas de um grupo avançam um nível por vez, de
+// modo que as leituras de nós de palavras diferentes se sobrepõem, em vez de formar
+// uma cadeia dependente de faltas de cache por palavra
+int trie_search_batch(TrieNode* root, const char* const words[], int n, int* results[], int counts[]) {
+    if (!results || n <= 0) return 0;
+
+    int found = 0;
+    for (int base = 0; base < n; base += TRIE_BATCH_SIZE) {
+        int m = n - base < TRIE_BATCH_SIZE ? n - base : TRIE_BATCH_SIZE;
+        char keys[TRIE_BATCH_SIZE][MAX_WORD_SIZE];
+        int key_lens[TRIE_BATCH_SIZE];
+        TrieNode* nodes[TRIE_BATCH_SIZE];
+
+        for (int j = 0; j < m; j++) {
+            const char* word = words[base + j];
+            nodes[j] = (root && word) ? root : NULL;
+            key_lens[j] = word ? trie_normalize_word(word, keys[j], MAX_WORD_SIZE) : 0;
+        }
+
+        // Um nível por passada; cada passo pré-carrega o nó que a próxima passada vai ler
+        for (int depth = 0, active = 1; active; depth++) {
+            active = 0;
+            for (int j = 0; j < m; j++) {
+                if (!nodes[j] || depth >= key_lens[j]) continue;
+
+                int index = keys[j][depth] == '-' ? 26 : keys[j][depth] - 'a';
+                nodes[j] = trie_node_child(root, nodes[j], index);
+                if (nodes[j]) {
+                    STATS_ADD(trie_nodes_visited, 1);
+                    TRIE_PREFETCH(nodes[j]);
+                    active = 1;
+                }
+            }
+        }
+
+        for (int j = 0; j < m; j++) {
+            TrieNode* node = nodes[j];
+            results[base + j] = NULL;
+            if (counts) counts[base + j] = 0;
+            if (!node || !node->is_end_of_word) continue;
+
+            results[base + j] = node->packed_occurrences ? NULL : node->occurrences;
+            if (counts) counts[base + j] = node->num_occurrences;
+            found++;
         }
-        
-        // Usa a palavra original armazenada, não o prefixo normalizado
-        (*words)[*num_words] = strdup(node->original_word);
-        
-        (*positions)[*num_words] = (int*)malloc(node->num_occurrences * sizeof(int));
-        memcpy((*positions)[*num_words], node->occurrences, node->num_occurrences * sizeof(int));
-        (*num_positions)[*num_words] = node->num_occurrences;
-        
-        (*num_words)++;
     }
-    
-    for (int i = 0; i < 27; i++) {
-        if (node->children[i]) {
-            prefix[level] = 'a' + i;
-            prefix[level + 1] = '\0';
-            _trie_traverse(node->children[i], prefix, level + 1, 
-                         words, positions, num_positions, num_words, max_words);
+    STATS_ADD(trie_searches, n);
+    STATS_ADD(trie_hits, found);
+    return found;
+}
+
+static void trie_node_cursor(const TrieNode* node, PostingCursor* cursor) {
+    const int* raw = node->packed_occurrences ? NULL : node->occurrences;
+    posting_cursor_init(cursor, raw, node->packed_occurrences, node->num_occurrences);
+}
+
+int trie_search_cursor(TrieNode* root, const char* word, PostingCursor* cursor) {
+    if (!cursor) return 0;
+    posting_cursor_init(cursor, NULL, NULL, 0);
+    if (!root || !word) return 0;
+
+    TrieNode* node = trie_find_node(root, word);
+    if (!node) return 0;
+
+    trie_node_cursor(node, cursor);
+    return 1;
+}
+
+// Compacta um único nó de fim de palavra
+static void trie_compact_node(TrieNode* node) {
+    if (!node->is_end_of_word || node->packed_occurrences || !node->occurrences) return;
+
+    unsigned char* packed;
+    int size = postings_pack(node->occurrences, node->num_occurrences, &packed);
+    if (size < 0) return; // Mantém o formato bruto em caso de falha
+
+    free(node->occurrences);
+    node->occurrences = NULL;
+    node->max_occurrences = 0;
+    node->packed_occurrences = packed;
+    node->packed_size = size;
+}
+
+void trie_compact(TrieNode* root) {
+    if (root == NULL) return;
+
+    uint32_t count = trie_node_count(root);
+    for (uint32_t i = 0; i < count; i++) {
+        trie_compact_node(trie_node_at(root, i));
+    }
+}
+
+// Empilha um nível; a pilha passa para o heap depois de TRIE_CURSOR_INLINE níveis
+static int trie_cursor_push(TrieCursor* cursor, uint32_t node) {
+    if (cursor->depth == cursor->capacity) {
+        int new_capacity = cursor->capacity * 2;
+        TrieCursorFrame* heap = cursor->stack == cursor->inline_stack ? NULL : cursor->stack;
+        TrieCursorFrame* stack = realloc(heap, new_capacity * sizeof(TrieCursorFrame));
+        if (!stack) {
+            fprintf(stderr, "Erro ao expandir a pilha do cursor da Trie\n");
+            return 0;
         }
+        if (!heap) memcpy(stack, cursor->inline_stack, cursor->depth * sizeof(TrieCursorFrame));
+        cursor->stack = stack;
+        cursor->capacity = new_capacity;
     }
+    cursor->stack[cursor->depth].node = node;
+    cursor->stack[cursor->depth].next_child = -1;
+    cursor->depth++;
+    return 1;
+}
+
+int trie_cursor_begin(TrieCursor* cursor, const TrieNode* root, const char* prefix) {
+    if (!cursor) return 0;
+    cursor->root = root;
+    cursor->stack = cursor->inline_stack;
+    cursor->depth = 0;
+    cursor->capacity = TRIE_CURSOR_INLINE;
+    if (!root) return 0;
+
+    // O percurso começa no nó do prefixo (a raiz para um prefixo vazio)
+    uint32_t index = 0;
+    if (prefix && !trie_walk(root, prefix, &index)) return 0;
+    return trie_cursor_push(cursor, index);
+}
+
+int trie_cursor_next(TrieCursor* cursor, TrieWord* out) {
+    if (!cursor || !out) return 0;
+
+    while (cursor->depth > 0) {
+        TrieCursorFrame* top = &cursor->stack[cursor->depth - 1];
+        const TrieNode* node = trie_node_at(cursor->root, top->node);
+
+        // Um nó vem antes de seus filhos (palavras mais curtas vêm primeiro)
+        if (top->next_child < 0) {
+            top->next_child = 0;
+            if (node->is_end_of_word) {
+                out->word = node->original_word;
+                out->occurrences = node->packed_occurrences ? NULL : node->occurrences;
+                out->num_occurrences = node->num_occurrences;
+                trie_node_cursor(node, &out->postings);
+                return 1;
+            }
+        }
+
+        int c = top->next_child;
+        while (c < 27 && !node->children[c]) c++;
+        if (c == 27) {
+            cursor->depth--;
+            continue;
+        }
+        top->next_child = c + 1;
+        if (!trie_cursor_push(cursor, node->children[c])) {
+            cursor->depth = 0;
+            return 0;
+        }
+    }
+    return 0;
+}
+
+void trie_cursor_end(TrieCursor* cursor) {
+    if (!cursor) return;
+    if (cursor->stack != cursor->inline_stack) free(cursor->stack);
+    cursor->stack = cursor->inline_stack;
+    cursor->depth = 0;
 }
 
 void trie_get_all_words(TrieNode* root, char* prefix, char*** words, int*** positions, 
-                      int** num_positions, int* num_words, int* max_words) {
+                        int** num_positions, int* num_words, int* max_words) {
+    (void)prefix;
     *num_words = 0;
-    _trie_traverse(root, prefix, 0, words, positions, num_positions, num_words, max_words);
+
+    TrieCursor cursor;
+    TrieWord entry;
+    trie_cursor_begin(&cursor, root, NULL);
+    while (trie_cursor_next(&cursor, &entry)) {
+        if (*num_words >= *max_words) {
+            int new_max = *max_words > 0 ? *max_words * 2 : 10;
+            char** new_words = (char**)realloc(*words, new_max * sizeof(char*));
+            if (new_words) *words = new_words;
+            int** new_positions = (int**)realloc(*positions, new_max * sizeof(int*));
+            if (new_positions) *positions = new_positions;
+            int* new_nums = (int*)realloc(*num_positions, new_max * sizeof(int));
+            if (new_nums) *num_positions = new_nums;
+            if (!new_words || !new_positions || !new_nums) {
+                fprintf(stderr, "Erro ao expandir a lista de palavras da Trie\n");
+                break;
+            }
+            *max_words = new_max;
+        }
+
+        // Decodifica pelo cursor, então nós brutos e compactados são lidos do mesmo jeito
+        int* copy = (int*)malloc((entry.num_occurrences > 0 ? entry.num_occurrences : 1) * sizeof(int));
+        char* word = strdup(entry.word);
+        if (!copy || !word) {
+            fprintf(stderr, "Erro ao copiar palavra da Trie\n");
+            free(copy);
+            free(word);
+            break;
+        }
+        int n = 0;
+        while (posting_cursor_next(&entry.postings, &copy[n])) n++;
+        (*words)[*num_words] = word;
+        (*positions)[*num_words] = copy;
+        (*num_positions)[*num_words] = n;
+        (*num_words)++;
+    }
+    trie_cursor_end(&cursor);
+}
+static void trie_release_node(TrieNode* node) {
+    free(node->occurrences);
+    free(node->packed_occurrences);
+    free(node->original_word);
 }
 
 void trie_destroy(TrieNode* root) {
     if (root == NULL) return;
     
-    for (int i = 0; i < 27; i++) {
-        if (root->children[i]) {
-            trie_destroy(root->children[i]);
+    // Só os nós de fim de palavra têm buffers próprios; os nós são liberados com seu bloco
+    TriePool* pool = (TriePool*)root;
+    for (int s = 0; s < pool->num_slabs; s++) {
+        uint32_t first = (uint32_t)s << TRIE_SLAB_SHIFT;
+        uint32_t used = pool->num_nodes - first;
+        if (used > TRIE_SLAB_SIZE) used = TRIE_SLAB_SIZE;
+        for (uint32_t i = 0; i < used; i++) {
+            if (pool->slabs[s][i].is_end_of_word) trie_release_node(&pool->slabs[s][i]);
         }
+        free(pool->slabs[s]);
     }
-    
-    free(root->occurrences);
-    free(root->original_word);
-    free(root->stored_utf8); // Libera a memória do caractere UTF-8
-    free(root);
+    trie_release_node(&pool->root);
+    free(pool->slabs);
+    free(pool);
 }
 
 // Verifica se uma palavra deve ser incluída no índice
@@ -328,15 +633,40 @@ int is_stopword(const char* word) {
     return 0; // Nenhuma palavra é considerada stopword
 }
 
+// Chave de ordenação de uma palavra: a chave da Trie com cada símbolo trocado pelo
+// índice do filho + 1 ('a' = 1 ... 'z' = 26, '-' = 27), de modo que a ordem simples
+// dos bytes seja a ordem em que a Trie visita seus filhos. Retorna o tamanho da chave
+int trie_sort_key(const char* word, unsigned char* out, int max_len) {
+    int len = trie_normalize_word(word, (char*)out, max_len);
+    for (int i = 0; i < len; i++) {
+        out[i] = out[i] == '-' ? 27 : (unsigned char)(out[i] - 'a' + 1);
+    }
+    return len;
+}
+
+// Compara duas palavras por suas chaves de ordenação da Trie
+int trie_compare_words(const char* a, const char* b) {
+    unsigned char key_a[MAX_WORD_SIZE];
+    unsigned char key_b[MAX_WORD_SIZE];
+    trie_sort_key(a, key_a, MAX_WORD_SIZE);
+    trie_sort_key(b, key_b, MAX_WORD_SIZE);
+    return strcmp((const char*)key_a, (const char*)key_b);
+}
+
 // Nova função de busca binária para encontrar palavras em um array ordenado
 // Retorna o índice se encontrar, -1 caso contrário
 int binary_search_word(char* palavras[], int num_palavras, const char* palavra) {
+    unsigned char key[MAX_WORD_SIZE];
+    trie_sort_key(palavra, key, MAX_WORD_SIZE);
+
     int left = 0;
     int right = num_palavras - 1;
     
     while (left <= right) {
         int mid = left + (right - left) / 2;
-        int cmp = strcasecmp(palavras[mid], palavra);
+        unsigned char mid_key[MAX_WORD_SIZE];
+        trie_sort_key(palavras[mid], mid_key, MAX_WORD_SIZE);
+        int cmp = strcmp((const char*)mid_key, (const char*)key);
         
         if (cmp == 0) {
             return mid; // Encontrou a palavra
@@ -352,50 +682,235 @@ int binary_search_word(char* palavras[], int num_palavras, const char* palavra)
     return -1; // Não encontrou
 }
 
-// Função auxiliar para ordenar um array de palavras e manter os índices de posições
+// Palavra em ordenação, com sua chave de ordenação calculada uma única vez
+typedef struct {
+    const unsigned char* key;
+    char* palavra;
+    int* posicoes;
+} SortItem;
+
+#define TRIE_SORT_CUTOFF 12
+
+// Símbolo na profundidade d (0 depois do fim da chave)
+static int sort_symbol(const SortItem* item, int d) {
+    return item->key[d];
+}
+
+static void sort_swap(SortItem* items, int i, int j) {
+    SortItem tmp = items[i];
+    items[i] = items[j];
+    items[j] = tmp;
+}
+
+// Ordenação por inserção para trechos pequenos, comparando a partir da profundidade d
+// (todas as chaves compartilham os d primeiros símbolos)
+static void sort_small(SortItem* items, int n, int d) {
+    for (int i = 1; i < n; i++) {
+        SortItem item = items[i];
+        int j = i - 1;
+        while (j >= 0 && strcmp((const char*)items[j].key + d, (const char*)item.key + d) > 0) {
+            items[j + 1] = items[j];
+            j--;
+        }
+        items[j + 1] = item;
+    }
+}
+
+// Quicksort multichave (Bentley-Sedgewick): partição em três pelo símbolo na
+// profundidade d, depois recursão em <, = (na profundidade d + 1) e >. Cada símbolo
+// de cada chave é examinado cerca de O(log n) vezes, e não uma vez por comparação
+static void sort_multikey(SortItem* items, int n, int d) {
+    while (n > TRIE_SORT_CUTOFF) {
+        // Mediana de três como pivô
+        int a = sort_symbol(&items[0], d);
+        int b = sort_symbol(&items[n / 2], d);
+        int c = sort_symbol(&items[n - 1], d);
+        int pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+        // Invariante: [0, lt) < pivô, [lt, i) == pivô, (gt, n) > pivô
+        int lt = 0, i = 0, gt = n - 1;
+        while (i <= gt) {
+            int symbol = sort_symbol(&items[i], d);
+            if (symbol < pivot) sort_swap(items, lt++, i++);
+            else if (symbol > pivot) sort_swap(items, i, gt--);
+            else i++;
+        }
+
+        sort_multikey(items, lt, d);
+        sort_multikey(items + gt + 1, n - gt - 1, d);
+
+        // Chaves iguais até o fim não precisam de mais ordenação
+        if (pivot == 0) return;
+        items += lt;
+        n = gt - lt + 1;
+        d++;
+    }
+    sort_small(items, n, d);
+}
+
+// Ordena as palavras pela chave da Trie mantendo os arrays de posições associados
 void sort_palavras_com_posicoes(char* palavras[], int* posicoes[], int num_palavras) {
-    // Cria um array temporário para armazenar os índices originais
-    typedef struct {
-        char* palavra;
-        int* posicoes;
-    } PalavraComPosicao;
-    
-    PalavraComPosicao* temp = malloc(num_palavras * sizeof(PalavraComPosicao));
-    if (!temp) {
+    if (num_palavras < 2) return;
+
+    SortItem* items = malloc(num_palavras * sizeof(SortItem));
+    unsigned char* keys = malloc((size_t)num_palavras * MAX_WORD_SIZE);
+    if (!items || !keys) {
         fprintf(stderr, "Erro ao alocar memória para ordenação\n");
+        free(items);
+        free(keys);
         return;
     }
     
-    // Preenche o array temporário
+    // Calcula cada chave uma única vez
     for (int i = 0; i < num_palavras; i++) {
-        temp[i].palavra = palavras[i];
-        temp[i].posicoes = posicoes[i];
-    }
-    
-    // Algoritmo de ordenação simples (insertion sort) - O(n²) no pior caso
-    // Para manter complexidade melhor, poderíamos implementar um quicksort ou mergesort
-    for (int i = 1; i < num_palavras; i++) {
-        PalavraComPosicao key = temp[i];
-        int j = i - 1;
-        
-        while (j >= 0 && strcasecmp(temp[j].palavra, key.palavra) > 0) {
-            temp[j + 1] = temp[j];
-            j = j - 1;
-        }
-        temp[j + 1] = key;
+        unsigned char* key = keys + (size_t)i * MAX_WORD_SIZE;
+        trie_sort_key(palavras[i], key, MAX_WORD_SIZE);
+        items[i].key = key;
+        items[i].palavra = palavras[i];
+        items[i].posicoes = posicoes[i];
     }
+
+    sort_multikey(items, num_palavras, 0);
     
     // Copia de volta para os arrays originais
     for (int i = 0; i < num_palavras; i++) {
-        palavras[i] = temp[i].palavra;
-        posicoes[i] = temp[i].posicoes;
+        palavras[i] = items[i].palavra;
+        posicoes[i] = items[i].posicoes;
     }
     
-    free(temp);
+    free(keys);
+    free(items);
+}
+
+// Tabela de palavras-chave das criações: uma entrada por chave distinta da Trie,
+// com a primeira palavra-chave que tem essa chave (em occurrences[0])
+static HashTable* trie_keyword_table(char keywords[][MAX_WORD_SIZE], int num_keywords) {
+    HashTable* keyword_ht = hash_create(num_keywords * 2);
+    char key[MAX_WORD_SIZE];
+    for (int k = 0; k < num_keywords; k++) {
+        int n;
+        if (trie_normalize_word(keywords[k], key, MAX_WORD_SIZE) > 0 && !hash_search(keyword_ht, key, &n)) {
+            hash_insert(keyword_ht, key, k);
+        }
+    }
+    return keyword_ht;
+}
+
+// Procura um grupo de tokens na tabela de palavras-chave: cada token é reduzido à
+// sua chave da Trie, e o filtro descarta a maioria dos que não são palavras-chave
+// antes de qualquer sondagem da tabela
+static void trie_find_keywords(HashTable* keyword_ht, const BloomFilter* filter, char* const palavras[],
+                               int m, int* found[]) {
+    char keys[HASH_BATCH_SIZE][MAX_WORD_SIZE];
+    const char* batch[HASH_BATCH_SIZE];
+    for (int j = 0; j < m; j++) {
+        int ok = palavras[j] && trie_normalize_word(palavras[j], keys[j], MAX_WORD_SIZE) > 0;
+        batch[j] = ok ? keys[j] : NULL;
+    }
+    hash_search_batch_filtered(keyword_ht, filter, batch, m, found, NULL);
+}
+
+// Lista de uma palavra distinta encontrada para a chave de uma palavra-chave,
+// encadeada por palavra-chave
+typedef struct {
+    const int* list;  // Lista de posições da palavra (quantidade na posição 0)
+    int next;         // Próxima entrada da mesma palavra-chave, ou -1
+} TrieKeyList;
+
+// Registra a lista de um token na palavra-chave k, a menos que um token da mesma
+// palavra já o tenha feito (os tokens de uma palavra compartilham sua lista)
+static int trie_add_key_list(TrieKeyList** pool, int* size, int* capacity, int* first, int k, const int* list) {
+    for (int e = first[k]; e >= 0; e = (*pool)[e].next) {
+        if ((*pool)[e].list == list) return 1;
+    }
+    if (*size == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 64;
+        TrieKeyList* grown = realloc(*pool, new_capacity * sizeof(TrieKeyList));
+        if (!grown) {
+            fprintf(stderr, "Erro ao alocar memória para as palavras-chave\n");
+            return 0;
+        }
+        *pool = grown;
+        *capacity = new_capacity;
+    }
+    (*pool)[*size].list = list;
+    (*pool)[*size].next = first[k];
+    first[k] = (*size)++;
+    return 1;
 }
 
-// Versão sem HashMap para criar_indice_trie
-int criar_indice_trie(TrieNode** root, char* palavras[], int* posicoes[], int num_palavras, 
+// Reúne as posições das palavras-chave em uma única passada pelos tokens. A lista
+// de cada token já tem todas as posições de sua palavra, então cada chave de
+// palavra-chave reúne as listas de suas palavras distintas (várias grafias podem ter
+// a mesma chave, como "café" e "cafe123"), combinadas com um k-way merge, como na
+// criação paralela
+int trie_collect_keywords(char* const palavras[], int* const posicoes[], int num_palavras,
+                          char keywords[][MAX_WORD_SIZE], int num_keywords,
+                          TrieKeywordVisitor visitar, void* ctx) {
+    int* first = malloc((num_keywords > 0 ? num_keywords : 1) * sizeof(int));
+    if (!first) {
+        fprintf(stderr, "Erro ao alocar memória para as palavras-chave\n");
+        return 0;
+    }
+    for (int k = 0; k < num_keywords; k++) first[k] = -1;
+
+    HashTable* keyword_ht = trie_keyword_table(keywords, num_keywords);
+    BloomFilter* filter = hash_bloom_filter(keyword_ht);
+    TrieKeyList* pool = NULL;
+    int pool_size = 0, pool_capacity = 0, ok = 1;
+    int* found[HASH_BATCH_SIZE];
+    for (int inicio = 0; inicio < num_palavras && ok; inicio += HASH_BATCH_SIZE) {
+        int m = num_palavras - inicio < HASH_BATCH_SIZE ? num_palavras - inicio : HASH_BATCH_SIZE;
+        trie_find_keywords(keyword_ht, filter, palavras + inicio, m, found);
+        for (int j = 0; j < m && ok; j++) {
+            if (found[j]) {
+                ok = trie_add_key_list(&pool, &pool_size, &pool_capacity, first, found[j][0], posicoes[inicio + j]);
+            }
+        }
+    }
+
+    // As palavras-chave são entregues na sua própria ordem, então cada nó fica com a primeira grafia
+    const int** lists = ok && pool_size > 0 ? malloc(pool_size * sizeof(int*)) : NULL;
+    int* counts = lists ? malloc(pool_size * sizeof(int)) : NULL;
+    if (ok && pool_size > 0 && !counts) {
+        fprintf(stderr, "Erro ao alocar memória para as palavras-chave\n");
+        ok = 0;
+    }
+    for (int k = 0; k < num_keywords && ok; k++) {
+        int n = 0, total = 0;
+        for (int e = first[k]; e >= 0; e = pool[e].next, n++) {
+            lists[n] = pool[e].list + 1;
+            counts[n] = pool[e].list[0];
+            total += counts[n];
+        }
+        if (n == 1) visitar(ctx, keywords[k], lists[0], counts[0]);
+        if (n <= 1) continue;
+
+        int* merged = malloc(total * sizeof(int));
+        if (!merged) {
+            fprintf(stderr, "Erro ao expandir ocorrências\n");
+            ok = 0;
+            break;
+        }
+        visitar(ctx, keywords[k], merged, postings_merge(lists, counts, n, merged));
+        free(merged);
+    }
+
+    free(lists);
+    free(counts);
+    free(pool);
+    bloom_destroy(filter);
+    hash_destroy(keyword_ht);
+    free(first);
+    return ok;
+}
+
+static void trie_insert_visitor(void* ctx, const char* keyword, const int* positions, int count) {
+    trie_insert_positions((TrieNode*)ctx, keyword, positions, count);
+}
+
+// Cria o índice em uma única passada pelos tokens (trie_collect_keywords)
+int criar_indice_trie(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras, 
                     char keywords[][MAX_WORD_SIZE], int num_keywords) {
     if (*root == NULL) {
         *root = trie_create_node();
@@ -403,22 +918,189 @@ int criar_indice_trie(TrieNode** root, char* palavras[], int* posicoes[], int nu
         trie_destroy(*root);
         *root = trie_create_node();
     }
+    return trie_collect_keywords(palavras, posicoes, num_palavras, keywords, num_keywords,
+                                 trie_insert_visitor, *root);
+}
 
-    // Ordenar o array de palavras para usar busca binária - O(n log n)
-    sort_palavras_com_posicoes(palavras, posicoes, num_palavras);
-    
-    // Processar as palavras-chave - O(k log n), onde k é o num de keywords
-    for (int i = 0; i < num_keywords; i++) {
-        int j = binary_search_word(palavras, num_palavras, keywords[i]);
-        if (j >= 0) {
-            // Palavra-chave encontrada
-            for (int k = 1; k <= posicoes[j][0]; k++) {
-                trie_insert(*root, keywords[i], posicoes[j][k]);
+// Trabalho de uma thread na criação paralela: um intervalo de tokens e uma sub-Trie própria
+typedef struct {
+    TrieNode* sub;
+    HashTable* keyword_ht;   // Chave da Trie -> índice da palavra-chave (em occurrences[0]), só leitura
+    const BloomFilter* filter;
+    char (*keywords)[MAX_WORD_SIZE];
+    char* const* palavras;
+    int inicio;
+    int fim;
+} TrieWorker;
+
+// Insere os tokens de palavras-chave do intervalo na sub-Trie da thread. Os tokens
+// são percorridos em ordem, então as listas de posições saem ordenadas
+static void* trie_worker_run(void* arg) {
+    TrieWorker* w = (TrieWorker*)arg;
+    int* found[HASH_BATCH_SIZE];
+    for (int inicio = w->inicio; inicio < w->fim; inicio += HASH_BATCH_SIZE) {
+        int m = w->fim - inicio < HASH_BATCH_SIZE ? w->fim - inicio : HASH_BATCH_SIZE;
+
+        // Busca das palavras-chave do grupo inteiro, com pré-carregamento dos slots
+        trie_find_keywords(w->keyword_ht, w->filter, w->palavras + inicio, m, found);
+        for (int j = 0; j < m; j++) {
+            if (found[j]) trie_insert(w->sub, w->keywords[found[j][0]], inicio + j);
+        }
+    }
+    return NULL;
+}
+
+// Cria o índice com várias threads. Os tokens são divididos em num_threads
+// intervalos; cada thread preenche sua própria sub-Trie e, no final, as listas
+// (já ordenadas) de cada palavra-chave são combinadas com um k-way merge na Trie final
+int criar_indice_trie_paralelo(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras,
+                               char keywords[][MAX_WORD_SIZE], int num_keywords, int num_threads) {
+    if (num_threads > num_palavras) num_threads = num_palavras;
+    if (num_threads > TRIE_MAX_THREADS) num_threads = TRIE_MAX_THREADS;
+    if (num_threads <= 1) {
+        return criar_indice_trie(root, palavras, posicoes, num_palavras, keywords, num_keywords);
+    }
+
+    if (*root != NULL) trie_destroy(*root);
+    *root = trie_create_node();
+
+    // Uma entrada por chave distinta da Trie; fica a primeira palavra-chave com essa chave
+    HashTable* keyword_ht = trie_keyword_table(keywords, num_keywords);
+    BloomFilter* filter = hash_bloom_filter(keyword_ht);
+    char key[MAX_WORD_SIZE];
+
+    TrieWorker workers[TRIE_MAX_THREADS];
+    pthread_t threads[TRIE_MAX_THREADS];
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].sub = trie_create_node();
+        workers[t].keyword_ht = keyword_ht;
+        workers[t].filter = filter;
+        workers[t].keywords = keywords;
+        workers[t].palavras = palavras;
+        workers[t].inicio = (int)((long long)num_palavras * t / num_threads);
+        workers[t].fim = (int)((long long)num_palavras * (t + 1) / num_threads);
+    }
+    int started = 0;
+    for (; started < num_threads; started++) {
+        if (pthread_create(&threads[started], NULL, trie_worker_run, &workers[started]) != 0) break;
+    }
+    // Intervalos cujas threads não puderam ser criadas são processados aqui
+    for (int t = started; t < num_threads; t++) trie_worker_run(&workers[t]);
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+
+    // Merge em ordem das palavras-chave. Cada grupo de palavras-chave é procurado em
+    // cada sub-Trie com uma única busca em lote
+    const char* batch[TRIE_BATCH_SIZE];
+    int* found[TRIE_MAX_THREADS][TRIE_BATCH_SIZE];
+    int found_counts[TRIE_MAX_THREADS][TRIE_BATCH_SIZE];
+    const int* lists[TRIE_MAX_THREADS];
+    int counts[TRIE_MAX_THREADS];
+    int ok = 1;
+    for (int inicio = 0; inicio < num_keywords && ok; inicio += TRIE_BATCH_SIZE) {
+        int m = num_keywords - inicio < TRIE_BATCH_SIZE ? num_keywords - inicio : TRIE_BATCH_SIZE;
+        for (int j = 0; j < m; j++) {
+            int k = inicio + j;
+            int n;
+            int* first;
+            int is_first = trie_normalize_word(keywords[k], key, MAX_WORD_SIZE) > 0 &&
+                           (first = hash_search(keyword_ht, key, &n)) && first[0] == k;
+            batch[j] = is_first ? keywords[k] : NULL;
+        }
+        for (int t = 0; t < num_threads; t++) {
+            trie_search_batch(workers[t].sub, batch, m, found[t], found_counts[t]);
+        }
+
+        for (int j = 0; j < m && ok; j++) {
+            if (!batch[j]) continue;
+
+            int total = 0;
+            for (int t = 0; t < num_threads; t++) {
+                lists[t] = found[t][j];
+                counts[t] = found_counts[t][j];
+                total += counts[t];
             }
+            if (total == 0) continue;
+
+            int* merged = malloc(total * sizeof(int));
+            if (!merged) {
+                fprintf(stderr, "Erro ao expandir ocorrências\n");
+                ok = 0;
+                break;
+            }
+            int count = postings_merge(lists, counts, num_threads, merged);
+            trie_insert_positions(*root, batch[j], merged, count);
+            free(merged);
         }
     }
-    
-    return 1;
+
+    for (int t = 0; t < num_threads; t++) trie_destroy(workers[t].sub);
+    bloom_destroy(filter);
+    hash_destroy(keyword_ht);
+    return ok;
+}
+
+// Acrescenta a uma Trie existente as ocorrências de uma parte do texto. As palavras
+// são as distintas da parte, cada uma com sua lista inteira, então cada palavra-chave
+// é procurada uma única vez; as posições são deslocadas por base. As palavras-chave
+// antes de primeira já estão no índice, e as novas com a mesma chave da Trie de uma
+// delas são ignoradas
+int trie_append_indice(TrieNode* root, char* const palavras[], int* const posicoes[], int num_palavras,
+                       int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira) {
+    if (!root || num_palavras < 0 || primeira < 0) return 0;
+    if (primeira >= num_keywords || num_palavras == 0) return 1;
+
+    // Uma entrada por chave distinta da Trie; fica a primeira palavra-chave com essa chave
+    HashTable* keyword_ht = trie_keyword_table(keywords, num_keywords);
+    BloomFilter* filter = hash_bloom_filter(keyword_ht);
+
+    int* shifted = NULL;
+    int capacity = 0, ok = 1;
+    int* found[HASH_BATCH_SIZE];
+    for (int inicio = 0; inicio < num_palavras && ok; inicio += HASH_BATCH_SIZE) {
+        int m = num_palavras - inicio < HASH_BATCH_SIZE ? num_palavras - inicio : HASH_BATCH_SIZE;
+        trie_find_keywords(keyword_ht, filter, palavras + inicio, m, found);
+        for (int j = 0; j < m && ok; j++) {
+            int i = inicio + j;
+            if (!found[j] || found[j][0] < primeira) continue;
+
+            int count = posicoes[i][0];
+            const int* list = posicoes[i] + 1;
+            if (base != 0) {
+                if (count > capacity) {
+                    int* grown = realloc(shifted, count * sizeof(int));
+                    if (!grown) {
+                        fprintf(stderr, "Erro ao expandir ocorrências\n");
+                        ok = 0;
+                        break;
+                    }
+                    shifted = grown;
+                    capacity = count;
+                }
+                for (int k = 0; k < count; k++) shifted[k] = list[k] + base;
+                list = shifted;
+            }
+            trie_insert_positions(root, keywords[found[j][0]], list, count);
+        }
+    }
+
+    free(shifted);
+    bloom_destroy(filter);
+    hash_destroy(keyword_ht);
+    return ok;
+}
+
+// Classificação dos separadores de tokenize_text: tudo que não é letra, dígito, '-' ou byte UTF-8
+static ClasseBytes separadores_texto;
+static int separadores_texto_prontos = 0;
+
+static void preparar_separadores_texto(void) {
+    if (separadores_texto_prontos) return;
+    unsigned char separador[256];
+    for (int c = 0; c < 256; c++) {
+        separador[c] = !(isalnum(c) || c == '-' || c > 127);
+    }
+    scan_preparar(&separadores_texto, separador);
+    separadores_texto_prontos = 1;
 }
 
 // Função auxiliar para tokenizar texto em palavras
@@ -432,78 +1114,43 @@ int tokenize_text(const char* text, char*** words, int*** positions) {
         return 0;
     }
     
+    preparar_separadores_texto();
+    size_t n = strlen(text);
+    size_t i = 0;
     int word_count = 0;
     int pos = 1;  // Começamos na posição 1
     
-    const char* start = text;
-    int in_word = 0;
-    
-    while (*text) {
-        char c = *text;
+    for (;;) {
+        // Fronteiras da próxima palavra
+        size_t start = scan_pular(&separadores_texto, text, i, n);
+        if (start == n) break;
+        i = scan_palavra(&separadores_texto, text, start, n);
+        size_t len = i - start;
         
-        // Verifica se é um caractere de palavra
-        if (isalnum((unsigned char)c) || c == '-' || ((unsigned char)c > 127)) {
-            if (!in_word) {
-                start = text;
-                in_word = 1;
-            }
-        } else {
-            if (in_word) {
-                // Fim da palavra
-                int len = text - start;
-                if (len > 0) {
-                    // Aumenta o array se necessário
-                    if (word_count >= max_words) {
-                        max_words *= 2;
-                        *words = (char**)realloc(*words, max_words * sizeof(char*));
-                        *positions = (int**)realloc(*positions, max_words * sizeof(int*));
-                        
-                        if (!*words || !*positions) {
-                            fprintf(stderr, "Erro ao realocar memória para tokenização\n");
-                            return 0;
-                        }
-                    }
-                    
-                    // Aloca palavra
-                    (*words)[word_count] = (char*)malloc((len + 1) * sizeof(char));
-                    strncpy((*words)[word_count], start, len);
-                    (*words)[word_count][len] = '\0';
-                    
-                    // Aloca posição (posicoes[0] guarda o número de posições)
-                    (*positions)[word_count] = (int*)malloc(2 * sizeof(int));
-                    (*positions)[word_count][0] = 1;  // Número de posições
-                    (*positions)[word_count][1] = pos;  // A posição
-                    
-                    word_count++;
-                    pos++;  // Incrementa posição para a próxima palavra
-                }
-                in_word = 0;
+        // Aumenta o array se necessário
+        if (word_count >= max_words) {
+            max_words *= 2;
+            *words = (char**)realloc(*words, max_words * sizeof(char*));
+            *positions = (int**)realloc(*positions, max_words * sizeof(int*));
+            
+            if (!*words || !*positions) {
+                fprintf(stderr, "Erro ao realocar memória para tokenização\n");
+                return 0;
             }
         }
         
-        text++;
-    }
-    
-    // Verifica se acabou em uma palavra
-    if (in_word) {
-        int len = text - start;
-        if (len > 0) {
-            if (word_count >= max_words) {
-                max_words *= 2;
-                *words = (char**)realloc(*words, max_words * sizeof(char*));
-                *positions = (int**)realloc(*positions, max_words * sizeof(int*));
-            }
-            
-            (*words)[word_count] = (char*)malloc((len + 1) * sizeof(char));
-            strncpy((*words)[word_count], start, len);
-            (*words)[word_count][len] = '\0';
-            
-            (*positions)[word_count] = (int*)malloc(2 * sizeof(int));
-            (*positions)[word_count][0] = 1;
-            (*positions)[word_count][1] = pos;
-            
-            word_count++;
-        }
+        // Aloca palavra
+        (*words)[word_count] = (char*)malloc((len + 1) * sizeof(char));
+        memcpy((*words)[word_count], text + start, len);
+        (*words)[word_count][len] = '\0';
+        
+        // Aloca posição (posicoes[0] guarda o número de posições)
+        (*positions)[word_count] = (int*)malloc(2 * sizeof(int));
+        (*positions)[word_count][0] = 1;  // Número de posições
+        (*positions)[word_count][1] = pos;  // A posição
+        
+        word_count++;
+        pos++;  // Incrementa posição para a próxima palavra
     }
     
     return word_count;
@@ -531,14 +1178,14 @@ int criar_indice_trie_texto(TrieNode** root, const char* texto, char keywords[][
 }
 
 // Nova função para representação visual da Trie
-void imprimir_trie_arvore_recursivo(TrieNode* node, char* prefix, int is_last, 
+void imprimir_trie_arvore_recursivo(TrieNode* root, TrieNode* node, char* prefix, int is_last, 
                                         unsigned char* path, int level) {
     if (!node) return;
 
     printf("%s", prefix);
     printf(is_last ? "└── " : "├── ");
 
-    if (node->stored_utf8) {
+    if (node->stored_utf8[0]) {
         printf("%s", node->stored_utf8);
     } else if (level > 0) {
         printf("%c", 'a' + path[level-1]);
@@ -565,7 +1212,7 @@ void imprimir_trie_arvore_recursivo(TrieNode* node, char* prefix, int is_last,
         if (level > 0) memcpy(new_path, path, level);
         new_path[level] = i;
 
-        imprimir_trie_arvore_recursivo(node->children[i], new_prefix, ++current_child == child_count, new_path, level + 1);
+        imprimir_trie_arvore_recursivo(root, trie_node_at(root, node->children[i]), new_prefix, ++current_child == child_count, new_path, level + 1);
         }
     }
 }
@@ -578,27 +1225,13 @@ void imprimir_trie_arvore(TrieNode* root) {
 
     printf("\n=== Estrutura da Árvore Trie ===\n");
     unsigned char path[MAX_WORD_SIZE] = {0};
-    imprimir_trie_arvore_recursivo(root, "", 1, path, 0);
+    imprimir_trie_arvore_recursivo(root, root, "", 1, path, 0);
     printf("===============================\n\n");
 }
 
 // Função de comparação para qsort
 int compare_words(const void* a, const void* b) {
-    return strcasecmp(*(const char**)a, *(const char**)b);
-}
-
-// Estrutura auxiliar para ordenação
-typedef struct {
-    char* word;
-    int* positions;
-    int num_positions;
-} WordEntry;
-
-// Função de comparação para qsort com estruturas
-int compare_word_entries(const void* a, const void* b) {
-    const WordEntry* entry_a = (const WordEntry*)a;
-    const WordEntry* entry_b = (const WordEntry*)b;
-    return strcasecmp(entry_a->word, entry_b->word);
+    return trie_compare_words(*(const char**)a, *(const char**)b);
 }
 
 // Função auxiliar para buscar palavra em uma lista de palavras
@@ -608,103 +1241,40 @@ int find_word_in_array(char** words, int num_words, const char* word) {
     return binary_search_word(words, num_words, word);
 }
 
-void imprimir_indice_trie(TrieNode* root) {
-    if (root == NULL) {
-        printf("Índice trie não foi criado.\n");
-        return;
-    }
-    
-    printf("\n=== Índice Trie ===\n");
-    
-    char prefix[MAX_WORD_SIZE] = "";
-    char** words = (char**)malloc(10 * sizeof(char*));
-    int** positions = (int**)malloc(10 * sizeof(int*));
-    int* num_positions = (int*)malloc(10 * sizeof(int));
-    int num_words = 0;
-    int max_words = 10;
-    
-    trie_get_all_words(root, prefix, &words, &positions, &num_positions, &num_words, &max_words);
+int trie_write_index(TrieNode* root, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out) {
+    if (root == NULL || out == NULL) return 0;
+
+    output_index_begin(out, "Trie");
     
-    // Cria array de estruturas para ordenação mais eficiente
-    WordEntry* entries = (WordEntry*)malloc(num_words * sizeof(WordEntry));
-    if (!entries) {
-        printf("Erro ao alocar memória para ordenação.\n");
-        
-        // Liberação de memória
-        for (int i = 0; i < num_words; i++) {
-            free(words[i]);
-            free(positions[i]);
-        }
-        free(words);
-        free(positions);
-        free(num_positions);
-        return;
+    // O cursor visita as palavras já em ordem alfabética, sem cópias nem ordenação
+    TrieCursor cursor;
+    TrieWord entry;
+    trie_cursor_begin(&cursor, root, NULL);
+    while (trie_cursor_next(&cursor, &entry)) {
+        output_word_begin(out, entry.word);
+        int position;
+        while (posting_cursor_next(&entry.postings, &position)) output_position(out, position);
+        output_word_end(out);
     }
+    trie_cursor_end(&cursor);
     
-    // Preenche estruturas
-    for (int i = 0; i < num_words; i++) {
-        entries[i].word = words[i];
-        entries[i].positions = positions[i];
-        entries[i].num_positions = num_positions[i];
+    // Verifica quais palavras-chave não foram encontradas, buscando cada uma na Trie - O(k m)
+    for (int i = 0; i < num_keywords; i++) {
+        if (!trie_find_node(root, keywords[i])) output_missing(out, keywords[i]);
     }
-    
-    // Ordena com qsort (complexidade n*log(n))
-    qsort(entries, num_words, sizeof(WordEntry), compare_word_entries);
-    
-    // Cria um array auxiliar com apenas as palavras para busca binária
-    char** sorted_words = (char**)malloc(num_words * sizeof(char*));
-    if (!sorted_words) {
-        printf("Erro ao alocar memória para array de palavras ordenadas.\n");
-        // Liberação de memória
-        for (int i = 0; i < num_words; i++) {
-            free(entries[i].word);
-            free(entries[i].positions);
-        }
-        free(entries);
-        free(num_positions);
-        free(words);
-        free(positions);
+    output_index_end(out);
+    return !out->error;
+}
+
+void imprimir_indice_trie(TrieNode* root) {
+    if (root == NULL) {
+        printf("Índice trie não foi criado.\n");
         return;
     }
-    
-    // Preenche o array auxiliar com palavras ordenadas
-    for (int i = 0; i < num_words; i++) {
-        sorted_words[i] = entries[i].word;
-    }
-    
-    // Obtém as palavras-chave que foram utilizadas para criar o índice
-    char (*keywords)[MAX_WORD_SIZE] = get_keywords_trie();
-    int num_keywords = get_num_keywords_trie();
-    
-    // Imprime as palavras em ordem alfabética
-    for (int i = 0; i < num_words; i++) {
-        printf("%s: ", entries[i].word);
-        for (int j = 0; j < entries[i].num_positions; j++) {
-            printf("%d", entries[i].positions[j]);
-            if (j < entries[i].num_positions - 1) printf(", ");
-        }
-        printf("\n");
-    }
-    
-    // Verifica quais palavras-chave não foram encontradas usando busca binária - O(k log n)
-    if (num_keywords > 0) {
-        for (int i = 0; i < num_keywords; i++) {
-            // Usa busca binária em vez de busca linear
-            int found_index = binary_search_word(sorted_words, num_words, keywords[i]);
-            if (found_index == -1) {
-                printf("%s: Não foi encontrada no texto.\n", keywords[i]);
-            }
-        }
-    }
-    
-    // Liberação de memória
-    free(sorted_words);
-    for (int i = 0; i < num_words; i++) {
-        free(entries[i].word);
-        free(entries[i].positions);
-    }
-    free(entries);
-    free(num_positions);
-    free(words);
-    free(positions);
+
+    // Palavras-chave que foram utilizadas para criar o índice
+    OutputWriter out;
+    if (!output_open(&out, STDOUT_FILENO, OUTPUT_PLAIN)) return;
+    trie_write_index(root, get_keywords_trie(), get_num_keywords_trie(), &out);
+    output_close(&out);
 }
\ No newline at end of file
@@ -12,77 +12,233 @@
 * @struct TrieNode
 * @brief Estrutura do nó da árvore Trie
 * @var TrieNode::children
-*    Array de ponteiros para os nós filhos (26 letras + hífen)
+*    Índices (32 bits) dos nós filhos no pool da Trie (26 letras + hífen); 0 = sem filho
 * @var TrieNode::is_end_of_word
 *    Flag que indica se o nó representa o fim de uma palavra
 * @var TrieNode::occurrences
-*    Array com as posições onde a palavra ocorre
+*    Array com as posições onde a palavra ocorre (alocado apenas em fim de palavra)
 * @var TrieNode::num_occurrences
 *    Número atual de ocorrências armazenadas
 * @var TrieNode::max_occurrences
 *    Capacidade máxima do array de ocorrências
 * @var TrieNode::original_word
 *    Armazena a palavra original sem modificações
+* @var TrieNode::stored_utf8
+*    Caractere UTF-8 original armazenado no próprio nó
+* @var TrieNode::packed_occurrences
+*    Ocorrências no formato compactado (delta + varint), ou NULL
+* @var TrieNode::packed_size
+*    Tamanho em bytes das ocorrências compactadas
+*
+* @struct TrieWord
+* @brief Palavra devolvida pelo cursor, sem cópia (os ponteiros apontam para o nó)
+* @var TrieWord::word
+*    Palavra original armazenada no nó
+* @var TrieWord::occurrences
+*    Posições brutas, ou NULL se o nó estiver compactado (usar postings)
+* @var TrieWord::num_occurrences
+*    Número de ocorrências
+* @var TrieWord::postings
+*    Cursor sobre as ocorrências (lê listas brutas ou compactadas)
+*
+* @struct TrieCursor
+* @brief Percurso em ordem (mesma ordem de trie_compare_words) com pilha explícita:
+*        cada quadro guarda o nó e o próximo filho a visitar. A pilha começa no
+*        próprio cursor e só vai para o heap em caminhos com mais de
+*        TRIE_CURSOR_INLINE níveis; o cursor não deve ser copiado depois de iniciado
 *
 * @fn TrieNode* trie_create_node()
-* @brief Cria um novo nó da Trie
+* @brief Cria uma nova Trie: o nó raiz e o pool de nós (slabs) que a acompanha
+*
+* @fn TrieNode* trie_node_at(const TrieNode* root, uint32_t index)
+* @brief Converte um índice do pool no ponteiro do nó (0 = raiz)
+*
+* @fn TrieNode* trie_node_child(const TrieNode* root, const TrieNode* node, int index)
+* @brief Retorna o filho de um nó para o símbolo index (0-26), ou NULL
+*
+* @fn uint32_t trie_node_count(const TrieNode* root)
+* @brief Número de nós da Trie, incluindo a raiz
+*
+* @fn size_t trie_pool_bytes(const TrieNode* root)
+* @brief Memória reservada pelo pool de nós (slabs inteiros e vetor de slabs)
 *
 * @fn void trie_insert(TrieNode* root, const char* word, int position)
 * @brief Insere uma palavra e sua posição na Trie
 *
 * @fn int* trie_search(TrieNode* root, const char* word, int* num_occurrences)
-* @brief Busca uma palavra na Trie e retorna suas ocorrências
+* @brief Busca uma palavra na Trie e retorna suas ocorrências (NULL se o nó estiver compactado)
+*
+* @fn int trie_search_cursor(TrieNode* root, const char* word, PostingCursor* cursor)
+* @brief Busca uma palavra e inicializa um cursor sobre suas ocorrências (brutas ou compactadas)
+*
+* @fn int trie_search_batch(TrieNode* root, const char* const words[], int n, int* results[], int counts[])
+* @brief Busca um lote de palavras descendo um nível de cada vez em todas as buscas de um
+*        grupo de TRIE_BATCH_SIZE, com pré-carregamento do próximo nó de cada uma
+* @param results Recebe, para cada palavra, o mesmo ponteiro que trie_search retornaria
+* @param counts Recebe o número de ocorrências de cada palavra (pode ser NULL)
+* @return Número de palavras encontradas
+*
+* @fn void trie_compact(TrieNode* root)
+* @brief Converte as ocorrências de todos os nós para o formato compactado
+*
+* @fn int trie_cursor_begin(TrieCursor* cursor, const TrieNode* root, const char* prefix)
+* @brief Posiciona o cursor nas palavras que começam por prefix (normalizado como as
+*        palavras; NULL ou "" percorre a Trie inteira)
+* @return 1 se alguma palavra pode ter o prefixo, 0 se o caminho não existe
+*
+* @fn int trie_cursor_next(TrieCursor* cursor, TrieWord* out)
+* @brief Avança para a próxima palavra; parar antes do fim é permitido
+* @return 1 se out foi preenchido, 0 no fim (ou em falha de alocação da pilha)
+*
+* @fn void trie_cursor_end(TrieCursor* cursor)
+* @brief Libera a pilha do cursor, se ela tiver ido para o heap
 *
 * @fn void trie_get_all_words(TrieNode* root, char* prefix, char*** words, int*** positions, int** num_positions, int* num_words, int* max_words)
-* @brief Recupera todas as palavras armazenadas na Trie
+* @brief Recupera cópias de todas as palavras armazenadas na Trie, em ordem (via TrieCursor;
+*        prefix não é usado)
 *
 * @fn void trie_destroy(TrieNode* root)
-* @brief Libera a memória alocada para a Trie
+* @brief Libera a memória alocada para a Trie (percorre os slabs, sem recursão)
+*
+* @fn int criar_indice_trie(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords)
+* @brief Cria um índice remissivo utilizando a estrutura Trie (não altera palavras/posicoes)
+*
+* @fn int trie_collect_keywords(char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords, TrieKeywordVisitor visitar, void* ctx)
+* @brief Reúne, para cada chave da Trie das palavras-chave, as posições de todas as
+*        palavras do texto com essa chave (todas as grafias, em ordem) e as entrega a
+*        visitar uma vez por chave, com a primeira palavra-chave que a tem
+* @return 1 se sucesso, 0 em falha de alocação
 *
-* @fn int criar_indice_trie(TrieNode** root, char* palavras[], int* posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords)
-* @brief Cria um índice remissivo utilizando a estrutura Trie
+* @fn int criar_indice_trie_paralelo(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras, char keywords[][MAX_WORD_SIZE], int num_keywords, int num_threads)
+* @brief Cria o índice com num_threads threads (até TRIE_MAX_THREADS); 1 ou menos usa criar_indice_trie
+*
+* @fn void trie_insert_positions(TrieNode* root, const char* word, const int* positions, int count)
+* @brief Acrescenta uma lista de posições a uma palavra, percorrendo o caminho uma única vez
+*        (uma lista que não vem depois das posições existentes é intercalada com elas)
+*
+* @fn int trie_append_indice(TrieNode* root, char* const palavras[], int* const posicoes[], int num_palavras, int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira)
+* @brief Acrescenta ao índice as ocorrências de uma parte do texto, sem reconstruí-lo
+*        (mesmos parâmetros de hash_append_indice: palavras distintas da parte, suas
+*        listas locais, a posição global base e as palavras-chave novas a partir de primeira)
+*
+* @fn int trie_write_index(TrieNode* root, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out)
+* @brief Escreve o índice (em ordem, pelo TrieCursor) e as palavras-chave ausentes em uma
+*        saída com buffer (texto, CSV ou JSON)
+* @return 1 se sucesso, 0 se root ou out for NULL ou em falha de escrita
 *
 * @fn void imprimir_indice_trie(TrieNode* root)
-* @brief Imprime o índice remissivo armazenado na Trie
+* @brief Imprime o índice remissivo armazenado na Trie (trie_write_index em texto, na saída padrão)
 *
 * @fn void imprimir_trie_arvore(TrieNode* root)
 * @brief Imprime a estrutura da árvore Trie
 *
 * @fn int binary_search_word(char* palavras[], int num_palavras, const char* palavra)
-* @brief Realiza busca binária em um array ordenado de palavras
+* @brief Realiza busca binária em um array ordenado por sort_palavras_com_posicoes (compara as chaves de ordenação)
+*
+* @fn void sort_palavras_com_posicoes(char* palavras[], int* posicoes[], int num_palavras)
+* @brief Ordena as palavras pela chave de ordenação da Trie (multikey quicksort),
+*        mantendo cada uma associada ao seu array de posições
+*
+* @fn int trie_sort_key(const char* word, unsigned char* out, int max_len)
+* @brief Gera a chave de ordenação: chave da Trie com os símbolos trocados por 1-27
+*        (a-z, depois hífen), na mesma ordem em que a Trie visita os filhos
+* @return Tamanho da chave
+*
+* @fn int trie_compare_words(const char* a, const char* b)
+* @brief Compara duas palavras pelas chaves de ordenação (mesma ordem de sort_palavras_com_posicoes)
+*
+* @fn int trie_normalize_word(const char* word, char* out, int max_len)
+* @brief Converte uma palavra na chave normalizada usada pela Trie ('a'-'z' e '-')
 */
 
 #ifndef TRIE_H
 #define TRIE_H
  
 #define MAX_WORD_SIZE 100
+#define TRIE_MAX_THREADS 64 // Limite de threads da criação paralela
+#define TRIE_BATCH_SIZE 16  // Palavras por grupo em trie_search_batch
+#define TRIE_CURSOR_INLINE 64 // Níveis da pilha guardados no próprio TrieCursor
+#include <stdint.h>
 #include "indice_remissivo.h"
+#include "output.h"
  
 //Definição da estrutura do nó da Trie
 typedef struct TrieNode {
-    struct TrieNode* children[27]; // Alterado para 27 (26 letras + hífen)
+    uint32_t children[27]; // Índices no pool (26 letras + hífen), 0 = sem filho
     int is_end_of_word;
     int* occurrences;
     int num_occurrences;
     int max_occurrences;
+    unsigned char* packed_occurrences; // Ocorrências compactadas (delta + varint)
+    int packed_size;
     char* original_word; // ARMAZENA A PALAVRA ORIGINAL, NÃO ALTERE
-    char stored_char[10]; // Caractere armazenado no nó 
-    unsigned char* stored_utf8; // Caractere UTF-8 armazenado no nó
+    char stored_utf8[5]; // Caractere UTF-8 armazenado no nó
 } TrieNode;
+
+//Palavra devolvida pelo cursor (aponta para os dados do nó)
+typedef struct {
+    const char* word;
+    const int* occurrences; // NULL se compactado
+    int num_occurrences;
+    PostingCursor postings;
+} TrieWord;
+
+//Quadro da pilha do cursor
+typedef struct {
+    uint32_t node;
+    int next_child; // Próximo símbolo a examinar; -1 = nó ainda não emitido
+} TrieCursorFrame;
+
+//Cursor em ordem sobre as palavras da Trie
+typedef struct {
+    const TrieNode* root;
+    TrieCursorFrame* stack;
+    int depth;
+    int capacity;
+    TrieCursorFrame inline_stack[TRIE_CURSOR_INLINE];
+} TrieCursor;
+ 
+//Recebe as posições de uma palavra-chave reunidas por trie_collect_keywords
+typedef void (*TrieKeywordVisitor)(void* ctx, const char* keyword, const int* positions, int count);
  
 //Protótipos das funções da Trie
 TrieNode* trie_create_node();
+TrieNode* trie_node_at(const TrieNode* root, uint32_t index);
+TrieNode* trie_node_child(const TrieNode* root, const TrieNode* node, int index);
+uint32_t trie_node_count(const TrieNode* root);
+size_t trie_pool_bytes(const TrieNode* root);
 void trie_insert(TrieNode* root, const char* word, int position);
+void trie_insert_positions(TrieNode* root, const char* word, const int* positions, int count);
 int* trie_search(TrieNode* root, const char* word, int* num_occurrences);
+int trie_search_cursor(TrieNode* root, const char* word, PostingCursor* cursor);
+int trie_search_batch(TrieNode* root, const char* const words[], int n, int* results[], int counts[]);
+void trie_compact(TrieNode* root);
+int trie_cursor_begin(TrieCursor* cursor, const TrieNode* root, const char* prefix);
+int trie_cursor_next(TrieCursor* cursor, TrieWord* out);
+void trie_cursor_end(TrieCursor* cursor);
 void trie_get_all_words(TrieNode* root, char* prefix, char*** words, int*** positions, 
                         int** num_positions, int* num_words, int* max_words);
 void trie_destroy(TrieNode* root);
-int criar_indice_trie(TrieNode** root, char* palavras[], int* posicoes[], int num_palavras, 
+int criar_indice_trie(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras, 
                      char keywords[][MAX_WORD_SIZE], int num_keywords);
+int trie_collect_keywords(char* const palavras[], int* const posicoes[], int num_palavras,
+                          char keywords[][MAX_WORD_SIZE], int num_keywords,
+                          TrieKeywordVisitor visitar, void* ctx);
+int criar_indice_trie_paralelo(TrieNode** root, char* const palavras[], int* const posicoes[], int num_palavras,
+                               char keywords[][MAX_WORD_SIZE], int num_keywords, int num_threads);
+int trie_append_indice(TrieNode* root, char* const palavras[], int* const posicoes[], int num_palavras,
+                       int base, char keywords[][MAX_WORD_SIZE], int num_keywords, int primeira);
+int trie_write_index(TrieNode* root, char keywords[][MAX_WORD_SIZE], int num_keywords, OutputWriter* out);
 void imprimir_indice_trie(TrieNode* root);
 void imprimir_trie_arvore(TrieNode* root);
  
 //Função de busca binária para encontrar palavras em array ordenado
 int binary_search_word(char* palavras[], int num_palavras, const char* palavra);
+void sort_palavras_com_posicoes(char* palavras[], int* posicoes[], int num_palavras);
+int trie_sort_key(const char* word, unsigned char* out, int max_len);
+int trie_compare_words(const char* a, const char* b);
+
+//Normalização de palavras para o alfabeto da Trie
+int trie_normalize_word(const char* word, char* out, int max_len);
  
 #endif /* TRIE_H */
\ No newline at end of file
@@ -12,21 +12,28 @@
  * @note Utiliza variáveis globais para manter estado das estruturas de dados
  * 
  * Variáveis globais:
- * - texto_hash, texto_trie: Armazenam os textos para processamento
- * - palavras_hash, palavras_trie: Arrays de palavras extraídas
- * - posicoes_hash, posicoes_trie: Arrays com posições das palavras
- * - num_palavras_hash, num_palavras_trie: Contadores de palavras
- * - keywords_hash, keywords_trie: Arrays de palavras-chave
- * - num_keywords_hash, num_keywords_trie: Contadores de palavras-chave
+ * - corpus_hash, corpus_trie, corpus_radix: Referências ao corpus de tokens usado por cada índice
+ * - keywords_hash, keywords_trie, keywords_radix: Arrays de palavras-chave
+ * - num_keywords_hash, num_keywords_trie, num_keywords_radix: Contadores de palavras-chave
  * - trie_root: Raiz da árvore Trie
+ * - radix_root: Raiz da árvore Radix
+ * - aho_automaton: Autômato de Aho-Corasick (guarda suas próprias palavras-chave)
  * - hash_table: Tabela hash
+ * - indice_salvo: Índices Hash/Trie carregados de um arquivo (store.h), usados no lugar
+ *   dos construídos
+ * - compactar_ocorrencias: Indica se as ocorrências devem ser compactadas após a criação
  *
  * Funções principais:
- * - carregar_arquivo_texto(): Carrega texto de arquivo
  * - carregar_keywords(): Carrega palavras-chave de arquivo
- * - processar_texto(): Extrai e processa palavras do texto
+ * - ler_keywords_arquivo(): Lê palavras-chave separadas por vírgulas e linhas (menu e
+ *   modo em lote)
+ * - processar_texto(): Extrai e processa palavras de um texto em memória
+ * - processar_arquivo(): Extrai e processa palavras de um arquivo (mmap ou leitura em blocos)
  * - limpar_recursos_hash(): Libera recursos da tabela hash
  * - limpar_recursos_trie(): Libera recursos da árvore Trie
+ * - limpar_recursos_radix(): Libera recursos da árvore Radix
+ * - limpar_recursos_aho(): Libera o autômato de Aho-Corasick
+ * - limpar_recursos_salvo(): Fecha o arquivo de índices carregado
  * - limpar_recursos(): Libera todos os recursos alocados
  *
  * Além de várias funções getters e setters para acesso às variáveis globais
@@ -35,39 +42,37 @@
 #include "indice_remissivo.h"
 #include "trie.h"
 #include "hash.h"
+#include "radix.h"
+#include "aho.h"
+#include "scan.h"
+#include "store.h"
+#include "normalize.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Variáveis globais modificadas para suportar múltiplos textos e keywords
-static char texto_hash[MAX_TEXT_SIZE];
-static char texto_trie[MAX_TEXT_SIZE];
-static char* palavras_hash[MAX_TEXT_SIZE];
-static char* palavras_trie[MAX_TEXT_SIZE];
-static int* posicoes_hash[MAX_TEXT_SIZE];
-static int* posicoes_trie[MAX_TEXT_SIZE];
-static int num_palavras_hash = 0;
-static int num_palavras_trie = 0;
+static TokenCorpus* corpus_hash = NULL;   // Referências emprestadas, liberadas com corpus_release
+static TokenCorpus* corpus_trie = NULL;
+static TokenCorpus* corpus_radix = NULL;
 static char keywords_hash[MAX_KEYWORDS][MAX_WORD_SIZE];
 static char keywords_trie[MAX_KEYWORDS][MAX_WORD_SIZE];
+static char keywords_radix[MAX_KEYWORDS][MAX_WORD_SIZE];
 static int num_keywords_hash = 0;
 static int num_keywords_trie = 0;
+static int num_keywords_radix = 0;
 static TrieNode* trie_root = NULL;
+static RadixNode* radix_root = NULL;
+static AhoAutomaton* aho_automaton = NULL;
 static HashTable* hash_table = NULL;
-
-// Função para carregar o texto
-int carregar_arquivo_texto(const char* filename, char* texto) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Erro ao abrir o arquivo: %s\n", filename);
-        return 0;
-    }
-    size_t len = fread(texto, 1, MAX_TEXT_SIZE - 1, file);
-    texto[len] = '\0';
-    fclose(file);
-    return 1;
-}
+static IndexStore* indice_salvo = NULL;
+static int compactar_ocorrencias = 0;  // Compacta as ocorrências após criar os índices
 
 // Função para carregar palavras-chave
 int carregar_keywords(const char* filename, char keywords[][MAX_WORD_SIZE], int* num_keywords) {
@@ -83,154 +88,522 @@ int carregar_keywords(const char* filename, char keywords[][MAX_WORD_SIZE], int*
         for (int i = 0; buffer[i]; i++) {
             buffer[i] = tolower(buffer[i]);
         }
-        strncpy(keywords[(*num_keywords)++], buffer, MAX_WORD_SIZE - 1);
-        keywords[*num_keywords - 1][MAX_WORD_SIZE - 1] = '\0'; // Garante terminação nula
+        snprintf(keywords[(*num_keywords)++], MAX_WORD_SIZE, "%s", buffer); // Garante terminação nula
     }
     fclose(file);
     return 1;
 }
 
-// Processar texto (extrair palavras e posições)
-void processar_texto(char* texto, char* palavras[], int* posicoes[], int* num_palavras) {
-    if (!texto || !palavras || !posicoes || !num_palavras) {
-        return;
+// Remove de uma palavra-chave tudo que não é letra, dígito, hífen ou byte UTF-8
+static void sanitize_keyword(char *str) {
+    char *src = str;
+    char *dst = str;
+    while (*src) {
+        unsigned char uc = (unsigned char)*src;
+        if (isalnum(uc) || uc == '-' || uc > 127) {
+            *dst++ = *src;
+        }
+        src++;
     }
+    *dst = '\0';
+}
+
+// Lê palavras-chave separadas por vírgulas (várias por linha) e as acrescenta a
+// keywords a partir de primeira, ignorando as que já estão em keywords[0..primeira)
+int ler_keywords_arquivo(const char* filename, char keywords[][MAX_WORD_SIZE], int primeira, int* conteudo) {
+    char buffer[1024];  // Buffer para ler uma linha inteira
+    FILE *file = fopen(filename, "r");
+    if (!file) return -1;
     
-    *num_palavras = 0;
+    int num_keywords = primeira;
+    int has_non_whitespace = 0;  // Flag para verificar se há conteúdo não-branco
     
-    // Garantir inicialização segura
-    for (int i = 0; i < MAX_TEXT_SIZE; i++) {
-        palavras[i] = NULL;
-        posicoes[i] = NULL;
+    while (fgets(buffer, sizeof(buffer), file) && num_keywords < MAX_KEYWORDS) {
+        buffer[strcspn(buffer, "\n")] = '\0';  // Remove newline
+        
+        // Verifica se a linha tem algum caractere não-branco
+        for (int i = 0; buffer[i]; i++) {
+            if (buffer[i] != ' ' && buffer[i] != '\t') {
+                has_non_whitespace = 1;
+                break;
+            }
+        }
+        
+        if (!has_non_whitespace) continue;  // Pula linhas que só têm espaços
+        
+        char *token = strtok(buffer, ",");  // Divide a linha por vírgulas
+        while (token && num_keywords < MAX_KEYWORDS) {
+            // Remove espaços e sanitiza
+            while (*token == ' ') token++;
+            int len = strlen(token);
+            while (len > 0 && token[len-1] == ' ') token[--len] = '\0';
+
+            // Sanitiza o token (remove pontuações)
+            sanitize_keyword(token);
+            len = strlen(token);
+
+            // Ao acrescentar, palavras-chave já carregadas são ignoradas
+            int repetida = 0;
+            for (int k = 0; k < primeira && len > 0 && !repetida; k++) {
+                repetida = strcmp(keywords[k], token) == 0;
+            }
+
+            if (len > 0 && !repetida) {
+                strncpy(keywords[num_keywords], token, MAX_WORD_SIZE - 1);
+                keywords[num_keywords][MAX_WORD_SIZE - 1] = '\0';
+                num_keywords++;
+            }
+            token = strtok(NULL, ",");
+        }
     }
     
-    char* texto_copia = strdup(texto);
-    if (!texto_copia) {
-        fprintf(stderr, "Falha ao copiar texto\n");
-        return;
-    }
-
-    // Tokenização
-    char* saveptr;
-    char* token = strtok_r(texto_copia, " \t\n\r\f\v.,;:!?\"'()[]{}", &saveptr);
-    while (token && *num_palavras < MAX_TEXT_SIZE) {
-        palavras[*num_palavras] = strdup(token);
-        if (!palavras[*num_palavras]) {
+    fclose(file);
+    if (conteudo) *conteudo = has_non_whitespace;
+    return num_keywords;
+}
+
+// Delimitadores utilizados na tokenização do texto
+#define DELIMITADORES " \t\n\r\f\v.,;:!?\"'()[]{}"
+
+// Tamanho dos blocos lidos quando o arquivo não pode ser mapeado com mmap
+#define TAMANHO_BLOCO (64 * 1024)
+
+// Tabela de delimitadores (1 = separa palavras), montada a partir de DELIMITADORES
+// e classificação vetorial correspondente, usada para achar as fronteiras das palavras
+static unsigned char eh_delimitador[256];
+static ClasseBytes classe_texto;
+static int tabela_delimitadores_pronta = 0;
+
+static void preparar_delimitadores(void) {
+    if (tabela_delimitadores_pronta) return;
+    for (const char* d = DELIMITADORES; *d; d++) {
+        eh_delimitador[(unsigned char)*d] = 1;
+    }
+    eh_delimitador[0] = 1;  // '\0' também separa palavras (texto vindo de string C)
+    scan_preparar(&classe_texto, eh_delimitador);
+    tabela_delimitadores_pronta = 1;
+}
+
+// Tabela de delimitadores para quem percorre o texto sem tokenizá-lo
+const unsigned char* tabela_delimitadores(void) {
+    preparar_delimitadores();
+    return eh_delimitador;
+}
+
+// Estado da tokenização incremental. O texto é consumido em blocos;
+// uma palavra que atravessa o fim de um bloco fica em 'parcial' até ser concluída.
+// Cada palavra distinta é guardada uma única vez (em minúsculas) e recebe um
+// identificador, obtido pela tabela hash auxiliar 'vistas' (guardado em occurrences[0]).
+// Palavras longas demais para a chave completa da tabela (MAX_WORD_SIZE - 1 bytes)
+// ficam em 'longas', onde a mesma chave truncada guarda vários identificadores
+typedef struct {
+    HashTable* vistas;
+    HashTable* longas;   // Criada na primeira palavra longa
+    char** distintas;    // Palavra de cada identificador
+    int* contagem;       // Ocorrências de cada palavra distinta
+    int num_distintas;
+    int max_distintas;
+    int* id_token;       // Identificador de cada token
+    int num_tokens;
+    int max_tokens;
+    char* parcial;       // Palavra em construção (atravessou um bloco) e área de trabalho
+    size_t tam_parcial;
+    size_t cap_parcial;
+    int falhou;
+} Tokenizador;
+
+static int tokenizador_iniciar(Tokenizador* tk) {
+    memset(tk, 0, sizeof(*tk));
+    preparar_delimitadores();
+    tk->vistas = hash_create(INITIAL_HASH_SIZE);
+    tk->max_distintas = 1000;
+    tk->max_tokens = 1000;
+    tk->cap_parcial = MAX_WORD_SIZE;
+    tk->distintas = malloc(tk->max_distintas * sizeof(char*));
+    tk->contagem = malloc(tk->max_distintas * sizeof(int));
+    tk->id_token = malloc(tk->max_tokens * sizeof(int));
+    tk->parcial = malloc(tk->cap_parcial);
+    if (!tk->distintas || !tk->contagem || !tk->id_token || !tk->parcial) {
+        fprintf(stderr, "Falha ao alocar memória para tokenização\n");
+        tk->falhou = 1;
+        return 0;
+    }
+    return 1;
+}
+
+// Libera o estado; as palavras distintas só são liberadas se não foram entregues ao corpus
+static void tokenizador_liberar(Tokenizador* tk) {
+    if (tk->distintas) {
+        for (int i = 0; i < tk->num_distintas; i++) free(tk->distintas[i]);
+    }
+    hash_destroy(tk->vistas);
+    hash_destroy(tk->longas);
+    free(tk->distintas);
+    free(tk->contagem);
+    free(tk->id_token);
+    free(tk->parcial);
+}
+
+// Acrescenta bytes à palavra parcial, ampliando o buffer se necessário
+static int tokenizador_acumular(Tokenizador* tk, const char* dados, size_t len) {
+    if (tk->tam_parcial + len + 1 > tk->cap_parcial) {
+        size_t nova_cap = tk->cap_parcial * 2;
+        while (nova_cap < tk->tam_parcial + len + 1) nova_cap *= 2;
+        char* novo = realloc(tk->parcial, nova_cap);
+        if (!novo) {
             fprintf(stderr, "Falha ao alocar memória para palavra\n");
-            free(texto_copia);
-            return;
-        }
-        
-        // Converter para minúsculas
-        for (int i = 0; palavras[*num_palavras][i]; i++) {
-            palavras[*num_palavras][i] = tolower(palavras[*num_palavras][i]);
+            tk->falhou = 1;
+            return 0;
         }
+        tk->parcial = novo;
+        tk->cap_parcial = nova_cap;
+    }
+    memcpy(tk->parcial + tk->tam_parcial, dados, len);
+    tk->tam_parcial += len;
+    return 1;
+}
+
+// Chave normalizada completa de uma palavra (normalize_key não trunca,
+// pois a chave nunca é maior que a palavra)
+static char* chave_completa(const char* palavra) {
+    size_t len = strlen(palavra);
+    char* chave = malloc(len + 1);
+    if (chave) normalize_key(palavra, chave, (int)len + 1);
+    return chave;
+}
+
+// Procura em 'longas' uma palavra de pelo menos MAX_WORD_SIZE bytes: as candidatas
+// com a mesma chave truncada são comparadas pela chave completa.
+// Retorna o identificador, ou -1 se a palavra é nova
+static int tokenizador_buscar_longa(Tokenizador* tk, const char* palavra) {
+    if (!tk->longas && !(tk->longas = hash_create(INITIAL_HASH_SIZE))) {
+        fprintf(stderr, "Falha ao alocar memória para tokenização\n");
+        tk->falhou = 1;
+        return -1;
+    }
+
+    int n;
+    int* candidatas = hash_search(tk->longas, palavra, &n);
+    if (!candidatas) return -1;
 
-        // Alocar espaço para posições (primeiro elemento será o contador)
-        posicoes[*num_palavras] = calloc(MAX_TEXT_SIZE, sizeof(int));
-        if (!posicoes[*num_palavras]) {
-            fprintf(stderr, "Falha ao alocar memória para posições\n");
-            free(palavras[*num_palavras]);
-            palavras[*num_palavras] = NULL;
-            free(texto_copia);
+    int id = -1;
+    char* chave = chave_completa(palavra);
+    for (int k = 0; chave && k < n && id < 0 && !tk->falhou; k++) {
+        char* outra = chave_completa(tk->distintas[candidatas[k]]);
+        if (!outra) tk->falhou = 1;
+        else if (strcmp(chave, outra) == 0) id = candidatas[k];
+        free(outra);
+    }
+    if (!chave) tk->falhou = 1;
+    if (tk->falhou) fprintf(stderr, "Falha ao alocar memória para palavra\n");
+    free(chave);
+    return id;
+}
+
+// Registra o token guardado em 'parcial' e esvazia o buffer
+static void tokenizador_emitir(Tokenizador* tk) {
+    char* palavra = tk->parcial;
+    size_t len = tk->tam_parcial;
+    tk->tam_parcial = 0;
+    if (tk->falhou || len == 0) return;
+
+    // Converter para minúsculas (só A-Z; bytes UTF-8 ficam para a normalização)
+    scan_minusculas(palavra, len);
+    palavra[len] = '\0';
+
+    // Expande os arrays auxiliares se necessário
+    if (tk->num_tokens >= tk->max_tokens) {
+        int* novo_id = realloc(tk->id_token, 2 * (size_t)tk->max_tokens * sizeof(int));
+        if (!novo_id) {
+            fprintf(stderr, "Falha ao alocar memória para tokenização\n");
+            tk->falhou = 1;
             return;
         }
-        posicoes[*num_palavras][0] = 0; // Inicializa o contador
-        (*num_palavras)++;
-        token = strtok_r(NULL, " \t\n\r\f\v.,;:!?\"'()[]{}", &saveptr);
-    }
-
-    // Contar ocorrências
-    for (int i = 0; i < *num_palavras; i++) {
-        for (int j = 0; j < *num_palavras; j++) {
-            // Comparação case-insensitive usando strcmp após converter para minúsculas
-            if (strcmp(palavras[i], palavras[j]) == 0) {
-                if (posicoes[i][0] < MAX_TEXT_SIZE - 1) {
-                    posicoes[i][++posicoes[i][0]] = j;
-                }
+        tk->id_token = novo_id;
+        tk->max_tokens *= 2;
+    }
+
+    int id = -1;
+    int longa = len >= MAX_WORD_SIZE;
+    if (longa) {
+        id = tokenizador_buscar_longa(tk, palavra);
+        if (tk->falhou) return;
+    } else {
+        int n;
+        int* encontrado = hash_search(tk->vistas, palavra, &n);
+        if (encontrado) id = encontrado[0];
+    }
+    if (id < 0) {
+        if (tk->num_distintas >= tk->max_distintas) {
+            int nova_max = tk->max_distintas * 2;
+            char** novas = realloc(tk->distintas, nova_max * sizeof(char*));
+            if (novas) tk->distintas = novas;
+            int* nova_contagem = novas ? realloc(tk->contagem, nova_max * sizeof(int)) : NULL;
+            if (nova_contagem) tk->contagem = nova_contagem;
+            if (!novas || !nova_contagem) {
+                fprintf(stderr, "Falha ao alocar memória para tokenização\n");
+                tk->falhou = 1;
+                return;
             }
+            tk->max_distintas = nova_max;
         }
+        char* copia = malloc(len + 1);
+        if (!copia) {
+            fprintf(stderr, "Falha ao alocar memória para palavra\n");
+            tk->falhou = 1;
+            return;
+        }
+        memcpy(copia, palavra, len + 1);
+        id = tk->num_distintas++;
+        tk->distintas[id] = copia;
+        tk->contagem[id] = 0;
+        hash_insert(longa ? tk->longas : tk->vistas, palavra, id);
     }
-    free(texto_copia);
+    tk->id_token[tk->num_tokens++] = id;
+    tk->contagem[id]++;
 }
 
-// Limpar recursos - modificada para limpar recursos específicos
-void limpar_recursos_hash(void) {
-    for (int i = 0; i < num_palavras_hash; i++) {
-        if (palavras_hash[i]) {
-            free(palavras_hash[i]);
-            palavras_hash[i] = NULL;
+// Consome um bloco do texto. Cada palavra é copiada para 'parcial', onde é
+// convertida para minúsculas e registrada; a palavra que termina no fim do
+// bloco continua em 'parcial' até o próximo. O texto não é copiado: só cada
+// palavra distinta recebe uma cópia própria, na primeira ocorrência
+static void tokenizador_alimentar(Tokenizador* tk, const char* dados, size_t tamanho) {
+    size_t i = 0;
+    while (i < tamanho && !tk->falhou) {
+        // Pula delimitadores (uma palavra parcial termina no primeiro deles)
+        size_t inicio = scan_pular(&classe_texto, dados, i, tamanho);
+        if (inicio > i && tk->tam_parcial) tokenizador_emitir(tk);
+        if (inicio == tamanho) break;
+
+        i = scan_palavra(&classe_texto, dados, inicio, tamanho);
+        if (!tokenizador_acumular(tk, dados + inicio, i - inicio)) return;
+        if (i < tamanho) tokenizador_emitir(tk);
+    }
+}
+
+// Conclui a tokenização e monta as listas de posições do corpus
+static int tokenizador_concluir(Tokenizador* tk, TokenCorpus* corpus) {
+    if (tk->tam_parcial) tokenizador_emitir(tk);
+    if (tk->falhou) return 0;
+
+    int num = tk->num_tokens;
+    char** palavras = malloc((num > 0 ? num : 1) * sizeof(char*));
+    int** posicoes = malloc((num > 0 ? num : 1) * sizeof(int*));
+    int** listas = malloc((tk->num_distintas > 0 ? tk->num_distintas : 1) * sizeof(int*));
+    PostingStore* ps = postings_create(tk->num_distintas);
+    int falhou = !palavras || !posicoes || !listas;
+
+    // Reserva na arena uma lista de tamanho exato por palavra distinta
+    for (int id = 0; id < tk->num_distintas && !falhou; id++) {
+        if (postings_reserve(ps, tk->contagem[id]) != id) falhou = 1;
+    }
+
+    // Preenche as listas em ordem de posição - O(n)
+    for (int i = 0; i < num && !falhou; i++) {
+        postings_append(ps, tk->id_token[i], i);
+    }
+
+    if (falhou) {
+        fprintf(stderr, "Falha ao alocar memória para posições\n");
+        free(palavras);
+        free(posicoes);
+        free(listas);
+        postings_destroy(ps);
+        return 0;
+    }
+
+    // Todos os tokens de uma mesma palavra compartilham a mesma palavra e a mesma lista
+    for (int i = 0; i < num; i++) {
+        palavras[i] = tk->distintas[tk->id_token[i]];
+        posicoes[i] = postings_view(ps, tk->id_token[i]);
+    }
+    for (int id = 0; id < tk->num_distintas; id++) {
+        listas[id] = postings_view(ps, id);
+    }
+
+    corpus->palavras = palavras;
+    corpus->posicoes = posicoes;
+    corpus->num_palavras = num;
+    corpus->distintas = tk->distintas;
+    corpus->num_distintas = tk->num_distintas;
+    corpus->listas = listas;
+    corpus->postings = ps;
+    tk->distintas = NULL;  // Agora pertencem ao corpus
+    return 1;
+}
+
+// Processar texto (extrair palavras e posições)
+// Constrói as listas palavra -> posições em uma única passada linear sobre o
+// texto, sem copiá-lo. As listas ficam em um PostingStore compartilhado;
+// posicoes[i] é apenas uma visão da lista da palavra do token i
+int processar_texto(const char* texto, size_t tamanho, TokenCorpus* corpus) {
+    if (!texto || !corpus) return 0;
+
+    Tokenizador tk;
+    int ok = tokenizador_iniciar(&tk);
+    if (ok) {
+        tokenizador_alimentar(&tk, texto, tamanho);
+        ok = tokenizador_concluir(&tk, corpus);
+    }
+    tokenizador_liberar(&tk);
+    return ok;
+}
+
+// Percorre um arquivo de qualquer tamanho, entregando seu conteúdo a 'consumir'.
+// Arquivos regulares são mapeados com mmap e entregues de uma vez; se isso não for
+// possível (pipes, dispositivos), o arquivo é lido em blocos de TAMANHO_BLOCO bytes.
+// 'consumir' retorna 0 para interromper a leitura.
+// Retorna -1 se o arquivo não pôde ser aberto, 0 em falha e 1 se sucesso
+int percorrer_arquivo(const char* filename, int (*consumir)(void* ctx, const char* dados, size_t tamanho),
+                      void* ctx) {
+    if (!filename || !consumir) return 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erro ao abrir o arquivo: %s\n", filename);
+        return -1;
+    }
+
+    int ok = 1;
+    int mapeado = 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t tamanho = (size_t)st.st_size;
+        void* mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            posix_madvise(mapa, tamanho, POSIX_MADV_SEQUENTIAL);
+            ok = consumir(ctx, (const char*)mapa, tamanho);
+            munmap(mapa, tamanho);
+            mapeado = 1;
+        }
+    }
+
+    if (!mapeado) {
+        char* bloco = malloc(TAMANHO_BLOCO);
+        if (!bloco) {
+            fprintf(stderr, "Falha ao alocar memória para leitura\n");
+            ok = 0;
         }
-        if (posicoes_hash[i]) {
-            free(posicoes_hash[i]);
-            posicoes_hash[i] = NULL;
+        ssize_t lidos;
+        while (bloco && ok && (lidos = read(fd, bloco, TAMANHO_BLOCO)) != 0) {
+            if (lidos < 0) {
+                if (errno == EINTR) continue;
+                fprintf(stderr, "Erro ao ler o arquivo: %s\n", filename);
+                ok = 0;
+                break;
+            }
+            ok = consumir(ctx, bloco, (size_t)lidos);
         }
+        free(bloco);
+    }
+    close(fd);
+    return ok;
+}
+
+// Entrega um bloco do arquivo ao tokenizador (adaptador para percorrer_arquivo)
+static int tokenizador_consumir(void* ctx, const char* dados, size_t tamanho) {
+    Tokenizador* tk = (Tokenizador*)ctx;
+    tokenizador_alimentar(tk, dados, tamanho);
+    return !tk->falhou;
+}
+
+// Processa um arquivo de texto sem limite de tamanho, sem copiá-lo para a memória.
+// Retorna -1 se o arquivo não pôde ser aberto, 0 em falha de processamento e 1 se sucesso
+int processar_arquivo(const char* filename, TokenCorpus* corpus) {
+    if (!filename || !corpus) return 0;
+
+    Tokenizador tk;
+    if (!tokenizador_iniciar(&tk)) {
+        tokenizador_liberar(&tk);
+        return 0;
     }
+
+    int lido = percorrer_arquivo(filename, tokenizador_consumir, &tk);
+    int ok = lido == 1 && tokenizador_concluir(&tk, corpus);
+    tokenizador_liberar(&tk);
+    return lido < 0 ? -1 : ok;
+}
+
+// Limpar recursos - modificada para limpar recursos específicos
+void limpar_recursos_hash(void) {
+    corpus_release(corpus_hash);
+    corpus_hash = NULL;
     if (hash_table) {
         hash_destroy(hash_table);
         hash_table = NULL;
     }
-    num_palavras_hash = 0;
     // Não limpa num_keywords_hash pois as palavras-chave são carregadas separadamente
 }
 
 void limpar_recursos_trie(void) {
-    for (int i = 0; i < num_palavras_trie; i++) {
-        if (palavras_trie[i]) {
-            free(palavras_trie[i]);
-            palavras_trie[i] = NULL;
-        }
-        if (posicoes_trie[i]) {
-            free(posicoes_trie[i]);
-            posicoes_trie[i] = NULL;
-        }
-    }
+    corpus_release(corpus_trie);
+    corpus_trie = NULL;
     if (trie_root) {
         trie_destroy(trie_root);
         trie_root = NULL;
     }
-    num_palavras_trie = 0;
     // Não limpa num_keywords_trie pois as palavras-chave são carregadas separadamente
 }
 
+void limpar_recursos_radix(void) {
+    corpus_release(corpus_radix);
+    corpus_radix = NULL;
+    if (radix_root) {
+        radix_destroy(radix_root);
+        radix_root = NULL;
+    }
+    // Não limpa num_keywords_radix pois as palavras-chave são carregadas separadamente
+}
+
+void limpar_recursos_aho(void) {
+    aho_destroy(aho_automaton);
+    aho_automaton = NULL;
+}
+
+void limpar_recursos_salvo(void) {
+    store_close(indice_salvo);
+    indice_salvo = NULL;
+}
+
 // Função para limpar todos os recursos
 void limpar_recursos(void) {
     limpar_recursos_hash();
     limpar_recursos_trie();
+    limpar_recursos_radix();
+    limpar_recursos_aho();
+    limpar_recursos_salvo();
     
     // Limpar os arrays de keywords também ao finalizar o programa
     num_keywords_hash = 0;
     num_keywords_trie = 0;
+    num_keywords_radix = 0;
 }
 
 // Funções de acesso às variáveis globais (setters e getters) - modificadas
-void set_texto_hash(char* texto) {
-    strncpy(texto_hash, texto, MAX_TEXT_SIZE - 1);
-    texto_hash[MAX_TEXT_SIZE - 1] = '\0';
-}
-
-void set_texto_trie(char* texto) {
-    strncpy(texto_trie, texto, MAX_TEXT_SIZE - 1);
-    texto_trie[MAX_TEXT_SIZE - 1] = '\0';
-}
-
-char* get_texto_hash(void) { return texto_hash; }
-char* get_texto_trie(void) { return texto_trie; }
 void set_trie_root(TrieNode* root) { trie_root = root; }
 TrieNode* get_trie_root(void) { return trie_root; }
+void set_radix_root(RadixNode* root) { radix_root = root; }
+RadixNode* get_radix_root(void) { return radix_root; }
+void set_aho_automaton(AhoAutomaton* ac) { aho_automaton = ac; }
+AhoAutomaton* get_aho_automaton(void) { return aho_automaton; }
 void set_hash_table(HashTable* ht) { hash_table = ht; }
 HashTable* get_hash_table(void) { return hash_table; }
-char** get_palavras_hash(void) { return palavras_hash; }
-char** get_palavras_trie(void) { return palavras_trie; }
-int** get_posicoes_hash(void) { return posicoes_hash; }
-int** get_posicoes_trie(void) { return posicoes_trie; }
-int get_num_palavras_hash(void) { return num_palavras_hash; }
-int get_num_palavras_trie(void) { return num_palavras_trie; }
-void set_num_palavras_hash(int num) { num_palavras_hash = num; }
-void set_num_palavras_trie(int num) { num_palavras_trie = num; }
+void set_indice_salvo(IndexStore* store) { indice_salvo = store; }
+IndexStore* get_indice_salvo(void) { return indice_salvo; }
+void set_corpus_hash(TokenCorpus* corpus) { corpus_hash = corpus; }
+void set_corpus_trie(TokenCorpus* corpus) { corpus_trie = corpus; }
+void set_corpus_radix(TokenCorpus* corpus) { corpus_radix = corpus; }
+TokenCorpus* get_corpus_hash(void) { return corpus_hash; }
+TokenCorpus* get_corpus_trie(void) { return corpus_trie; }
+TokenCorpus* get_corpus_radix(void) { return corpus_radix; }
 char (*get_keywords_hash(void))[MAX_WORD_SIZE] { return keywords_hash; }
 char (*get_keywords_trie(void))[MAX_WORD_SIZE] { return keywords_trie; }
+char (*get_keywords_radix(void))[MAX_WORD_SIZE] { return keywords_radix; }
 int get_num_keywords_hash(void) { return num_keywords_hash; }
 int get_num_keywords_trie(void) { return num_keywords_trie; }
+int get_num_keywords_radix(void) { return num_keywords_radix; }
 void set_num_keywords_hash(int num) { num_keywords_hash = num; }
-void set_num_keywords_trie(int num) { num_keywords_trie = num; }
\ No newline at end of file
+void set_num_keywords_trie(int num) { num_keywords_trie = num; }
+void set_num_keywords_radix(int num) { num_keywords_radix = num; }
+void set_compactar_ocorrencias(int ativo) { compactar_ocorrencias = ativo; }
+int get_compactar_ocorrencias(void) { return compactar_ocorrencias; }
\ No newline at end of file